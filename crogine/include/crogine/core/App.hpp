@@ -31,6 +31,7 @@ source distribution.
 
 #include <crogine/Config.hpp>
 #include <crogine/core/MessageBus.hpp>
+#include <crogine/core/JobSystem.hpp>
 #include <crogine/core/Window.hpp>
 #include <crogine/core/Clock.hpp>
 #include <crogine/core/Console.hpp>
@@ -103,6 +104,13 @@ namespace cro
         */
         MessageBus& getMessageBus() { return m_messageBus; }
 
+        /*!
+        \brief Returns a reference to the engine wide JobSystem.
+        The JobSystem is shut down when the App exits its main loop,
+        after which any jobs are executed immediately on the calling thread.
+        */
+        static JobSystem& getJobSystem();
+
         /*!
         \brief Returns the path to the current platform's directory
         for storing preference files (including the trailing '/').
@@ -219,6 +227,8 @@ namespace cro
         MessageBus m_messageBus;
         void handleMessages();
 
+        JobSystem m_jobSystem;
+
         static App* m_instance;
 
         struct ControllerInfo final
@@ -0,0 +1,192 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/Config.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cro
+{
+    /*!
+    \brief Engine wide pool of worker threads for executing short jobs.
+
+    The App owns a single instance, available with App::getJobSystem(), which
+    creates a worker for each hardware thread, less one for the main thread.
+    Each worker has its own queue of jobs from which idle workers steal when
+    their own queue is empty. Jobs scheduled from any other thread are placed
+    in a shared queue, from which all workers take jobs.
+
+    Jobs should be short lived - long running tasks such as a game server or
+    streaming audio should continue to use their own thread, else they will
+    prevent a worker from executing any other jobs.
+    */
+    class CRO_EXPORT_API JobSystem final
+    {
+    public:
+        using Job = std::function<void()>;
+
+        /*!
+        \brief Used to wait for a group of jobs to complete.
+        Pass the same Counter to schedule() for each job in the
+        group, then call wait() with it to block until they are
+        all complete. A Counter must outlive the jobs which use it.
+        */
+        class Counter final
+        {
+        public:
+            Counter() = default;
+            Counter(const Counter&) = delete;
+            Counter& operator = (const Counter&) = delete;
+
+            /*!
+            \brief Returns true if all jobs using this counter have completed
+            */
+            bool done() const { return m_pending == 0; }
+
+        private:
+            std::atomic<std::uint32_t> m_pending = 0;
+            friend class JobSystem;
+        };
+
+        /*!
+        \brief Constructor.
+        \param workerCount The number of worker threads to create. If this
+        is zero one worker is created for each hardware thread, less one
+        for the thread which constructs the JobSystem.
+        */
+        explicit JobSystem(std::size_t workerCount = 0);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem(JobSystem&&) = delete;
+        JobSystem& operator = (const JobSystem&) = delete;
+        JobSystem& operator = (JobSystem&&) = delete;
+
+        /*!
+        \brief Schedules a job for execution on a worker thread.
+        If there are no workers, or the JobSystem has been shut down,
+        the job is executed immediately on the calling thread.
+        \param job The job to execute
+        \param counter Optional Counter which can be passed to wait()
+        */
+        void schedule(Job job, Counter* counter = nullptr);
+
+        /*!
+        \brief Blocks until all jobs scheduled with the given Counter have
+        completed. While it waits the calling thread executes pending jobs
+        which were scheduled with the same Counter, but never any others,
+        so that it can't be held up by an unrelated long running job.
+        */
+        void wait(const Counter& counter);
+
+        /*!
+        \brief Splits the range [0, count) into batches, and calls the given
+        function for each batch in parallel. Returns once all batches are complete.
+        \param count The number of items to process
+        \param func Function called with the first index of a batch, and one
+        past the last index
+        \param minBatchSize The smallest number of items to place in each batch
+        */
+        void parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& func, std::size_t minBatchSize = 1);
+
+        /*!
+        \brief Queues a job to be executed on the main thread.
+        Use this for work which requires the OpenGL context, such as uploading
+        data generated by a worker. May be called from any thread - the jobs
+        are executed by the App once per frame.
+        */
+        void scheduleOnMainThread(Job job);
+
+        /*!
+        \brief Executes all jobs queued with scheduleOnMainThread().
+        This is called by the App each frame, and must only be
+        called from the main thread.
+        */
+        void processMainThreadJobs();
+
+        /*!
+        \brief Waits for all pending jobs to complete then stops the worker threads.
+        Any jobs scheduled afterwards are executed immediately on the calling thread.
+        This is called by the App once its main loop exits.
+        */
+        void shutdown();
+
+        /*!
+        \brief Returns the number of worker threads
+        */
+        std::size_t getWorkerCount() const { return m_threads.size(); }
+
+        /*!
+        \brief Returns true if the calling thread is one of this JobSystem's workers
+        */
+        bool isWorkerThread() const;
+
+    private:
+        struct Task final
+        {
+            Job job;
+            Counter* counter = nullptr;
+        };
+
+        struct Queue final
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        //one queue per worker plus a shared queue, at the
+        //back, for jobs scheduled by any other thread
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        std::vector<std::thread> m_threads;
+
+        std::mutex m_sleepMutex;
+        std::condition_variable m_sleepCondition;
+        std::atomic<std::size_t> m_queuedCount;
+        std::atomic_bool m_running;
+
+        std::mutex m_mainThreadMutex;
+        std::vector<Job> m_mainThreadJobs;
+        std::vector<Job> m_mainThreadBuffer;
+
+        void threadFunc(std::size_t);
+        std::size_t getQueueIndex() const;
+        bool tryExecute(std::size_t, const Counter* = nullptr);
+        void execute(Task&);
+    };
+}
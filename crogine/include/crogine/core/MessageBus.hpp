@@ -31,6 +31,11 @@ source distribution.
 
 #include <crogine/core/Message.hpp>
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace cro
@@ -50,12 +55,18 @@ namespace cro
     GhostEvent,
     BadgerEvent //etc...
     };
+
+    Messages are stored in pages of memory which are added as they are
+    needed, so there is no limit to the number of messages which can be
+    posted each frame. Messages may be posted from any thread, for example
+    from jobs run on the JobSystem, providing those jobs complete before
+    the messages are next dispatched at the beginning of the frame.
     */
     class CRO_EXPORT_API MessageBus final
     {
     public:
         MessageBus();
-        ~MessageBus() = default;
+        ~MessageBus();
         MessageBus(const MessageBus&) = delete;
         MessageBus(MessageBus&&) = delete;
         const MessageBus& operator = (const MessageBus&) = delete;
@@ -76,30 +87,16 @@ namespace cro
         ATTEMPING TO PLACE LARGE OBJECTS DIRECTLY ON THE MESSAGE BUS IS ASKING FOR TROUBLE
         Custom message types should have a unique 32 bit integer ID which can be used
         to identify the message type when reading messages. Message data has a maximum
-        size of 128 bytes.
+        size of 128 bytes. This is safe to call from multiple threads at once.
         \param id Unique ID for this message type
         \returns Pointer to an empty message of given type.
         */
         template <typename T>
         T* post(Message::ID id)
         {
-            if (!m_enabled) return static_cast<T*>((void*)m_pendingBuffer.data());
-
-            const auto dataSize = sizeof(T);
-            static const auto msgSize = sizeof(Message);
-            CRO_ASSERT(dataSize < 128, "message size exceeds 128 bytes"); //limit custom data to 128 bytes
-            CRO_ASSERT(m_pendingBuffer.size() - (m_inPointer - m_pendingBuffer.data()) > (dataSize + msgSize), "buffer overflow " + std::to_string(m_pendingCount)); //make sure we have enough room in the buffer
-            //CRO_WARNING(m_pendingBuffer.size() - (m_inPointer - m_pendingBuffer.data()) < 128, "Messagebus buffer is heavily contended!");
-
-            Message* msg = new (m_inPointer)Message();
-            m_inPointer += msgSize;
-            msg->id = id;
-            msg->m_dataSize = dataSize;
-            msg->m_data = new (m_inPointer)T();
-            m_inPointer += dataSize;
-
-            m_pendingCount++;
-            return static_cast<T*>(msg->m_data);
+            static_assert(alignof(T) <= Alignment, "message data is over-aligned");
+            CRO_ASSERT(sizeof(T) <= MaxDataSize, "message size exceeds 128 bytes"); //limit custom data to 128 bytes
+            return new (allocate(id, sizeof(T)))T();
         }
 
         /*!
@@ -119,15 +116,44 @@ namespace cro
         */
         void disable() { m_enabled = false; }
 
+        static constexpr std::size_t MaxDataSize = 128;
+
     private:
+        static constexpr std::size_t Alignment = alignof(std::max_align_t);
+        static constexpr std::size_t PageSize = 16384;
 
-        std::vector<char> m_currentBuffer;
-        std::vector<char> m_pendingBuffer;
-        char* m_inPointer;
-        char* m_outPointer;
+        //messages are placed in a page by atomically bumping its used
+        //count, so any number of threads can post without locking. New
+        //pages are only added, under m_pageMutex, when one is full.
+        struct Page final
+        {
+            alignas(Alignment) std::array<char, PageSize> data = {};
+            std::atomic<std::size_t> used = 0;
+            std::atomic<std::size_t> messageCount = 0;
+        };
+        using PagePtr = std::unique_ptr<Page>;
+
+        std::vector<PagePtr> m_pendingPages;
+        std::vector<PagePtr> m_currentPages;
+        std::vector<PagePtr> m_freePages;
+        std::atomic<Page*> m_activePage;
+        std::mutex m_pageMutex;
+
+        std::atomic<std::size_t> m_pendingCount;
         std::size_t m_currentCount;
-        std::size_t m_pendingCount;
 
-        bool m_enabled;
+        //read position in the current pages
+        std::size_t m_readPage;
+        std::size_t m_readOffset;
+        std::size_t m_readIndex;
+
+        //messages posted while disabled are written here and discarded
+        alignas(Alignment) std::array<char, MaxDataSize> m_disabledBuffer = {};
+        std::atomic_bool m_enabled;
+
+        //places a message header on the stack and returns a pointer to dataSize bytes for its data
+        void* allocate(Message::ID id, std::size_t dataSize);
+        PagePtr getFreePage();
+        friend class System;
     };
 }
\ No newline at end of file
@@ -79,6 +79,9 @@ namespace cro::Detail
         explicit BalancedTree(float unitsPerMetre);
 
         std::int32_t addToTree(Entity, Box bounds);
+
+        //adds an entity whose bounds are already in world space
+        std::int32_t addWorldBounds(Entity, Box worldBounds);
         void removeFromTree(std::int32_t);
 
         //moves a proxy with the specified treeID. If the entity
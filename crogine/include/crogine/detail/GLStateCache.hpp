@@ -0,0 +1,125 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/Config.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace cro::Detail
+{
+    /*!
+    \brief Shadows the subset of OpenGL state touched by the 3D renderers
+    so that redundant state changes can be skipped.
+    The cache makes no assumptions about the state of the context, so
+    invalidate() must be called before use any time other code may have
+    modified the state, for example at the beginning of a render() call.
+    Each skipped call increments the avoided count, which can be read
+    with getAvoidedCount()
+    */
+    class CRO_EXPORT_API GLStateCache final
+    {
+    public:
+        GLStateCache();
+
+        /*!
+        \brief Marks all cached state as unknown so that the next
+        call to each function is always forwarded to OpenGL
+        */
+        void invalidate();
+
+        /*!
+        \brief Binds the given shader program if it is not already bound
+        \returns true if the program was changed
+        */
+        bool useProgram(std::uint32_t program);
+
+        /*!
+        \brief Binds the given texture to the given texture unit
+        if it is not already bound there.
+        \param unit Index of the texture unit, eg 0 for GL_TEXTURE0
+        \param target GLenum target such as GL_TEXTURE_2D
+        \param texture Handle of the texture to bind
+        */
+        void bindTexture(std::uint32_t unit, std::uint32_t target, std::uint32_t texture);
+
+        /*!
+        \brief Enables or disables GL_BLEND, GL_DEPTH_TEST or GL_CULL_FACE.
+        Any other capability is passed directly to glEnable()/glDisable()
+        */
+        void setEnabled(std::uint32_t capability, bool enabled);
+
+        void setDepthMask(bool enabled);
+        void setBlendFunc(std::uint32_t src, std::uint32_t dst);
+        void setBlendEquation(std::uint32_t equation);
+        void setFrontFace(std::uint32_t mode);
+
+        /*!
+        \brief Returns the number of calls which were skipped
+        because the requested state was already set.
+        */
+        std::uint32_t getAvoidedCount() const { return m_avoidedCount; }
+
+        /*!
+        \brief Resets the avoided count to zero
+        */
+        void resetAvoidedCount() { m_avoidedCount = 0; }
+
+        static constexpr std::uint32_t MaxTextureUnits = 16;
+
+    private:
+        static constexpr std::uint32_t Unknown = 0xffffffff;
+
+        std::uint32_t m_program;
+        std::uint32_t m_activeUnit;
+
+        struct TextureBinding final
+        {
+            std::uint32_t target = Unknown;
+            std::uint32_t texture = Unknown;
+        };
+        std::array<TextureBinding, MaxTextureUnits> m_textures = {};
+
+        enum Capability
+        {
+            Blend, DepthTest, CullFace,
+            Count
+        };
+        std::array<std::uint32_t, Capability::Count> m_capabilities = {};
+
+        std::uint32_t m_depthMask;
+        std::array<std::uint32_t, 2u> m_blendFunc = {};
+        std::uint32_t m_blendEquation;
+        std::uint32_t m_frontFace;
+
+        std::uint32_t m_avoidedCount;
+    };
+}
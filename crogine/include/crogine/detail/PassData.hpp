@@ -0,0 +1,73 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/detail/glm/mat4x4.hpp>
+#include <crogine/detail/glm/vec2.hpp>
+#include <crogine/detail/glm/vec3.hpp>
+#include <crogine/detail/glm/vec4.hpp>
+
+#include <cstdint>
+
+namespace cro::Detail
+{
+    /*!
+    \brief Per-pass camera and lighting data shared by the built-in
+    material shaders via a std140 uniform block.
+    Renderers fill this once per camera pass and upload it to a
+    UniformBuffer bound at BindPoint, so that individual draws only
+    need to set their world transform and material properties.
+    The layout must match the PASS_UNIFORMS shader include, and
+    so the padding members must not be removed.
+    */
+    struct PassData final
+    {
+        glm::mat4 viewMatrix = glm::mat4(1.f);
+        glm::mat4 viewProjectionMatrix = glm::mat4(1.f);
+        glm::mat4 projectionMatrix = glm::mat4(1.f);
+        glm::vec4 clipPlane = glm::vec4(0.f);
+        glm::vec3 cameraWorldPosition = glm::vec3(0.f);
+        float padding0 = 0.f;
+        glm::vec3 lightDirection = glm::vec3(0.f, -1.f, 0.f);
+        float padding1 = 0.f;
+        glm::vec4 lightColour = glm::vec4(1.f);
+        glm::vec2 screenSize = glm::vec2(0.f);
+        glm::vec2 padding2 = glm::vec2(0.f);
+
+        //name of the uniform block as it appears in the shader
+        static constexpr const char* BlockName = "PassData";
+
+        //uniform buffer bind point reserved for the pass data.
+        //This is set on any shader containing the block when it
+        //is linked, so user UniformBuffers should avoid using it.
+        static constexpr std::uint32_t BindPoint = 15;
+    };
+    static_assert(sizeof(PassData) == 272, "PassData must match the std140 layout of the shader block");
+}
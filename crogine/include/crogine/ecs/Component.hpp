@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2020
+Matt Marchant 2017 - 2024
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -36,31 +36,88 @@ source distribution.
 #include <vector>
 #include <typeindex>
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <mutex>
 
 namespace cro
 {
+    namespace Detail
+    {
+        /*!
+        \brief Returns the next process-wide type index.
+        Used by TypeIndex<T> to assign each component type a unique
+        value the first time it is requested.
+        */
+        CRO_EXPORT_API std::uint32_t nextTypeIndex();
+
+        /*!
+        \brief Caches a unique index for type T, generated once on first use.
+        Note that if a type is used across a shared library boundary it may
+        be assigned a different index in each module - the ComponentManager
+        takes care of mapping these to the same component ID.
+        */
+        template <typename T>
+        struct TypeIndex final
+        {
+            static std::uint32_t get()
+            {
+                static const std::uint32_t idx = nextTypeIndex();
+                return idx;
+            }
+        };
+    }
+
     class CRO_EXPORT_API ComponentManager final
     {
     public:
 
         using ID = std::uint32_t;
+        static constexpr ID InvalidID = std::numeric_limits<ID>::max();
+
+        ComponentManager();
 
         /*!
-        \brief Returns a unique ID based on the component type
+        \brief Returns a unique ID based on the component type.
+        After the first call for any given type this is a constant
+        time look up which requires no RTTI. This is safe to call
+        from multiple threads at once.
         */
         template <typename T>
         ID getID()
         {
-            auto id = std::type_index(typeid(T));
-            return getFromTypeID(id);
+            const auto idx = Detail::TypeIndex<T>::get();
+            if (idx < m_lookup.size())
+            {
+                const auto id = m_lookup[idx].load(std::memory_order_acquire);
+                if (id != InvalidID)
+                {
+                    return id;
+                }
+            }
+            return cacheID(idx, std::type_index(typeid(T)));
         }
 
+        /*!
+        \brief Returns the ID for the given type, registering it if it
+        doesn't yet exist. This is thread safe, but slower than getID()
+        */
         ID getFromTypeID(std::type_index);
 
     private:
 
+        std::mutex m_mutex;
         std::vector<std::type_index> m_IDs;
+
+        //indexed by Detail::TypeIndex. This is a fixed size so that it's never
+        //reallocated while systems on other threads are reading it. Types with
+        //a larger index are still found, via getFromTypeID(), just not cached.
+        static constexpr std::size_t MaxCachedTypes = 1024;
+        std::array<std::atomic<ID>, MaxCachedTypes> m_lookup;
+
+        ID cacheID(std::uint32_t, std::type_index);
     };
 }
\ No newline at end of file
@@ -33,12 +33,30 @@ source distribution.
 #include <crogine/detail/Assert.hpp>
 #include <crogine/detail/NoResize.hpp>
 
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 #include <vector>
 
 namespace cro
 {
     namespace Detail
     {
+        /*!
+        \brief Determines whether or not a component type requires a stable
+        address in memory.
+        By default components are tightly packed in their pool, which means
+        they may be moved in memory when other components of the same type
+        are added or removed. Types which inherit NonResizeable, or which are
+        not copy assignable (such as Transform) are instead stored by entity
+        index and never move, so references to them remain valid for the
+        lifetime of the component. Specialise this for any other type which
+        requires the same guarantee.
+        */
+        template <class T>
+        struct UseStableAddress final
+            : std::bool_constant<!std::is_copy_assignable_v<T> || std::is_base_of_v<NonResizeable, T>> {};
+
         class Pool
         {
         public:
@@ -48,51 +66,189 @@ namespace cro
         };
 
         /*!
-        \brief memory pooling for components - TODO map component to ID
+        \brief Memory pooling for components.
+        Components are stored as a sparse set - a sparse array indexed by
+        entity index maps each entity to a slot in a densely packed array
+        of live components, which can be iterated contiguously with begin()
+        and end(). Removing a component moves the last component in the
+        pool into the vacated slot.
+
+        Types marked with UseStableAddress are instead stored directly by
+        entity index, with enough memory reserved up front that they are
+        never reallocated. These are still iterated in packed order via
+        getEntityIndex() and at(), although not contiguously in memory.
         */
         template <class T>
         class ComponentPool final : public Pool
         {
         public:
-            explicit ComponentPool(std::size_t size = 128) : m_pool(size)
+            static constexpr bool StableAddress = UseStableAddress<T>::value;
+
+            explicit ComponentPool(std::size_t size = 128)
             {
-                if constexpr (!std::is_copy_assignable_v<T>
-                    || std::is_base_of_v<NonResizeable, T>)
+                if constexpr (StableAddress)
                 {
-                    m_pool.reserve(MinFreeIDs);
+                    m_components.reserve(MinFreeIDs);
                     LOG("Reserved maximum pool size of " + std::to_string(MinFreeIDs) + " for " + std::string(typeid(T).name()), cro::Logger::Type::Info);
                 }
+                else
+                {
+                    m_components.reserve(size);
+                }
+                m_entities.reserve(size);
             }
 
-            bool empty() const { return m_pool.empty(); }
-            std::size_t size() const { return m_pool.size(); }
-            void resize(std::size_t size)
-            { 
-                if (size > m_pool.size())
+            /*!
+            \brief Returns true if there are no live components in the pool
+            */
+            bool empty() const { return m_entities.empty(); }
+
+            /*!
+            \brief Returns the number of live components in the pool
+            */
+            std::size_t size() const { return m_entities.size(); }
+
+            /*!
+            \brief Returns true if the entity at the given index has a
+            component in this pool
+            */
+            bool contains(std::size_t entityIndex) const
+            {
+                return entityIndex < m_sparse.size() && m_sparse[entityIndex] != NullIndex;
+            }
+
+            /*!
+            \brief Inserts the given component for the entity at the given
+            index, replacing any existing component.
+            \returns Reference to the inserted component
+            */
+            T& insert(std::size_t entityIndex, T&& component)
+            {
+                if (contains(entityIndex))
                 {
-                    m_pool.resize(size);
+                    auto& c = (*this)[entityIndex];
+                    c = std::move(component);
+                    return c;
+                }
 
-                    //just surpress this if we're of a type which reserves
-                    //max size, else the message is confusing
-                    if constexpr (std::is_copy_assignable_v<T>
-                        || !std::is_base_of_v<NonResizeable, T>)
+                if (entityIndex >= m_sparse.size())
+                {
+                    m_sparse.resize(std::min(static_cast<std::size_t>(MinFreeIDs), entityIndex + 128), NullIndex);
+                }
+                m_sparse[entityIndex] = static_cast<std::uint32_t>(m_entities.size());
+                m_entities.push_back(static_cast<std::uint32_t>(entityIndex));
+
+                if constexpr (StableAddress)
+                {
+                    if (entityIndex >= m_components.size())
                     {
-                        LOG("Warning component pool " + std::string(typeid(T).name()) + " has been resized to " + std::to_string(m_pool.size()) + " - existing component references may be invalidated", cro::Logger::Type::Warning);
+                        m_components.resize(std::min(static_cast<std::size_t>(MinFreeIDs), entityIndex + 128));
                     }
+                    m_components[entityIndex] = std::move(component);
+                    return m_components[entityIndex];
+                }
+                else
+                {
+                    if (m_components.size() == m_components.capacity())
+                    {
+                        LOG("Warning component pool " + std::string(typeid(T).name()) + " has grown beyond " + std::to_string(m_components.capacity()) + " - existing component references may be invalidated", cro::Logger::Type::Warning);
+                    }
+                    return m_components.emplace_back(std::move(component));
                 }
             }
-            void clear() override { m_pool.clear(); }
 
-            T& at(std::size_t idx) { return m_pool.at(idx); }
-            const T& at(std::size_t idx) const { return m_pool.at(idx); }
+            void clear() override
+            {
+                m_components.clear();
+                m_entities.clear();
+                m_sparse.clear();
+            }
+
+            /*!
+            \brief Returns the component belonging to the entity at the given index
+            */
+            T& operator [] (std::size_t entityIndex) { CRO_ASSERT(contains(entityIndex), "Index out of range"); return m_components[slot(entityIndex)]; }
+            const T& operator [] (std::size_t entityIndex) const { CRO_ASSERT(contains(entityIndex), "Index out of range"); return m_components[slot(entityIndex)]; }
+
+            /*!
+            \brief Returns the component at the given packed index, from 0 to size()
+            */
+            T& at(std::size_t packedIndex) { CRO_ASSERT(packedIndex < m_entities.size(), "Index out of range"); return (*this)[m_entities[packedIndex]]; }
+            const T& at(std::size_t packedIndex) const { CRO_ASSERT(packedIndex < m_entities.size(), "Index out of range"); return (*this)[m_entities[packedIndex]]; }
+
+            /*!
+            \brief Returns the index of the entity owning the component
+            at the given packed index
+            */
+            std::uint32_t getEntityIndex(std::size_t packedIndex) const { CRO_ASSERT(packedIndex < m_entities.size(), "Index out of range"); return m_entities[packedIndex]; }
+
+            /*!
+            \brief Contiguous iteration over all live components.
+            Only available on pools which don't use stable addresses.
+            The entity index of each component is found with getEntityIndex()
+            using the same offset from begin()
+            */
+            template <bool B = StableAddress, std::enable_if_t<!B, int> = 0>
+            typename std::vector<T>::iterator begin() { return m_components.begin(); }
+            template <bool B = StableAddress, std::enable_if_t<!B, int> = 0>
+            typename std::vector<T>::iterator end() { return m_components.end(); }
+            template <bool B = StableAddress, std::enable_if_t<!B, int> = 0>
+            typename std::vector<T>::const_iterator begin() const { return m_components.cbegin(); }
+            template <bool B = StableAddress, std::enable_if_t<!B, int> = 0>
+            typename std::vector<T>::const_iterator end() const { return m_components.cend(); }
+
+            /*!
+            \brief Removes the component belonging to the entity at the given index, if it exists
+            */
+            void reset(std::size_t entityIndex) override
+            {
+                if (!contains(entityIndex))
+                {
+                    return;
+                }
 
-            T& operator [] (std::size_t index) { CRO_ASSERT(index < m_pool.size(), "Index out of range"); return m_pool[index]; }
-            const T& operator [] (std::size_t index) const { CRO_ASSERT(index < m_pool.size(), "Index out of range"); return m_pool[index]; }
+                //swap the last entry into the vacated slot
+                const auto packedIndex = m_sparse[entityIndex];
+                const auto lastEntity = m_entities.back();
+                m_entities[packedIndex] = lastEntity;
+                m_sparse[lastEntity] = packedIndex;
+                m_entities.pop_back();
+                m_sparse[entityIndex] = NullIndex;
 
-            void reset(std::size_t idx) override { if(idx < m_pool.size()) m_pool[idx] = T(); }
+                if constexpr (StableAddress)
+                {
+                    //forcefully reset components which might
+                    //otherwise orphan moveable only types
+                    m_components[entityIndex] = T();
+                }
+                else
+                {
+                    if (packedIndex != m_components.size() - 1)
+                    {
+                        m_components[packedIndex] = std::move(m_components.back());
+                    }
+                    m_components.pop_back();
+                }
+            }
 
         private:
-            std::vector<T> m_pool;
+            static constexpr std::uint32_t NullIndex = std::numeric_limits<std::uint32_t>::max();
+
+            std::vector<T> m_components; //< packed unless StableAddress, in which case indexed by entity
+            std::vector<std::uint32_t> m_entities; //< entity index of each packed component
+            std::vector<std::uint32_t> m_sparse; //< maps entity index to packed index
+
+            std::size_t slot(std::size_t entityIndex) const
+            {
+                if constexpr (StableAddress)
+                {
+                    return entityIndex;
+                }
+                else
+                {
+                    return m_sparse[entityIndex];
+                }
+            }
         };
     }
 }
\ No newline at end of file
@@ -97,6 +97,17 @@ namespace cro
         template <typename T, typename... Args>
         T& addComponent(Args&&...);
 
+        /*!
+        \brief Removes the component of the given type from the entity, if it exists.
+        hasComponent() returns false immediately, although the component itself
+        remains valid until the next Scene::simulate(), at which point the entity
+        is removed from any systems which require the component. Adding or
+        removing components is therefore cheaper than recreating an entity
+        with a different set of components.
+        */
+        template <typename T>
+        void removeComponent();
+
         /*!
         \brief returns true if the component type exists on the entity
         */
@@ -229,6 +240,13 @@ namespace cro
         template <typename T, typename... Args>
         T& addComponent(Entity, Args&&... args);
 
+        /*!
+        \brief Removes the component of this type from the given Entity.
+        The component is destroyed by the next call to flushRemovedComponents()
+        */
+        template <typename T>
+        void removeComponent(Entity);
+
         /*!
         \brief Returns true if the given Entity has a component of this type
         */
@@ -275,23 +293,60 @@ namespace cro
         */
         void markDestroyed(Entity entity);
 
+        /*!
+        \brief Returns the pool containing all components of the given type,
+        creating it if it doesn't yet exist.
+        \see Detail::ComponentPool
+        */
+        template <typename T>
+        Detail::ComponentPool<T>& getPool();
+
+        /*!
+        \brief Returns a list of entities which have been created, or had
+        components added or removed, since the last call to this function.
+        Used by the Scene to route entities to the systems which match their
+        current component masks.
+        */
+        const std::vector<Entity>& fetchModifiedEntities();
+
+        /*!
+        \brief Destroys any components removed before the last call to
+        fetchModifiedEntities(). This should be called once the modified
+        entities have been removed from any systems, so the components are
+        still available to System::onEntityRemoved()
+        */
+        void flushRemovedComponents();
 
     private:
         MessageBus& m_messageBus;
         std::size_t m_initialPoolSize;
         std::deque<Entity::ID> m_freeIDs;
         std::vector<Entity::Generation> m_generations; // < indexed by entity ID
-        std::vector<std::unique_ptr<Detail::Pool>> m_componentPools; // < index is component ID. Pool index is entity ID.
+        std::vector<std::unique_ptr<Detail::Pool>> m_componentPools; // < index is component ID.
         std::vector<ComponentMask> m_componentMasks;
 
         std::size_t m_entityCount;
         std::vector<std::string> m_labels;
         std::vector<bool> m_destructionFlags;
 
+        //double buffered as they may be modified while systems are updated
+        std::vector<Entity> m_modifiedEntities;
+        std::vector<Entity> m_modifiedBuffer;
+        std::vector<bool> m_modifiedFlags;
+
+        struct RemovedComponent final
+        {
+            Entity entity;
+            std::size_t componentID = 0;
+            RemovedComponent(Entity e, std::size_t id)
+                : entity(e), componentID(id) {}
+        };
+        std::vector<RemovedComponent> m_removedComponents;
+        std::vector<RemovedComponent> m_removedBuffer;
+
         ComponentManager& m_componentManager;
 
-        template <typename T>
-        Detail::ComponentPool<T>& getPool();
+        void markModified(Entity);
     };
 
 #include "Entity.inl"
@@ -43,6 +43,13 @@ T& Entity::addComponent(Args&&... args)
     return m_entityManager->addComponent<T>(*this, std::forward<Args>(args)...);
 }
 
+template <typename T>
+void Entity::removeComponent()
+{
+    CRO_ASSERT(isValid(), "Not a valid Entity");
+    m_entityManager->removeComponent<T>(*this);
+}
+
 template <typename T>
 bool Entity::hasComponent() const
 {
@@ -50,11 +57,12 @@ bool Entity::hasComponent() const
     return m_entityManager->hasComponent<T>(*this);
 }
 
+//components which have been removed remain valid until the entity
+//is removed from its systems, so these are checked by the EntityManager
 template <typename T>
 T& Entity::getComponent()
 {
     CRO_ASSERT(isValid(), "Not a valid Entity");
-    CRO_ASSERT(hasComponent<T>(), std::string(typeid(T).name()) + ": Component does not exist!");
     return m_entityManager->getComponent<T>(*this);
 }
 
@@ -62,6 +70,5 @@ template <typename T>
 const T& Entity::getComponent() const
 {
     CRO_ASSERT(isValid(), "Not a valid Entity");
-    CRO_ASSERT(hasComponent<T>(), std::string(typeid(T).name()) + ": Component does not exist!");
     return m_entityManager->getComponent<T>(*this);
 }
\ No newline at end of file
@@ -33,35 +33,39 @@ void EntityManager::addComponent(Entity entity, T component)
     auto componentID = m_componentManager.getID<T>();
     auto entID = entity.getIndex();
 
-    auto& pool = getPool<T>();
-    if (entID >= pool.size())
-    {
-        pool.resize(std::min(static_cast<std::uint32_t>(Detail::MinFreeIDs), entID + 128));
-    }
-
-    pool[entID] = std::move(component);
+    getPool<T>().insert(entID, std::move(component));
     m_componentMasks[entID].set(componentID);
+    markModified(entity);
 }
 
 template <typename T, typename... Args>
 T& EntityManager::addComponent(Entity entity, Args&&... args)
 {
-    T component(std::forward<Args>(args)...);
-    addComponent<T>(entity, std::move(component));
-    return getComponent<T>(entity);
+    auto componentID = m_componentManager.getID<T>();
+    auto entID = entity.getIndex();
+
+    auto& component = getPool<T>().insert(entID, T(std::forward<Args>(args)...));
+    m_componentMasks[entID].set(componentID);
+    markModified(entity);
+    return component;
 }
 
-//TODO this doesn't remove the entity from active systems...
-//template <typename T>
-//void EntityManager::removeComponent(Entity entity)
-//{
-//    const auto componentID = Component::getID<T>();
-//    const auto entityID = entity.getIndex();
-//
-//    CRO_ASSERT(entityID < m_componentMasks.size(), "Entity index out of range");
-//    m_componentMasks[entityID].set(componentID, false);
-//    
-//}
+template <typename T>
+void EntityManager::removeComponent(Entity entity)
+{
+    const auto componentID = m_componentManager.getID<T>();
+    const auto entityID = entity.getIndex();
+
+    CRO_ASSERT(entityID < m_componentMasks.size(), "Entity index out of range");
+    if (m_componentMasks[entityID].test(componentID))
+    {
+        //the component is left in the pool until the entity
+        //has been removed from any systems which use it
+        m_componentMasks[entityID].reset(componentID);
+        m_removedComponents.emplace_back(entity, componentID);
+        markModified(entity);
+    }
+}
 
 template <typename T>
 bool EntityManager::hasComponent(Entity entity) const
@@ -79,14 +83,14 @@ T& EntityManager::getComponent(Entity entity)
     const auto componentID = m_componentManager.getID<T>();
     const auto entityID = entity.getIndex();
 
-    CRO_ASSERT(hasComponent<T>(entity), "Component does not exist!");
-
-
     CRO_ASSERT(componentID < m_componentPools.size(), "Component index out of range");
-    auto* pool = (dynamic_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get()));
+    //the component ID is unique to T so we know the pool type already
+    auto* pool = static_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get());
 
-    CRO_ASSERT(entityID < pool->size(), "Entity index out of range");
-    return pool->at(entityID);
+    //removed components are still valid until they're flushed, so
+    //check the pool rather than the component mask
+    CRO_ASSERT(pool && pool->contains(entityID), std::string(typeid(T).name()) + ": Component does not exist!");
+    return (*pool)[entityID];
 }
 
 template <typename T>
@@ -99,5 +103,5 @@ Detail::ComponentPool<T>& EntityManager::getPool()
         m_componentPools[componentID] = std::make_unique<Detail::ComponentPool<T>>(m_initialPoolSize);
     }
 
-    return *(dynamic_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get()));
+    return *(static_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get()));
 }
\ No newline at end of file
@@ -34,6 +34,7 @@ source distribution.
 #include <crogine/graphics/Rectangle.hpp>
 
 #include <array>
+#include <vector>
 
 namespace cro
 {
@@ -68,6 +69,26 @@ namespace cro
         */
         virtual void updateDrawList(Entity camera) = 0;
 
+        /*!
+        \brief Updates the draw lists of several cameras at once.
+        By default this calls updateDrawList() for each camera in turn.
+        Renderables may override this to update the cameras in parallel,
+        for example by scheduling a job for each camera with the App's
+        JobSystem.
+
+        This is called by the CameraSystem with all of the active cameras
+        in the Scene. World transforms are up to date before it is called,
+        so they are safe to read from any thread.
+        */
+        virtual void updateDrawLists(const std::vector<Entity>& cameras);
+
+        /*!
+        \brief Returns true if this Renderable's draw lists may be updated
+        on a worker thread, at the same time as those of other Renderables.
+        \see setConcurrentDrawLists()
+        */
+        bool hasConcurrentDrawLists() const { return m_concurrentDrawLists; }
+
         /*!
         \brief Renders this system.
         \param camera Entity containing a camera and transform component, automatically
@@ -92,8 +113,18 @@ namespace cro
         */
         void restorePreviousViewport();
 
+        /*!
+        \brief Marks updateDrawLists() as safe to call from a worker thread.
+        Concurrent Renderables must not use OpenGL, or modify any data shared
+        with other systems, while updating their draw lists. Other Renderables
+        are updated on the main thread while the concurrent ones are updated.
+        This is false by default.
+        */
+        void setConcurrentDrawLists(bool concurrent) { m_concurrentDrawLists = concurrent; }
+
     private:
         std::array<std::int32_t, 4> m_previousViewport{};
+        bool m_concurrentDrawLists = false;
 
     };
 }
\ No newline at end of file
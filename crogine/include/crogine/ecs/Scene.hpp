@@ -55,6 +55,12 @@ namespace cro
     class Renderable;
     class EnvironmentMap;
 
+    namespace Detail
+    {
+        class TransformPass;
+        class VisibilityPass;
+    }
+
     /*!
     \brief Encapsulates a single scene.
     The scene class contains everything needed to create a scene graph by encapsulating
@@ -123,6 +129,16 @@ namespace cro
         std::size_t getEntityCount() const { return m_entityManager.getEntityCount(); }
 
 
+        /*!
+        \brief Returns the pool of all components of the given type in the Scene.
+        Unless the component type requires a stable address (see Detail::UseStableAddress)
+        the components are tightly packed and can be iterated contiguously, which
+        is cheaper than fetching each component through an Entity handle when only
+        a single component type is needed.
+        */
+        template <typename T>
+        Detail::ComponentPool<T>& getComponentPool() { return m_entityManager.getPool<T>(); }
+
         /*!
         \brief Creates a new system of the given type.
         All systems need to be fully created before adding entities, else
@@ -404,13 +420,26 @@ namespace cro
         /*!
         \brief Passes the given camera to each Renderable system so that they
         may update the Camera's drawList property.
-        This is called automatically by the CameraSystem to update all active
-        Camera components in the Scene
-        \see Renderable::updateDrawLists()
+        Use this to update the draw lists of a camera which is not updated
+        by the CameraSystem, for example one used to render to a texture.
+        \see Renderable::updateDrawList()
         \see Camera::drawList
         */
         void updateDrawLists(Entity);
 
+        /*!
+        \brief Passes the given cameras to each Renderable system so that
+        they may update the cameras' draw lists.
+        Renderables which support it are updated in parallel by the App's
+        JobSystem, while the remaining Renderables are updated on the calling
+        thread. Returns once all the draw lists are complete.
+        This is called automatically by the CameraSystem with all the active
+        Camera components in the Scene.
+        \see Renderable::updateDrawLists()
+        \see Renderable::hasConcurrentDrawLists()
+        */
+        void updateDrawLists(const std::vector<Entity>& cameras);
+
 
         /*!
         \brief Posts a message on the system wide message bus
@@ -446,7 +475,6 @@ namespace cro
         Entity m_activeListener;
         Entity m_sunlight;
 
-        std::vector<Entity> m_pendingEntities;
         std::vector<Entity> m_destroyedEntities;
         std::vector<Entity> m_destroyedBuffer;
 
@@ -454,6 +482,17 @@ namespace cro
         EntityManager m_entityManager;
         SystemManager m_systemManager;
 
+        std::unique_ptr<Detail::TransformPass> m_transformPass;
+        void updateTransforms(); //< used by the SystemManager and System::parallelFor() before processing concurrently
+        friend class SystemManager;
+        friend class System;
+
+        //shared with the 3D renderers so models are only transformed and culled once per frame
+        std::unique_ptr<Detail::VisibilityPass> m_visibilityPass;
+        friend class ModelRenderer;
+        friend class ShadowMapRenderer;
+        friend class DeferredRenderSystem;
+
         std::vector<std::unique_ptr<Director>> m_directors;
 
         std::vector<Renderable*> m_renderables;
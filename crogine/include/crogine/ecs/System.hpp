@@ -37,12 +37,18 @@ source distribution.
 #include <crogine/gui/GuiClient.hpp>
 
 #include <vector>
+#include <array>
+#include <deque>
+#include <functional>
 #include <typeindex>
+#include <limits>
+#include <unordered_map>
 
 namespace cro
 {
     class Time;
     class Scene;
+    class JobSystem;
 
     using UniqueType = std::type_index;
 
@@ -84,10 +90,21 @@ namespace cro
         void addEntity(Entity);
 
         /*!
-        \brief Removes an entity from the list to process
+        \brief Removes an entity from the list to process.
+        Entities are removed in constant time by swapping them with the
+        last entity in the list, so the order of the list is not preserved.
         */
         void removeEntity(Entity);
 
+        /*!
+        \brief Returns true if the given entity is currently in
+        this system's list of entities. This is still correct if the
+        list returned by getEntities() has been reordered or modified,
+        in which case the internal look up table is rebuilt.
+        \see updateEntitySlots()
+        */
+        bool hasEntity(Entity) const;
+
         /*!
         \brief Returns the component mask used to mask entities with corresponding
         components for this system to process
@@ -96,9 +113,15 @@ namespace cro
 
         /*!
         \brief Used to process any incoming system messages
+        \see subscribe()
         */
         virtual void handleMessage(const cro::Message&);
 
+        /*!
+        \brief Returns true if this system wants to receive messages with the given ID
+        */
+        bool isSubscribed(Message::ID) const;
+
         /*!
         \brief Implement this for system specific processing to entities.
         */
@@ -110,6 +133,13 @@ namespace cro
         */
         bool isActive() const { return m_active; }
 
+        /*!
+        \brief Returns true if this system has declared the components it
+        accesses with readComponent() or writeComponent(), and may therefore
+        be processed concurrently with other systems.
+        */
+        bool isConcurrent() const { return m_concurrent; }
+
     protected:
 
         /*!
@@ -119,6 +149,42 @@ namespace cro
         template <typename T>
         void requireComponent();
 
+        /*!
+        \brief Declares that this system reads components of this type in process().
+        Systems which declare the components they access can be processed at the
+        same time as other systems, providing neither writes to a component type
+        accessed by the other. Any components added with requireComponent() are
+        assumed to be read, unless they are also declared with writeComponent().
+
+        Systems which declare no access are processed alone on the main thread, in
+        the order in which they were added to the Scene, as they always have been.
+
+        Systems which declare access should only touch the declared components in
+        process(). They must not create or destroy entities, add or remove components,
+        or post messages other than with postMessage() during process(). Systems
+        which make OpenGL calls in process() should not declare access, as they may
+        be processed on a thread other than the main thread.
+        */
+        template <typename T>
+        void readComponent();
+
+        /*!
+        \brief Declares that this system modifies components of this type in process().
+        \see readComponent()
+        */
+        template <typename T>
+        void writeComponent();
+
+        /*!
+        \brief Subscribes this system to messages with the given ID.
+        By default every message is passed to handleMessage(). Once a system
+        has subscribed to at least one message ID it only receives messages
+        with the IDs to which it has subscribed, which saves forwarding every
+        message to systems which are only interested in a few. Subscriptions
+        should be made in the constructor, as with requireComponent().
+        */
+        void subscribe(Message::ID);
+
         /*!
         \brief Optional callback performed when an entity is added
         */
@@ -130,11 +196,62 @@ namespace cro
         virtual void onEntityRemoved(Entity) {}
 
         /*!
-        \brief Posts a message on the system wide message bus
+        \brief Posts a message on the system wide message bus.
+        This is safe to use from systems which are processed concurrently,
+        and from within parallelFor() or parallelForEach().
         */
         template <typename T>
         T* postMessage(Message::ID id) const;
 
+        /*!
+        \brief Calls the given function once for each of this system's entities,
+        splitting the entities into batches which are processed in parallel by
+        the App's JobSystem.
+        \param func A function or lambda with the signature void(Entity). This
+        is called from multiple threads at once, so should only modify the
+        components of the entity it is passed.
+        \param minBatchSize The smallest number of entities to process in each batch.
+        Systems with fewer entities than this are processed on the calling thread.
+        \see parallelFor()
+        */
+        template <typename Func>
+        void parallelForEach(Func&& func, std::size_t minBatchSize = DefaultBatchSize);
+
+        /*!
+        \brief Splits the range [0, count) into batches, which are processed
+        in parallel by the App's JobSystem. Returns once all batches are complete.
+
+        World transforms are brought up to date before any batches are processed,
+        so that they may be safely read from any thread. Messages posted with
+        postMessage() while processing a batch are forwarded to the message bus
+        once all batches are complete, in the same order as they would have been
+        were the range processed in a single loop.
+        \param count Number of items in the range
+        \param func Called with the index of the batch, the first index in the
+        batch, and one past the last index in the batch.
+        \param minBatchSize The smallest number of items to place in each batch
+        \see getBatchCount()
+        */
+        void parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t, std::size_t)>& func, std::size_t minBatchSize = DefaultBatchSize);
+
+        /*!
+        \brief Returns the number of batches parallelFor() will split a range
+        of the given size into. Use this to size any per-batch output, which
+        can then be merged in batch order to match the output of a single loop.
+        */
+        std::size_t getBatchCount(std::size_t count, std::size_t minBatchSize = DefaultBatchSize) const;
+
+        /*!
+        \brief Rebuilds the look up table used by hasEntity() if the list
+        returned by getEntities() has been modified. hasEntity() otherwise
+        rebuilds it lazily, so this must be called before hasEntity() is used
+        from more than one thread at a time. parallelFor() and parallelForEach()
+        do this automatically.
+        */
+        void updateEntitySlots() const;
+
+        static constexpr std::size_t DefaultBatchSize = 64;
+
         /*!
         \brief Returns a reference to the MessageBus
         */
@@ -158,11 +275,41 @@ namespace cro
         ComponentMask m_componentMask;
         std::vector<Entity> m_entities;
 
+        //maps entity indices to their position in m_entities. Mutable
+        //so that hasEntity() can rebuild it if it's out of date. This is
+        //NOT thread safe, see updateEntitySlots()
+        static constexpr std::uint32_t NullSlot = std::numeric_limits<std::uint32_t>::max();
+        mutable std::vector<std::uint32_t> m_entitySlots;
+        std::uint32_t getSlot(Entity) const;
+        void rebuildSlots() const;
+
         Scene* m_scene;
         std::size_t m_updateIndex; //ensures when the system is active that it is updated in the order in which is was added to the manager
 
         bool m_active; //used by system manager to check if it has been added to the active list
 
+        bool m_concurrent;
+        ComponentMask m_readMask;
+        ComponentMask m_writeMask;
+        std::vector<std::type_index> m_pendingReadTypes;
+        std::vector<std::type_index> m_pendingWriteTypes;
+
+        //messages posted from parallelFor() are stored per batch
+        //then forwarded to the message bus in batch order
+        struct BufferedMessage final
+        {
+            Message::ID id = 0;
+            std::size_t size = 0;
+            alignas(std::max_align_t) std::array<char, MessageBus::MaxDataSize> data = {};
+        };
+        using MessageBuffer = std::deque<BufferedMessage>;
+        std::vector<MessageBuffer> m_batchMessages;
+        static MessageBuffer*& getBatchMessageBuffer();
+
+        bool m_inConcurrentStage; //transforms are already updated by the SystemManager
+
+        std::vector<Message::ID> m_subscriptions;
+
         friend class SystemManager;
 
         //list of types populated by requireComponent then processed by SystemManager
@@ -227,13 +374,30 @@ namespace cro
         */
         void addToSystems(Entity);
 
+        /*!
+        \brief Submits a batch of entities to all available systems
+        */
+        void addToSystems(const std::vector<Entity>&);
+
         /*!
         \brief Removes the given Entity from any systems to which it may belong
         */
         void removeFromSystems(Entity);
 
         /*!
-        \brief Forwards messages to all systems
+        \brief Removes a batch of entities from any systems to which they may belong
+        */
+        void removeFromSystems(const std::vector<Entity>&);
+
+        /*!
+        \brief Adds the given entities to any systems which match their component
+        masks, and removes them from any systems they belong to which no longer
+        match. Used when components are added to or removed from existing entities.
+        */
+        void updateSystems(const std::vector<Entity>&);
+
+        /*!
+        \brief Forwards messages to all systems which are subscribed to them
         */
         void forwardMessage(const cro::Message&);
 
@@ -260,6 +424,20 @@ namespace cro
         };
         std::vector<SystemSample> m_systemSamples;
 
+        //active systems grouped into stages, where the systems in
+        //each stage have no conflicting access and can run concurrently
+        std::vector<std::vector<System*>> m_schedule;
+        bool m_scheduleDirty;
+        JobSystem* m_jobSystem;
+        std::vector<float> m_taskTimes;
+
+        //systems which want each message ID, in the order they were added
+        std::unordered_map<Message::ID, std::vector<System*>> m_messageRecipients;
+        bool m_recipientsDirty;
+
+        void buildSchedule();
+        void processStage(const std::vector<System*>&, float, bool);
+
         template <typename T>
         void removeFromActive();
     };
@@ -33,8 +33,53 @@ void System::requireComponent()
 	m_pendingTypes.push_back(typeid(T));
 }
 
+template <typename T>
+void System::readComponent()
+{
+	m_pendingReadTypes.push_back(typeid(T));
+	m_concurrent = true;
+}
+
+template <typename T>
+void System::writeComponent()
+{
+	m_pendingWriteTypes.push_back(typeid(T));
+	m_concurrent = true;
+}
+
 template <typename T>
 T* System::postMessage(cro::Message::ID id) const
 {
+	//posted from a batch in parallelFor()
+	if constexpr (sizeof(T) <= MessageBus::MaxDataSize)
+	{
+		if (auto* messages = getBatchMessageBuffer(); messages != nullptr)
+		{
+			auto& msg = messages->emplace_back();
+			msg.id = id;
+			msg.size = sizeof(T);
+			return new (msg.data.data())T();
+		}
+	}
+	else
+	{
+		//this would be posted immediately, out of order with the
+		//messages posted by other batches, so make it visible
+		CRO_ASSERT(getBatchMessageBuffer() == nullptr, "Message is larger than MessageBus::MaxDataSize so can't be posted from parallelFor()");
+	}
+
 	return m_messageBus.post<T>(id);
+}
+
+template <typename Func>
+void System::parallelForEach(Func&& func, std::size_t minBatchSize)
+{
+	parallelFor(m_entities.size(), 
+		[&](std::size_t, std::size_t begin, std::size_t end)
+		{
+			for (auto i = begin; i < end; ++i)
+			{
+				func(m_entities[i]);
+			}
+		}, minBatchSize);
 }
\ No newline at end of file
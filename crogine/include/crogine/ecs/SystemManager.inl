@@ -51,6 +51,8 @@ T& SystemManager::addSystem(Args&&... args)
     system->m_updateIndex = m_activeSystems.size();
     m_activeSystems.push_back(system.get());
     system->m_active = true;
+    m_scheduleDirty = true;
+    m_recipientsDirty = true;
 
     return *(static_cast<T*>(system.get()));
 }
@@ -64,6 +66,7 @@ void SystemManager::removeSystem()
     {
         return sys->getType() == type;
     }), std::end(m_systems));
+    m_recipientsDirty = true;
 
     removeFromActive<T>();
 }
@@ -93,6 +96,7 @@ void SystemManager::setSystemActive(bool active)
             {
                 m_activeSystems.push_back((*result).get());
                 (*result)->m_active = true;
+                m_scheduleDirty = true;
 
                 //return to correct order
                 std::sort(m_activeSystems.begin(), m_activeSystems.end(),
@@ -162,4 +166,6 @@ void SystemManager::removeFromActive()
         {
             return sys->getType() == type;
         }), std::end(m_activeSystems));
+
+    m_scheduleDirty = true;
 }
\ No newline at end of file
@@ -318,6 +318,7 @@ namespace cro
 
         std::uint32_t m_vbo;
         std::uint32_t m_vao; //!< only used in desktop builds
+        std::size_t m_vboSize; //!< allocated size in bytes
         bool m_updateBufferData;
 
         struct AttribData final
@@ -411,7 +412,11 @@ namespace cro
             }
         }
 
+        //removes any value bound to the named uniform of the current shader
+        void unbindUniform(const std::string& name);
+
         friend class RenderSystem2D;
+        friend class TextSystem;
 
         void applyShader();
     };
@@ -41,6 +41,11 @@ source distribution.
 
 namespace cro
 {
+    namespace Detail
+    {
+        class VisibilityPass;
+    }
+
     class CRO_EXPORT_API Model final
     {
     public:
@@ -269,11 +274,11 @@ namespace cro
         using VAOPair = std::array<std::uint32_t, Mesh::IndexData::Pass::Count>;
         std::array<VAOPair, Mesh::IndexData::MaxBuffers> m_vaos = {};
 
-        std::vector<std::pair<std::size_t, Material::Property*>> m_animations;
+        std::vector<std::size_t> m_animations; //indices of animated materials
         void initMaterialAnimation(std::size_t);
         void updateMaterialAnimations(float);
 
-        void bindMaterial(Material::Data&);
+        void bindMaterial(Material::Data&) const;
         void updateBounds();
         
 #ifdef PLATFORM_DESKTOP
@@ -307,11 +312,14 @@ namespace cro
         std::size_t m_jointCount = 0;
 
         //used with BalancedTree if active in frustum culling
+        //the transform and bounds are those last used to update the tree
         std::int32_t m_treeID = -1;
-        glm::vec3 m_lastWorldPosition = glm::vec3(0.f);
+        glm::mat4 m_treeTransform = glm::mat4(1.f);
+        Box m_treeBounds;
 
         friend class ModelRenderer;
         friend class ShadowMapRenderer;
+        friend class Detail::VisibilityPass;
         friend class DeferredRenderSystem;
     };
 }
\ No newline at end of file
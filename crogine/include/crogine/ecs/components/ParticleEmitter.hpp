@@ -35,10 +35,12 @@ source distribution.
 #include <crogine/graphics/Colour.hpp>
 #include <crogine/core/Clock.hpp>
 #include <crogine/graphics/Spatial.hpp>
+#include <crogine/util/Random.hpp>
 
 #include <crogine/detail/glm/vec3.hpp>
 
 #include <array>
+#include <vector>
 
 namespace cro
 {
@@ -46,6 +48,8 @@ namespace cro
 
     /*!
     \brief Data struct for a single particle
+    Note that ParticleEmitters store their particles in
+    Detail::ParticleData rather than an array of these.
     */
     struct CRO_EXPORT_API Particle final
     {
@@ -64,6 +68,45 @@ namespace cro
         float acceleration = 1.f;
     };
 
+    namespace Detail
+    {
+        /*!
+        \brief Particle data stored as a structure of arrays.
+        Each property is in its own array so that the ParticleSystem
+        can update several particles at once with SIMD instructions.
+        Gravity and acceleration are read from the EmitterSettings
+        when updating rather than stored per particle.
+        */
+        struct CRO_EXPORT_API ParticleData final
+        {
+            std::vector<float> positionX;
+            std::vector<float> positionY;
+            std::vector<float> positionZ;
+            std::vector<float> velocityX;
+            std::vector<float> velocityY;
+            std::vector<float> velocityZ;
+            std::vector<float> lifetime;
+            std::vector<float> inverseMaxLifetime; //!< used to calculate alpha when drawing
+            std::vector<float> rotation;
+            std::vector<float> scale;
+            std::vector<float> frameTime;
+            std::vector<std::uint32_t> frameID;
+            std::vector<std::uint32_t> loopCount;
+            std::vector<Colour> colour;
+
+            /*!
+            \brief Resizes all the arrays to the given particle count
+            */
+            void resize(std::size_t count);
+
+            /*!
+            \brief Copies the particle at index src to index dst
+            Used to swap dead particles with the last live particle.
+            */
+            void copy(std::size_t src, std::size_t dst);
+        };
+    }
+
     /*!
     \brief Encapsulates settings used by an emitter to
     initialise particles it creates
@@ -127,7 +170,10 @@ namespace cro
         /*!
         \brief Starts emitting particles with the current settings
         Note that applying custom settings to the emitter will not
-        take effect until the next time this is called.
+        take effect until the next time this is called. The emitter's
+        random generator is reseeded each time, so copies of an emitter
+        will not produce identical spawn patterns. Should be called
+        from the main thread.
         */
         void start();
 
@@ -142,6 +188,11 @@ namespace cro
         */
         const bool stopped() const { return (!m_running && m_nextFreeParticle == 0); }
 
+        /*!
+        \brief Returns the number of live particles belonging to this emitter
+        */
+        std::size_t getParticleCount() const { return m_nextFreeParticle; }
+
         /*!
         \brief Returns the current bounding sphere of the emitter
         */
@@ -165,12 +216,11 @@ namespace cro
         EmitterSettings settings;
 
     private:
-        std::uint32_t m_vbo;
-        std::uint32_t m_vao; //< used on desktop
+        std::int32_t m_firstVertex; //< index of this emitter's first vertex in the ParticleSystem's vertex buffer
         
-        //std::array<Particle, MaxParticles> m_particles;
-        std::vector<Particle> m_particles;
+        Detail::ParticleData m_particles;
         std::size_t m_nextFreeParticle;
+        Util::Random::CounterGenerator m_randomGenerator; //each emitter has its own so spawning can run on any thread
 
         bool m_running;
         float m_emissionTime;
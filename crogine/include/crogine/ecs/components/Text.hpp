@@ -39,11 +39,18 @@ source distribution.
 
 #include <crogine/detail/glm/vec2.hpp>
 
+#include <memory>
+
 namespace cro
 {
     struct Glyph;
     class Drawable2D;
 
+    namespace Detail::Text
+    {
+        struct Layout;
+    }
+
     /*!
     \brief 2D Text component.
     Text components, when used in conjunction with Transformable
@@ -55,6 +62,9 @@ namespace cro
     above that of any other Drawable2D types, such as Sprites,
     currently being rendered by the same RenderSystem2D.
     Text components also require a TextSystem in the active Scene.
+    When only the string changes, such as with counters or timers,
+    the Text is updated from the first character which differs,
+    rather than being rebuilt entirely.
     \see RenderSystem2D::setSortOrder()
     */
     class CRO_EXPORT_API Text final : private FontObserver
@@ -123,8 +133,12 @@ namespace cro
         Negative values will not have the expected result.
         The outline colour must not be transparent and a value
         greater than zero must be set in order for outlines to appear
+        Text using a distance field font is limited to outlines
+        no thicker than Font::DistanceFieldSpread, scaled to the
+        character size of the Text.
         \param outlineThickness The thickness, in pixels, of
         the outline to render
+        \see Font::DistanceFieldSpread
         */
         void setOutlineThickness(float outlineThickness);
 
@@ -229,6 +243,8 @@ namespace cro
 
         TextContext m_context;
 
+        //if only the String flag is set the layout
+        //is updated rather than rebuilt
         struct DirtyFlags final
         {
             enum
@@ -243,6 +259,8 @@ namespace cro
         };
         std::uint16_t m_dirtyFlags;
 
+        std::unique_ptr<Detail::Text::Layout> m_layout;
+
         void updateVertices(Drawable2D&);
 
         void onFontUpdate() override;
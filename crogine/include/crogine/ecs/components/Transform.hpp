@@ -44,6 +44,10 @@ namespace cro
 {
     class Entity;
     class SkeletalAnimator;
+    namespace Detail
+    {
+        class TransformPass;
+    }
     struct Attachment;
 
     /*!
@@ -239,7 +243,9 @@ namespace cro
 
         /*!
         \brief Returns a matrix representing the world space Transform.
-        This is the local transform multiplied by all parenting transforms
+        This is the local transform multiplied by all parenting transforms.
+        The result is cached and only recalculated when this transform, or
+        one of its parents, has been modified since the last call.
         */
         glm::mat4 getWorldTransform() const;
 
@@ -306,6 +312,12 @@ namespace cro
         glm::quat m_rotation;
         mutable glm::mat4 m_transform;
 
+        //cached world space values, invalidated by
+        //any modification to this or any parent transform
+        mutable glm::mat4 m_worldTransform;
+        mutable glm::quat m_worldRotation;
+        mutable glm::vec3 m_worldScale;
+
         Transform* m_parent;
         std::vector<Transform*> m_children = {};
         void doCallbacks() const; //actually mutable - called from getTransform()
@@ -319,7 +331,8 @@ namespace cro
             Parent = 0x1,
             Child = 0x2,
             Tx = 0x4,
-            All = Parent | Child | Tx
+            World = 0x8,
+            All = Parent | Child | Tx | World
         };
         mutable std::uint8_t m_dirtyFlags;
 
@@ -327,10 +340,16 @@ namespace cro
 
         void reset();
 
+        void markDirty(); //marks the local transform dirty and invalidates world transforms
+        void invalidateWorld(); //marks this and all children as requiring a world update
+        void updateWorldTransform() const;
+
         //this is a fudge to allow transforms to read
         //skeletal attachment points
         glm::mat4 m_attachmentTransform;
+        void setAttachmentTransform(const glm::mat4&);
         friend class SkeletalAnimator;
         friend struct Attachment;
+        friend class Detail::TransformPass;
     };
 }
\ No newline at end of file
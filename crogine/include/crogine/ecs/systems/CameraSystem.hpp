@@ -63,6 +63,7 @@ namespace cro
 
         std::size_t m_nextDrawlistIndex;
         std::vector<std::size_t> m_freeDrawlistIndices;
+        std::vector<Entity> m_activeCameras; //< passed to the Scene to update all draw lists at once
 
         void resizeGBuffer(Entity);
         void onEntityAdded(Entity) override;
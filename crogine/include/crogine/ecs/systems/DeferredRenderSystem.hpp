@@ -33,6 +33,8 @@ source distribution.
 #include <crogine/ecs/System.hpp>
 #include <crogine/ecs/Renderable.hpp>
 #include <crogine/graphics/Shader.hpp>
+#include <crogine/graphics/UniformBuffer.hpp>
+#include <crogine/detail/PassData.hpp>
 
 #include <vector>
 
@@ -82,14 +84,18 @@ namespace cro
         struct SortData final
         {
             Entity entity; //model entity
-            std::vector<std::int32_t> materialIDs; //index into the model sub-mesh array
+            std::uint32_t firstMaterial = 0; //offset into the list's materialIDs
+            std::uint32_t materialCount = 0;
             float distanceFromCamera = 0.f; //sort criteria
         };
 
+        //these are cleared each frame rather than recreated
+        //so they don't reallocate once they've grown large enough
         struct VisibleList final
         {
             std::vector<SortData> deferred;
             std::vector<SortData> forward;
+            std::vector<std::int32_t> materialIDs; //indices into the model sub-mesh arrays
         };
 
         //one for each camera we encounter
@@ -147,6 +153,9 @@ namespace cro
         };
         std::array<std::int32_t, OITUniformIDs::Count> m_oitUniforms;
 
+        Detail::PassData m_passData;
+        UniformBuffer<Detail::PassData> m_passBuffer;
+
         bool loadPBRShader();
         bool loadOITShader();
         void setupRenderQuad();
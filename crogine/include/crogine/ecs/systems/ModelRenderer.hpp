@@ -35,25 +35,31 @@ source distribution.
 #include <crogine/ecs/Renderable.hpp>
 #include <crogine/ecs/components/Model.hpp>
 #include <crogine/graphics/MaterialData.hpp>
+#include <crogine/graphics/UniformBuffer.hpp>
 #include <crogine/detail/BalancedTree.hpp>
+#include <crogine/detail/GLStateCache.hpp>
+#include <crogine/detail/PassData.hpp>
 #include <crogine/detail/SDLResource.hpp>
 
+#include <memory>
 #include <vector>
 
 namespace cro
 {
     class MessageBus;
+    class ShaderResource;
     struct Camera;
 
     //don't export this, used internally.
+    //one of these is created for each visible sub-mesh
     struct SortData final
     {
-        std::int64_t flags = 0;
-        std::vector<std::int32_t> matIDs;
+        std::uint64_t key = 0; //packed sort key, see ModelRenderer.cpp
+        Entity entity;
+        std::int32_t matID = 0;
     };
 
-    using MaterialPair = std::pair<Entity, SortData>;
-    using MaterialList = std::vector<MaterialPair>;
+    using MaterialList = std::vector<SortData>;
 
 
     /*!
@@ -71,15 +77,48 @@ namespace cro
         */
         explicit ModelRenderer(MessageBus& mb);
 
+        ~ModelRenderer();
+
+        ModelRenderer(const ModelRenderer&) = delete;
+        ModelRenderer(ModelRenderer&&) = delete;
+        ModelRenderer& operator = (const ModelRenderer&) = delete;
+        ModelRenderer& operator = (ModelRenderer&&) = delete;
+
         /*!
-        \brief Performs frustum culling and Material sorting by depth and blend mode
+        \brief Performs frustum culling and sorts the visible sub-meshes by
+        blend mode, shader, material, mesh and depth so that redundant
+        state changes can be skipped when rendering
         */
         void updateDrawList(Entity) override;
 
+        /*!
+        \brief Updates the draw lists of the given cameras in parallel, using
+        the App's JobSystem. Only the culling and sorting is done here, the
+        draw lists are submitted to OpenGL as usual in render().
+        */
+        void updateDrawLists(const std::vector<Entity>& cameras) override;
+
         void process(float) override;
 
         /*!
-        \brief Attempts to render the scene based on the current entity lists
+        \brief Attempts to render the scene based on the current entity lists.
+        On desktop platforms consecutive sub-meshes which share the same mesh
+        and material are automatically drawn with a single instanced draw call.
+
+        Materials using the built in Unlit, VertexLit or PBR shaders, loaded
+        with ShaderResource::loadBuiltIn(), need no changes for this. The first
+        time a run of them is drawn a variant of the shader with the Instanced
+        flag is compiled and used in its place, along with a copy of the
+        material's properties. Custom shaders are instanced only if they were
+        created with INSTANCING defined and declare the instance attributes with
+        \#include INSTANCE_ATTRIBS, using \#include INSTANCE_MATRICES to create
+        the world and normal matrices. The uniforms for the world and normal
+        matrices are set to identity for instanced draws. Materials with any
+        other custom shader are drawn individually.
+
+        Models which have their own instance transforms, or a skeleton, are
+        always drawn individually. The number of sub-meshes drawn via instancing
+        is reported in RenderStats::instancedSubmeshes.
         */
         void render(Entity, const RenderTarget&) override;
 
@@ -94,6 +133,50 @@ namespace cro
         */
         std::size_t getVisibleCount(std::size_t cameraIndex, std::int32_t passIndex = 0) const;
 
+        /*!
+        \brief Methods used to find the visible models when updating the draw lists.
+        Linear tests every model in the scene against the frustum of each camera pass.
+        Tree places the models in a dynamic AABB tree so that whole branches of the
+        scene can be rejected, or accepted without further testing, at once. This is
+        considerably faster in larger scenes, at the cost of updating the tree when
+        models move. Auto uses the tree when the scene contains at least
+        TreeCullingThreshold models.
+        */
+        enum class CullingMode
+        {
+            Auto, Linear, Tree
+        };
+        static constexpr std::size_t TreeCullingThreshold = 2000;
+
+        /*!
+        \brief Sets the CullingMode used when updating the draw lists.
+        Defaults to CullingMode::Auto
+        */
+        void setCullingMode(CullingMode mode) { m_cullingMode = mode; }
+
+        /*!
+        \brief Returns the current CullingMode
+        */
+        CullingMode getCullingMode() const { return m_cullingMode; }
+
+        /*!
+        \brief Rendering statistics accumulated over all calls to render()
+        during a single frame.
+        */
+        struct RenderStats final
+        {
+            std::uint32_t drawCalls = 0; //!< number of draw calls issued
+            std::uint32_t instancedSubmeshes = 0; //!< number of sub-meshes drawn as part of an automatically instanced draw
+            std::uint32_t stateChangesAvoided = 0; //!< redundant GL state changes skipped
+            std::uint32_t uniformUploadsAvoided = 0; //!< uniform uploads skipped because the value was already set
+            std::uint32_t drawListAllocations = 0; //!< number of times a draw list had to grow. This should be zero once the scene is populated
+        };
+
+        /*!
+        \brief Returns the render statistics of the previous frame
+        */
+        const RenderStats& getRenderStats() const { return m_lastFrameStats; }
+
         struct VertexShaderID final
         {
             enum
@@ -120,7 +203,11 @@ namespace cro
         /*!
         \brief Returns the requested default fragment shader as a string.
         Use this to get the default fragment shader for a specific material
-        type when using custom vertex shaders.
+        type when using custom vertex shaders. The default fragment shaders
+        read the camera and lighting uniforms from the PassData block, so
+        vertex shaders used with them should declare these with
+        \#include PASS_UNIFORMS and \#include WORLD_UNIFORMS, rather than
+        \#include WVP_UNIFORMS, and be loaded via a ShaderResource.
         \param type FragmentShaderID type, Unlit, VertexLit or PBR. Other
         values will return an empty string.
         */
@@ -134,20 +221,93 @@ namespace cro
 
         using DrawList = std::array<MaterialList, 2u>;
         std::vector<DrawList> m_drawLists;
+        std::vector<DrawList> m_batchLists; //visible entities culled by each batch in updateDrawList()
 
-        Mesh::IndexData::Pass m_pass;
+        //working memory used when updating a draw list. There's one for
+        //each draw list so that cameras can be updated in parallel
+        struct DrawListScratch final
+        {
+            MaterialList sortBuffer;
+            //tree nodes waiting to be visited and the frustum planes they may still cross
+            std::vector<std::pair<std::int32_t, std::uint32_t>> treeStack;
+        };
+        std::vector<DrawListScratch> m_drawListScratch;
+
+        Detail::GLStateCache m_stateCache;
+        std::vector<std::uint32_t> m_passPrograms; //shaders which have received the per-pass uniforms
+        Detail::PassData m_passData;
+        UniformBuffer<Detail::PassData> m_passBuffer; //shared by all shaders with a PassData block
+        std::vector<std::pair<std::uint32_t, std::uint64_t>> m_programMaterials; //hash of the material properties last uploaded to each shader
+        RenderStats m_frameStats;
+        RenderStats m_lastFrameStats;
+
+        //consecutive draw items which can be drawn with a single draw call
+        struct DrawRun final
+        {
+            std::size_t firstItem = 0;
+            std::size_t itemCount = 1;
+            std::size_t firstInstance = 0;
+            std::int32_t instancedMaterial = -1; //index into m_instancedMaterials if drawn with a built in shader variant
+            bool instanced = false;
+        };
+        std::vector<DrawRun> m_drawRuns;
+        void buildDrawRuns(const MaterialList&);
 
-        /*Detail::BalancedTree m_tree;
-        bool m_useTreeQueries;*/
+#ifdef PLATFORM_DESKTOP
+        //per-instance data streamed to the instance buffer each render() call
+        struct InstanceData final
+        {
+            glm::mat4 worldMatrix = glm::mat4(1.f);
+            glm::mat3 normalMatrix = glm::mat3(1.f);
+        };
+        std::vector<InstanceData> m_instanceData;
+        std::uint32_t m_instanceBuffer;
+
+        //materials with a built in shader are instanced with a copy which
+        //uses the INSTANCING variant of the shader, and a VAO for each mesh
+        struct InstancedMaterial final
+        {
+            Material::Data source; //the material the copy was made from
+            Material::Data material;
+            std::uint32_t vbo = 0;
+            std::uint32_t ibo = 0;
+            std::size_t vertexSize = 0;
+            std::uint32_t vao = 0;
+            std::int32_t transformAttrib = -1;
+            std::int32_t normalAttrib = -1;
+            std::uint32_t lastBuild = 0;
+            std::uint32_t lastFrame = 0;
+        };
+        std::vector<InstancedMaterial> m_instancedMaterials;
+        std::unique_ptr<ShaderResource> m_instancedShaders; //created the first time a variant is needed
+        std::vector<std::int32_t> m_failedShaders; //built in IDs whose variant failed to compile
+        std::uint32_t m_runBuildID;
+
+        std::int32_t getInstancedMaterial(const Model&, std::int32_t matID);
+        void drawInstanced(const Model&, std::int32_t matID, const DrawRun&) const;
+#endif
+
+        Mesh::IndexData::Pass m_pass;
 
-        void updateDrawListDefault(Entity);
+        CullingMode m_cullingMode;
+        Detail::BalancedTree m_tree;
+        bool m_useTreeQueries;
+        std::uint32_t m_frameID; //the tree is updated at most once per frame
+        std::uint32_t m_treeFrameID;
+
+        void resizeDrawLists(std::size_t);
+        bool buildDrawList(Entity, bool parallel); //returns true if the list had to grow
+        void updateDrawListDefault(Entity, bool parallel);
+        std::size_t getDrawListCapacity(std::size_t listIndex) const;
+        void updateTree();
         void updateDrawListBalancedTree(Entity);
-        //std::vector<Entity> queryTree(Box) const;
 
         friend class DeferredRenderSystem;
         //these funcs are shared with above system - should probably be free funcs somewhere?
-        static void applyProperties(const Material::Data&, const Model&, const Scene&, const Camera&);
-        static void applyBlendMode(const Material::Data&);
+        //if no state cache is given then all state changes are passed directly to OpenGL.
+        //if uploadProperties is false only the material's textures are bound
+        static void applyProperties(const Material::Data&, const Model&, const Scene&, const Camera&, Detail::GLStateCache* = nullptr, bool uploadProperties = true);
+        static void applyBlendMode(const Material::Data&, Detail::GLStateCache* = nullptr);
     };
 
     //just to keep it a bit more inline with the new render system naming
@@ -42,6 +42,11 @@ source distribution.
 
 namespace cro
 {
+    namespace Detail
+    {
+        class StreamBuffer;
+    }
+
     /*!
     \brief Particle system.
     Updates and renders all particle emitters in the scene.
@@ -80,20 +85,20 @@ namespace cro
         std::vector<Entity> m_potentiallyVisible; //entities which are in front of at least one camera
 
         void onEntityAdded(Entity) override;
-        void onEntityRemoved(Entity) override;
 
+        //vertex data for all emitters is streamed into a single
+        //buffer each frame rather than each emitter owning a VBO
         std::vector<float> m_dataBuffer;
-        std::vector<std::uint32_t> m_vboIDs;
-        std::vector<std::uint32_t> m_vaoIDs; //< used on desktop
-        std::size_t m_nextBuffer;
-        std::size_t m_bufferCount;
+        std::unique_ptr<Detail::StreamBuffer> m_vertexBuffer;
+        std::uint32_t m_vao; //< used on desktop
+        std::uint32_t m_vaoBuffer; //< the buffer the VAO attribs currently point to
 
         //this is a fallback texture for untextured systems.
         //probably not less optimal than switching between
         //textured and untextured shaders.
         cro::Texture m_fallbackTexture;
 
-        void allocateBuffer();
+        void updateVertexArray();
 
         std::vector<std::unique_ptr<Shader>> m_shaders;
 
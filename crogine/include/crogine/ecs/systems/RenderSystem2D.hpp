@@ -33,12 +33,22 @@ source distribution.
 #include <crogine/ecs/Renderable.hpp>
 #include <crogine/graphics/MaterialData.hpp>
 #include <crogine/graphics/Shader.hpp>
+#include <crogine/graphics/Vertex2D.hpp>
 #include <crogine/detail/QuadTree.hpp>
 #include <crogine/detail/glm/vec2.hpp>
 #include <crogine/detail/glm/matrix.hpp>
 
+#include <array>
+#include <memory>
+
 namespace cro
 {
+    class Drawable2D;
+    namespace Detail
+    {
+        class StreamBuffer;
+    }
+
     /*!
     \brief Used to decide by which criteria 2D drawables are sorted.
     Drawables are sorted by the given axis of their transform in the
@@ -120,6 +130,31 @@ namespace cro
         */
         static const std::string& getDefaultVertexShader();
 
+        /*!
+        \brief Enables or disables batching of drawables. Disabled by default.
+        When batching is enabled the vertices of drawables which use the default
+        shaders are transformed to world space on the CPU and streamed into a
+        single vertex buffer each frame. Drawables which are next to each other
+        in the draw order and which share the same texture, shader, blend mode
+        and facing are then drawn with a single draw call.
+
+        Drawables which use a custom shader, have uniforms bound to them, are
+        cropped, or which use a primitive type other than GL_TRIANGLES or
+        GL_TRIANGLE_STRIP are drawn individually as usual, so the draw order is
+        unaffected.
+
+        Note that batched vertices are flattened to Z = 0 once transformed, so
+        drawables which rely on their Z position being clipped by the near or
+        far plane of the Camera should not be batched.
+        */
+        void setBatchingEnabled(bool enabled);
+
+        /*!
+        \brief Returns true if batching is enabled
+        \see setBatchingEnabled()
+        */
+        bool getBatchingEnabled() const { return m_batchingEnabled; }
+
     private:
 
         Shader m_colouredShader;
@@ -129,6 +164,45 @@ namespace cro
         bool m_needsSort;
         std::vector<std::vector<Entity>> m_drawLists;
 
+        bool m_batchingEnabled;
+
+        //one of these for each of the default shaders
+        struct BatchShader final
+        {
+            const Shader* shader = nullptr;
+            std::int32_t worldUniform = -1;
+            std::int32_t viewProjectionUniform = -1;
+            std::int32_t textureUniform = -1;
+            std::uint32_t vao = 0; //< only used on desktop
+        };
+        std::array<BatchShader, 2u> m_batchShaders = {};
+
+        //either a range of vertices in the batch buffer,
+        //or a single entity which can't be batched
+        struct Batch final
+        {
+            Entity entity;
+            std::size_t shaderIndex = 0;
+            std::uint32_t textureID = 0;
+            Material::BlendMode blendMode = Material::BlendMode::None;
+            std::uint32_t facing = 0;
+            std::size_t firstVertex = 0;
+            std::size_t vertexCount = 0;
+        };
+        std::vector<Batch> m_batches;
+        std::vector<Entity> m_batchedEntities;
+        std::vector<std::size_t> m_batchedOffsets;
+        std::vector<Vertex2D> m_batchVertices;
+
+        std::unique_ptr<Detail::StreamBuffer> m_batchBuffer;
+        std::uint32_t m_batchVAOBuffer; //< the buffer the batch VAOs currently point to
+
+        bool canBatch(const Drawable2D&) const;
+        void updateBatches(const std::vector<Entity>&);
+        std::size_t uploadBatches();
+        void updateBatchVAOs();
+        void drawSingle(Entity, const glm::mat4& viewProjMat, IntRect viewport, const RenderTarget&, std::uint32_t& lastProgram);
+
         void applyBlendMode(Material::BlendMode);
         glm::ivec2 mapCoordsToPixel(glm::vec2, const glm::mat4& viewProjMat, IntRect) const;
 
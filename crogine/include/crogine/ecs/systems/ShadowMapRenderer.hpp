@@ -34,6 +34,9 @@ source distribution.
 #include <crogine/ecs/Renderable.hpp>
 #include <crogine/graphics/RenderTexture.hpp>
 #include <crogine/graphics/DepthTexture.hpp>
+#include <crogine/graphics/BoundingBox.hpp>
+#include <crogine/graphics/UniformBuffer.hpp>
+#include <crogine/detail/PassData.hpp>
 
 namespace cro
 {
@@ -138,6 +141,14 @@ namespace cro
         //for each camera, for each camera cascade, a vector of entities
         std::vector<std::vector<std::vector<Drawable>>> m_drawLists;
 
+        //light positions and frusta of each cascade of the camera being updated
+        std::vector<glm::vec3> m_lightPositions;
+        std::vector<Box> m_frustums;
+
+        //each cascade is a separate pass as far as the shaders are concerned
+        Detail::PassData m_passData;
+        UniformBuffer<Detail::PassData> m_passBuffer;
+
         void render();
 
         void onEntityAdded(cro::Entity) override;
@@ -30,10 +30,17 @@ source distribution.
 #pragma once
 
 #include <crogine/ecs/System.hpp>
+#include <crogine/graphics/Font.hpp>
+#include <crogine/graphics/Shader.hpp>
+#include <crogine/graphics/Vertex2D.hpp>
+
+#include <unordered_map>
 
 namespace cro
 {
     class Font;
+    class Text;
+    class Drawable2D;
 
     /*!
     \brief Updates the geometry of Drawable2D components which
@@ -41,8 +48,17 @@ namespace cro
     is treated individually - for batching of text geometry a
     custom System can be defined which will combine multiple
     text instances into a single Drawable2D component.
-
-    \see System, Text, RenderSystem2D
+    Layouts are cached and shared between Text components with the
+    same string, font, size and style, and unused layouts are removed
+    after a short time. When many Text components are updated every
+    frame enable batching in the RenderSystem2D, so their vertices are
+    streamed through a single shared buffer.
+    Text using a distance field font is drawn with a shader which
+    smooths and outlines the glyphs, unless the Drawable2D already
+    has a custom shader.
+    \see Font::setDistanceField()
+
+    \see System, Text, RenderSystem2D, RenderSystem2D::setBatchingEnabled()
     */
     class CRO_EXPORT_API TextSystem final : public cro::System
     {
@@ -67,5 +83,24 @@ namespace cro
         };
         std::vector<ReadPage> m_readPages;
         std::vector<ReadPage> m_pageBuffer;
+
+        Shader m_distanceFieldShader;
+        void applyDistanceField(Drawable2D&, const Text&);
+
+        //layouts are keyed by a hash of their context, and
+        //compared in full to make sure the hash didn't collide
+        struct CachedLayout final
+        {
+            TextContext context;
+            std::uint32_t fontRevision = 0;
+            std::vector<Vertex2D> vertices;
+            FloatRect bounds;
+            std::uint64_t lastUsed = 0;
+        };
+        std::unordered_map<std::size_t, CachedLayout> m_layoutCache;
+        std::uint64_t m_frameCount;
+
+        bool fetchLayout(const Text&, Drawable2D&);
+        void storeLayout(const Text&, const Drawable2D&, std::uint32_t fontRevision);
     };
 }
\ No newline at end of file
@@ -40,6 +40,7 @@ by Laurent Gomila et al https://github.com/SFML/SFML/blob/master/src/SFML/Graphi
 #include <crogine/graphics/Colour.hpp>
 #include <crogine/graphics/Texture.hpp>
 
+#include <array>
 #include <map>
 #include <unordered_map>
 #include <vector>
@@ -56,6 +57,7 @@ namespace cro
         float advance = 0.f;
         FloatRect bounds; //< relative to baseline
         FloatRect textureBounds; //< relative to texture atlas
+        float padding = 0.f; //< distance field glyphs include this margin around the bounds in textureBounds
 
         //some glyphs, eg emojis, won't want to be multiplied by fill colour
         bool useFillColour = true;
@@ -142,8 +144,12 @@ namespace cro
     including some colour fonts, eg Emojis. Multiple font files can be
     loaded into a single Font instance and mapped to different codepoint
     ranges.
+
+    Fonts may optionally be rendered as signed distance fields,
+    in which case a single texture is shared by all character sizes.
     \see loadFromFile()
     \see appendFromFile()
+    \see setDistanceField()
     */
     class CRO_EXPORT_API Font final : public Detail::SDLResource
     {
@@ -184,6 +190,8 @@ namespace cro
         /*!
         \brief Attempts to return a float rect representing the sub rectangle of the atlas
         for the given codepoint.
+        The outline thickness is ignored by distance field fonts, as their
+        outlines are drawn by the shader.
         */
         Glyph getGlyph(std::uint32_t codepoint, std::uint32_t charSize, bool bold = false, float outlineThickness = 0.f) const;
 
@@ -210,9 +218,70 @@ namespace cro
         */
         void setSmooth(bool smooth);
 
+        /*!
+        \brief The size, in pixels, at which distance field glyphs are rendered
+        */
+        static constexpr std::uint32_t DistanceFieldSize = 48;
+
+        /*!
+        \brief The distance, in pixels at DistanceFieldSize, which distance
+        field glyphs extend from their edges. This limits the thickness
+        of outlines drawn with distance field fonts.
+        */
+        static constexpr float DistanceFieldSpread = 6.f;
+
+        /*!
+        \brief Enables or disables rendering glyphs as signed distance fields.
+        Distance field glyphs are rendered once, at DistanceFieldSize, to a
+        single texture shared by all character sizes, and scaled when they
+        are drawn. Text components using a distance field font are smoothed
+        and outlined by the TextSystem's shader, so no further glyphs are
+        needed for other sizes or outline thicknesses.
+        New glyphs are rendered on a worker thread, and appear once complete.
+        Colour glyphs, such as emojis, are drawn with the fill colour of the text.
+        Changing this removes any glyphs already loaded by the font.
+        Defaults to false.
+        \see bakeGlyphs()
+        */
+        void setDistanceField(bool enabled);
+
+        /*!
+        \brief Returns true if this font renders distance field glyphs
+        */
+        bool isDistanceField() const { return m_distanceField; }
+
+        /*!
+        \brief Renders any glyphs in the given codepoint range which are
+        not yet loaded, and waits for them to complete.
+        Use this to prepare distance field glyphs before they are needed,
+        or before calling saveGlyphs(). Codepoints not included in the font
+        are skipped.
+        \param codepointRange Range of codepoints to render, inclusive
+        \param bold True to render the bold variant of the glyphs
+        */
+        void bakeGlyphs(std::array<std::uint32_t, 2> codepointRange, bool bold = false);
+
+        /*!
+        \brief Saves the glyphs currently loaded by a distance field font,
+        and their texture, to a file at the given path.
+        \returns true on success
+        \see loadGlyphs()
+        */
+        bool saveGlyphs(const std::string& path) const;
+
+        /*!
+        \brief Loads glyphs previously written with saveGlyphs(), replacing
+        any which are currently loaded, to save rendering them at run time.
+        The font must be a distance field font, loaded with the same font
+        files as when the glyphs were saved.
+        \returns true on success
+        */
+        bool loadGlyphs(const std::string& path);
+
     private:
 
         bool m_useSmoothing;
+        bool m_distanceField;
 
         struct Row final
         {
@@ -235,6 +304,24 @@ namespace cro
         mutable std::unordered_map<std::uint32_t, Page> m_pages;
         mutable std::vector<std::uint8_t> m_pixelBuffer;
 
+        //looking up kerning requires setting the face size so cache it
+        mutable std::unordered_map<std::uint64_t, float> m_kerning;
+
+        //unique value which changes whenever existing glyphs are invalidated,
+        //or move in their page, so cached text layouts know they're out of date
+        mutable std::uint32_t m_revision;
+        void updateRevision() const;
+
+        //distance fields are generated by worker threads and
+        //placed here to be uploaded to the page on the main thread.
+        //This is replaced when the page is cleared so that any
+        //jobs still running don't upload to the new page.
+        struct DistanceFieldQueue;
+        std::shared_ptr<DistanceFieldQueue> m_distanceFieldQueue;
+
+        //all sizes share page 0 when using distance fields
+        std::uint32_t getPageID(std::uint32_t charSize) const { return m_distanceField ? 0 : charSize; }
+
         struct FontData final
         {
             //use std::any so we don't expose freetype pointers to public API
@@ -248,6 +335,8 @@ namespace cro
         const FontData& getFontData(std::uint32_t cp) const;
 
         Glyph loadGlyph(std::uint32_t cp, std::uint32_t charSize, bool bold, float outlineThickness) const;
+        Glyph loadDistanceFieldGlyph(std::uint32_t cp, bool bold) const;
+        void updateDistanceField() const;
         FloatRect getGlyphRect(Page&, std::uint32_t w, std::uint32_t h) const;
         bool setCurrentCharacterSize(std::uint32_t) const;
 
@@ -40,6 +40,7 @@ source distribution.
 #include <crogine/detail/glm/mat4x4.hpp>
 
 #include <unordered_map>
+#include <vector>
 
 namespace cro
 {
@@ -169,6 +170,16 @@ namespace cro
         //allows looking up uniform name when paired location/value
         using PropertyList = std::unordered_map<std::string, std::pair<std::int32_t, Property>>;
 
+        /*!
+        \brief A property flattened by Data::compile() along with
+        the location of the uniform to which it is applied.
+        */
+        struct CRO_EXPORT_API CompiledProperty final
+        {
+            std::int32_t uniform = -1;
+            Property property;
+        };
+
         /*!
         \brief Material data held by a model component and used for rendering.
         This should be created exclusively through a MaterialResource instance,
@@ -309,6 +320,15 @@ namespace cro
             */
             void setShader(const Shader&);
 
+            /*!
+            \brief Flattens the property list into the contiguous array
+            which is used when rendering the material.
+            This is done automatically when a property is set with setProperty()
+            or the material is applied to a Model, so only needs to be called
+            if the properties map is modified directly.
+            */
+            void compile();
+
             /*!
             \brief Allows setting parameters for custom blend mode.
             Set the blendMode property to BlendMode::Custom to use these
@@ -328,6 +348,10 @@ namespace cro
             */
 
             std::uint32_t shader = 0;
+            //true if the shader reads the per-pass uniforms from the PassData block
+            bool passData = false;
+            //the ShaderResource::BuiltIn ID of the shader, or -1 if it's a custom shader
+            std::int32_t builtInShader = -1;
             //maps attrib location to attrib size between shader and mesh - index, size, pointer offset
             std::array<std::array<std::int32_t, 3u>, Shader::AttributeID::Count> attribs{};
             std::size_t attribCount = 0; //< count of attributes successfully mapped
@@ -339,9 +363,17 @@ namespace cro
             std::size_t optionalUniformCount = 0;
             std::array<std::int32_t, 10> optionalUniforms{};
 
+            //properties with a value set, flattened by compile(), and a hash
+            //of their contents. Renderers can compare the hash to skip uploading
+            //a material whose values are already applied to the shader.
+            std::vector<CompiledProperty> compiledProperties;
+            std::uint64_t propertyHash = 0;
+
         private:
             std::unordered_map<std::string, bool> m_warnings;
             void exists(const std::string&);
+            void updateCompiled(const std::pair<std::int32_t, Property>&);
+            void updateHash();
         };
     }
 }
\ No newline at end of file
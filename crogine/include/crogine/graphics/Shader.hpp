@@ -115,6 +115,20 @@ namespace cro
         */
         std::int32_t getUniformID(const std::string& uniformName) const;
 
+        /*!
+        \brief Returns true if the shader reads its camera and lighting
+        uniforms from the per-pass uniform block declared by the PASS_UNIFORMS
+        include, rather than having them set individually. This is always
+        false on mobile platforms.
+        */
+        bool hasPassData() const { return m_hasPassData; }
+
+        /*!
+        \brief Returns the ID of the built in shader this was created as,
+        ie the ShaderResource::BuiltIn type combined with its BuiltInFlags,
+        or -1 if the shader wasn't created with ShaderResource::loadBuiltIn().
+        */
+        std::int32_t getBuiltInID() const { return m_builtInID; }
 
     private:
         bool loadFromSource(const char* v, const char* g, const char* f, const char* d);
@@ -124,9 +138,13 @@ namespace cro
         bool fillAttribMap();
         void resetAttribMap();
         std::unordered_map<std::string, std::int32_t> m_uniformMap;
+        bool m_hasPassData;
+        std::int32_t m_builtInID;
         void fillUniformMap();
         void resetUniformMap();
         std::string parseFile(const std::string&);
+
+        friend class ShaderResource;
     };
 }
 
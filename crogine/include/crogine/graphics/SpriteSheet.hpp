@@ -115,5 +115,15 @@ namespace cro
         mutable std::unordered_map<std::string, std::vector<std::string>> m_animations;
         std::string m_texturePath;
         const cro::Texture* m_texture;
+
+        //as read from the file, and written by saveToFile() if there's no texture
+        bool m_smooth;
+        bool m_repeated;
+
+        //if textures is nullptr only the sprite data is loaded, and
+        //the sprites are left without a texture
+        bool load(const std::string& path, TextureResource* textures, const std::string& workingDirectory);
+
+        friend class TextureAtlas;
     };
 }
\ No newline at end of file
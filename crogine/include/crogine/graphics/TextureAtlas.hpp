@@ -0,0 +1,188 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/Config.hpp>
+#include <crogine/graphics/Texture.hpp>
+#include <crogine/graphics/Rectangle.hpp>
+#include <crogine/ecs/components/Sprite.hpp>
+
+#include <crogine/detail/glm/vec2.hpp>
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace cro
+{
+    class Image;
+    class SpriteSheet;
+
+    /*!
+    \brief Packs multiple Images into a single Texture at runtime.
+
+    Drawables can only be batched together by the RenderSystem2D when
+    they share a texture, so packing the images used by a UI screen
+    into a TextureAtlas means the screen can be drawn with only a handful
+    of draw calls, rather than one for each Sprite.
+
+    Images are placed with a skyline bottom-left packer, so adding the
+    same images in the same order always produces the same layout. Larger
+    images should be added first for the best use of space.
+
+    When a SpriteSheet is added to the atlas the Sprites it contains are
+    moved on to the atlas texture and their texture rectangles and animation
+    frames offset to match, so that Sprites returned from it afterwards are
+    used exactly as before. Normalised coordinates for custom Drawable2D
+    geometry can be found with getTexture().getNormalisedSubrect(getRect(name)).
+
+    Sprites created from a TextureAtlas refer to its texture, so the atlas
+    must outlive any Sprites it creates. For this reason TextureAtlas is
+    non-copyable and non-moveable. Repeated textures are not supported.
+    */
+    class CRO_EXPORT_API TextureAtlas final
+    {
+    public:
+        TextureAtlas();
+
+        TextureAtlas(const TextureAtlas&) = delete;
+        TextureAtlas(TextureAtlas&&) = delete;
+        TextureAtlas& operator = (const TextureAtlas&) = delete;
+        TextureAtlas& operator = (TextureAtlas&&) = delete;
+
+        /*!
+        \brief Creates an empty atlas of the given size, removing
+        any existing images.
+        \param width Width of the atlas texture in pixels
+        \param height Height of the atlas texture in pixels
+        \param padding Number of empty pixels left between images,
+        which prevents neighbouring images bleeding in to each other
+        when the texture is smoothed.
+        */
+        void create(std::uint32_t width, std::uint32_t height, std::uint32_t padding = 1);
+
+        /*!
+        \brief Packs the given image into the atlas.
+        \param name Name used to look up the image's rectangle. This must be unique
+        \param image The image to pack. RGB and A format images are converted to RGBA.
+        \returns true on success, or false if the name is already in use or
+        there is no room left in the atlas.
+        */
+        bool addImage(const std::string& name, const Image& image);
+
+        /*!
+        \brief Attempts to load an image from the given path and pack it in the atlas.
+        The path is used as the name of the image.
+        \returns true on success, else false
+        */
+        bool addImage(const std::string& path);
+
+        /*!
+        \brief Packs the texture of the given SpriteSheet into the atlas,
+        and remaps all of its Sprites on to the atlas texture.
+        The image is loaded from the SpriteSheet's texture path and added
+        using that path as its name. If the image was already added by
+        another SpriteSheet that copy is shared.
+        \param sheet The SpriteSheet to pack
+        \param workingDirectory The same working directory passed to
+        SpriteSheet::loadFromFile() when the sheet was loaded, if any
+        \returns true on success, else false in which case the SpriteSheet
+        is unmodified.
+        */
+        bool addSpriteSheet(SpriteSheet& sheet, const std::string& workingDirectory = "");
+
+        /*!
+        \brief Packs the textures of the given sprite sheet files into the
+        atlas and writes the atlas and the remapped sprite sheets to disk.
+        This is intended to be used as an offline step, so that packed sprite
+        sheets can be loaded directly at runtime. For each sprite sheet
+        <name>.spt a new file <name>_packed.spt is written next to it, which
+        refers to the atlas image rather than its original texture, and keeps
+        the original smooth property. As the packed sheets share a texture
+        the last one loaded decides whether it is smoothed, so sheets should
+        only be packed together if they use the same setting.
+        \param sheetPaths Paths to the sprite sheet files to pack
+        \param imagePath Path to which to write the atlas image, relative to
+        the working directory. The packed sprite sheets use this as their
+        texture path.
+        \param workingDirectory Working directory used to load the sprite
+        sheet textures and to write the atlas image.
+        \returns true if all the sprite sheets were packed and saved, else false
+        */
+        bool packSpriteSheets(const std::vector<std::string>& sheetPaths, const std::string& imagePath, const std::string& workingDirectory = "");
+
+        /*!
+        \brief Returns true if an image with the given name exists in the atlas
+        */
+        bool hasImage(const std::string& name) const;
+
+        /*!
+        \brief Returns the rectangle in pixels of the image with the given name,
+        or an empty rectangle if the image doesn't exist.
+        */
+        FloatRect getRect(const std::string& name) const;
+
+        /*!
+        \brief Returns a Sprite which draws the image with the given name from
+        the atlas texture. If the image doesn't exist an empty sprite is returned.
+        */
+        Sprite getSprite(const std::string& name) const;
+
+        /*!
+        \brief Returns the atlas texture
+        */
+        const Texture& getTexture() const { return m_texture; }
+        Texture& getTexture() { return m_texture; }
+
+        /*!
+        \brief Saves the atlas texture as a png image at the given path
+        \returns true on success else false
+        */
+        bool saveToFile(const std::string& path) const;
+
+    private:
+        Texture m_texture;
+        std::uint32_t m_padding;
+        std::unordered_map<std::string, URect> m_rects;
+
+        //the top edge of the used space, stored as horizontal
+        //segments ordered from left to right
+        struct SkylineNode final
+        {
+            std::uint32_t x = 0;
+            std::uint32_t y = 0;
+            std::uint32_t width = 0;
+        };
+        std::vector<SkylineNode> m_skyline;
+
+        bool findPosition(std::uint32_t width, std::uint32_t height, glm::uvec2& position, std::size_t& index) const;
+        void addSkylineNode(std::size_t index, glm::uvec2 position, std::uint32_t width, std::uint32_t height);
+    };
+}
@@ -99,7 +99,9 @@ namespace cro
 	This class can be used to more efficiently group together shader
 	uniforms which are common between many shaders, for example elapsed
 	game time. Only really useful when using custom shaders, rather than
-	the built in material shaders (which have no uniform blocks defined).
+	the built in material shaders. The built in shaders share a PassData
+	block which is updated by the renderers, and so its bind point,
+	Detail::PassData::BindPoint, should not be used by other buffers.
 
 	UniformBuffer is moveable but non-copyable.
 
@@ -37,6 +37,9 @@ https://bruop.github.io/improved_frustum_culling/
 #include <crogine/graphics/Spatial.hpp>
 #include <crogine/detail/glm/mat4x4.hpp>
 
+#include <cstdint>
+#include <cstddef>
+
 namespace cro
 {
     /*!
@@ -64,5 +67,32 @@ namespace cro
         */
 
         bool CRO_EXPORT_API visible(FrustumData data, const glm::mat4& viewSpaceTransform, Box aabb);
+
+        /*!
+        \brief Tests an array of bounding spheres against the planes of a frustum.
+        On supported platforms the spheres are tested four at a time using SSE or NEON.
+        \param frustum The planes of the frustum, in the same space as the spheres,
+        for example as returned from Camera::Pass::getFrustum()
+        \param spheres Pointer to the first Sphere in the array
+        \param count Number of Spheres in the array
+        \param output Pointer to an array of at least (count + 31) / 32 values. Each
+        bit is set if the Sphere at the corresponding index is at least partially inside
+        the frustum, starting with the least significant bit of output[0]. A Sphere
+        is visible unless Spatial::intersects() returns Planar::Back for any plane.
+        Spatial::intersects() is the reference: the SIMD path evaluates the same
+        expression, so results are identical for all input, including NaN values.
+        */
+        void CRO_EXPORT_API visible(const cro::Frustum& frustum, const Sphere* spheres, std::size_t count, std::uint32_t* output);
+
+        /*!
+        \brief Tests an array of axis aligned bounding boxes against the planes of a frustum.
+        As with Spheres, the results are identical to testing each Box with Spatial::intersects().
+        \param frustum The planes of the frustum, in the same space as the boxes
+        \param boxes Pointer to the first Box in the array
+        \param count Number of Boxes in the array
+        \param output Pointer to an array of at least (count + 31) / 32 values which
+        receives a bit for each Box as described above.
+        */
+        void CRO_EXPORT_API visible(const cro::Frustum& frustum, const Box* boxes, std::size_t count, std::uint32_t* output);
     }
 }
\ No newline at end of file
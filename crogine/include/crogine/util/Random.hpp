@@ -34,7 +34,11 @@ source distribution.
 #include <crogine/graphics/Rectangle.hpp>
 
 #include <random>
+#include <algorithm>
+#include <cmath>
 #include <ctime>
+#include <cstdint>
+#include <limits>
 
 namespace cro
 {
@@ -80,6 +84,68 @@ namespace cro
                 std::uniform_int_distribution<std::size_t> dist(begin, end);
                 return dist(rndEngine);
             }
+            /*!
+            \brief Fast counter based pseudo random number generator.
+            Each value is a hash of the seed and an incrementing counter (SplitMix64)
+            so generators are cheap to create, and unlike the functions above
+            separate instances can be used on different threads without sharing
+            any state. Satisfies UniformRandomBitGenerator so it may also be
+            used with std distributions and algorithms. Not suitable for
+            cryptographic use.
+            */
+            class CounterGenerator final
+            {
+            public:
+                using result_type = std::uint64_t;
+
+                explicit CounterGenerator(std::uint64_t seed = 0) : m_seed(seed), m_counter(0) {}
+
+                /*!
+                \brief Sets the seed and resets the counter
+                */
+                void seed(std::uint64_t seed) { m_seed = seed; m_counter = 0; }
+
+                static constexpr result_type min() { return 0; }
+                static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+                /*!
+                \brief Returns the next 64 bit value in the sequence
+                */
+                result_type operator()()
+                {
+                    auto z = m_seed + (++m_counter * 0x9E3779B97F4A7C15ull);
+                    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                    return z ^ (z >> 31);
+                }
+
+                /*!
+                \brief Returns a pseudo random floating point value in the range [begin, end)
+                */
+                float value(float begin, float end)
+                {
+                    CRO_ASSERT(begin < end, "first value is not less than last value");
+                    const auto t = static_cast<float>((*this)() >> 40) * (1.f / 16777216.f);
+
+                    //rounding can land exactly on end when the range is large
+                    return std::min(begin + ((end - begin) * t), std::nextafter(end, begin));
+                }
+
+                /*!
+                \brief Returns a pseudo random integer value in the range [begin, end]
+                */
+                int value(int begin, int end)
+                {
+                    CRO_ASSERT(begin < end, "first value is not less than last value");
+                    const auto range = static_cast<std::uint64_t>(static_cast<std::int64_t>(end) - begin) + 1;
+                    return begin + static_cast<int>((((*this)() >> 32) * range) >> 32);
+                }
+
+            private:
+                std::uint64_t m_seed;
+                std::uint64_t m_counter;
+            };
+
             /*!
             \brief Returns a poisson disc sampled distribution of points within a given area
             \param area sf::FloatRect within which the points are distributed
@@ -449,6 +449,9 @@ void App::run()
             simulate(m_frameTime);
         }
 
+        //jobs which need the GL context
+        m_jobSystem.processMainThreadJobs();
+
         doImGui();
 
         ImGui::Render();
@@ -458,6 +461,9 @@ void App::run()
         m_window.display();
     }
 
+    //make sure no jobs are running when we start tidying up
+    m_jobSystem.shutdown();
+
     saveSettings();
 
     Console::finalise();
@@ -508,6 +514,12 @@ void App::resetFrameTime()
     timeSinceLastUpdate = 0.f;
 }
 
+JobSystem& App::getJobSystem()
+{
+    CRO_ASSERT(m_instance, "No valid app instance");
+    return m_instance->m_jobSystem;
+}
+
 App& App::getInstance()
 {
     CRO_ASSERT(m_instance, "");
@@ -39,6 +39,7 @@ source distribution.
 #include <unordered_map>
 #include <algorithm>
 #include <array>
+#include <mutex>
 
 using namespace cro;
 namespace ui = ImGui;
@@ -76,6 +77,9 @@ namespace
 
     bool isNewFrame = true;
     bool showDemoWindow = false;
+
+    //stats may be printed by renderers updating their draw lists on worker threads
+    std::mutex debugLineMutex;
 }
 int textEditCallback(ImGuiInputTextCallbackData* data);
 
@@ -203,6 +207,7 @@ void Console::addConvar(const std::string& name, const std::string& defaultValue
 
 void Console::printStat(const std::string& name, const std::string& value)
 {
+    std::scoped_lock lock(debugLineMutex);
     m_debugLines.push_back(name + ":" + value);
 }
 
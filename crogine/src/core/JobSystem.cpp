@@ -0,0 +1,320 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include <crogine/core/JobSystem.hpp>
+#include <crogine/core/Log.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include <algorithm>
+
+using namespace cro;
+
+namespace
+{
+    //identifies which worker, if any, is the current thread
+    thread_local const JobSystem* currentJobSystem = nullptr;
+    thread_local std::size_t currentWorker = 0;
+
+    //number of batches per thread created by parallelFor()
+    //so that uneven workloads are still balanced
+    constexpr std::size_t BatchesPerThread = 4;
+}
+
+JobSystem::JobSystem(std::size_t workerCount)
+    : m_queuedCount (0),
+    m_running       (true)
+{
+    if (workerCount == 0)
+    {
+        const auto threadCount = std::thread::hardware_concurrency();
+        workerCount = threadCount > 1 ? threadCount - 1 : 0;
+    }
+
+    for (auto i = 0u; i < workerCount + 1; ++i)
+    {
+        m_queues.emplace_back(std::make_unique<Queue>());
+    }
+
+    for (auto i = 0u; i < workerCount; ++i)
+    {
+        m_threads.emplace_back(&JobSystem::threadFunc, this, i);
+    }
+
+    LogI << "Created job system with " << workerCount << " workers" << std::endl;
+}
+
+JobSystem::~JobSystem()
+{
+    shutdown();
+}
+
+//public
+void JobSystem::schedule(Job job, Counter* counter)
+{
+    if (!m_running || m_threads.empty())
+    {
+        job();
+        return;
+    }
+
+    if (counter)
+    {
+        counter->m_pending++;
+    }
+
+    //workers push to the back of their own queue, and pop from the back
+    //so recently scheduled jobs are executed while their data is still hot
+    auto& queue = *m_queues[getQueueIndex()];
+    {
+        std::scoped_lock lock(queue.mutex);
+        queue.tasks.push_back({ std::move(job), counter });
+    }
+    m_queuedCount++;
+
+    //lock the mutex to make sure a worker can't miss
+    //the notification between checking the count and waiting
+    {
+        std::scoped_lock lock(m_sleepMutex);
+    }
+    m_sleepCondition.notify_one();
+}
+
+void JobSystem::wait(const Counter& counter)
+{
+    //only jobs using this counter are executed, else the calling thread
+    //may pick up an unrelated long running job and be stalled by it
+    const auto queueIndex = getQueueIndex();
+    while (!counter.done())
+    {
+        if (!tryExecute(queueIndex, &counter))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& func, std::size_t minBatchSize)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    minBatchSize = std::max(std::size_t(1), minBatchSize);
+    const auto batchCount = std::min(count / minBatchSize, (m_threads.size() + 1) * BatchesPerThread);
+
+    if (batchCount < 2
+        || !m_running
+        || m_threads.empty())
+    {
+        func(0, count);
+        return;
+    }
+
+    const auto batchSize = (count + batchCount - 1) / batchCount;
+
+    Counter counter;
+    for (auto start = batchSize; start < count; start += batchSize)
+    {
+        const auto end = std::min(start + batchSize, count);
+        schedule([&func, start, end]() { func(start, end); }, &counter);
+    }
+
+    //process the first batch on this thread
+    func(0, batchSize);
+    wait(counter);
+}
+
+void JobSystem::scheduleOnMainThread(Job job)
+{
+    std::scoped_lock lock(m_mainThreadMutex);
+    m_mainThreadJobs.push_back(std::move(job));
+}
+
+void JobSystem::processMainThreadJobs()
+{
+    CRO_ASSERT(!isWorkerThread(), "Must be called from the main thread");
+
+    //jobs may queue more jobs, which are
+    //executed next time this is called
+    {
+        std::scoped_lock lock(m_mainThreadMutex);
+        m_mainThreadBuffer.swap(m_mainThreadJobs);
+    }
+
+    for (auto& job : m_mainThreadBuffer)
+    {
+        job();
+    }
+    m_mainThreadBuffer.clear();
+}
+
+void JobSystem::shutdown()
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    //help complete any pending jobs
+    const auto queueIndex = getQueueIndex();
+    while (m_queuedCount != 0)
+    {
+        if (!tryExecute(queueIndex))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    {
+        std::scoped_lock lock(m_sleepMutex);
+        m_running = false;
+    }
+    m_sleepCondition.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+    m_threads.clear();
+
+    processMainThreadJobs();
+}
+
+bool JobSystem::isWorkerThread() const
+{
+    return currentJobSystem == this;
+}
+
+//private
+void JobSystem::threadFunc(std::size_t index)
+{
+    currentJobSystem = this;
+    currentWorker = index;
+
+    while (true)
+    {
+        if (tryExecute(index))
+        {
+            continue;
+        }
+
+        std::unique_lock lock(m_sleepMutex);
+        m_sleepCondition.wait(lock, [&]() { return m_queuedCount != 0 || !m_running; });
+
+        if (!m_running
+            && m_queuedCount == 0)
+        {
+            return;
+        }
+    }
+}
+
+std::size_t JobSystem::getQueueIndex() const
+{
+    return isWorkerThread() ? currentWorker : m_queues.size() - 1;
+}
+
+bool JobSystem::tryExecute(std::size_t queueIndex, const Counter* counter)
+{
+    Task task;
+    bool found = false;
+
+    //if a counter is given only tasks using it are taken
+    const auto matches = [counter](const Task& t)
+    {
+        return counter == nullptr || t.counter == counter;
+    };
+
+    const auto take = [&](std::size_t index, bool newest)
+    {
+        auto& queue = *m_queues[index];
+        std::scoped_lock lock(queue.mutex);
+        if (newest)
+        {
+            auto result = std::find_if(queue.tasks.rbegin(), queue.tasks.rend(), matches);
+            if (result != queue.tasks.rend())
+            {
+                task = std::move(*result);
+                queue.tasks.erase(std::next(result).base());
+                found = true;
+            }
+        }
+        else
+        {
+            auto result = std::find_if(queue.tasks.begin(), queue.tasks.end(), matches);
+            if (result != queue.tasks.end())
+            {
+                task = std::move(*result);
+                queue.tasks.erase(result);
+                found = true;
+            }
+        }
+    };
+
+    //own queue first, taking the newest job
+    const auto workerCount = m_queues.size() - 1;
+    if (queueIndex != workerCount)
+    {
+        take(queueIndex, true);
+    }
+
+    //then the shared queue
+    if (!found)
+    {
+        take(workerCount, false);
+    }
+
+    //then steal from the other workers, starting with our neighbour
+    for (auto i = 1u; i <= workerCount && !found; ++i)
+    {
+        const auto index = (queueIndex + i) % workerCount;
+        if (index != queueIndex)
+        {
+            take(index, false);
+        }
+    }
+
+    if (found)
+    {
+        m_queuedCount--;
+        execute(task);
+    }
+    return found;
+}
+
+void JobSystem::execute(Task& task)
+{
+    task.job();
+
+    if (task.counter)
+    {
+        task.counter->m_pending--;
+    }
+}
@@ -33,26 +33,44 @@ using namespace cro;
 
 namespace
 {
-    //max msg size is 128 bytes, so 128 messages
-    //maximum per frame is 16384 bytes
-    const std::size_t bufferSize = 16384u;
+    constexpr std::size_t alignUp(std::size_t size, std::size_t alignment)
+    {
+        return (size + (alignment - 1)) & ~(alignment - 1);
+    }
 }
 
 MessageBus::MessageBus()
-    : m_currentBuffer   (bufferSize),
-    m_pendingBuffer     (bufferSize),
-    m_inPointer         (m_pendingBuffer.data()),
-    m_outPointer        (m_currentBuffer.data()),
-    m_currentCount      (0),
-    m_pendingCount      (0),
-    m_enabled           (true)
-{}
+    : m_activePage  (nullptr),
+    m_pendingCount  (0),
+    m_currentCount  (0),
+    m_readPage      (0),
+    m_readOffset    (0),
+    m_readIndex     (0),
+    m_enabled       (true)
+{
+    m_pendingPages.push_back(getFreePage());
+    m_activePage = m_pendingPages.back().get();
+}
+
+MessageBus::~MessageBus() = default;
 
 const Message& MessageBus::poll()
 {
-    static auto size = sizeof(Message);
-    const Message& m = *reinterpret_cast<Message*>(m_outPointer);
-    m_outPointer += (size + m.m_dataSize);
+    CRO_ASSERT(m_currentCount != 0, "No messages to poll");
+
+    //skip to the next page once all of this page's messages are read
+    while (m_readIndex == m_currentPages[m_readPage]->messageCount)
+    {
+        m_readPage++;
+        m_readOffset = 0;
+        m_readIndex = 0;
+        CRO_ASSERT(m_readPage < m_currentPages.size(), "Page index out of range");
+    }
+
+    const auto& page = *m_currentPages[m_readPage];
+    const Message& m = *reinterpret_cast<const Message*>(page.data.data() + m_readOffset);
+    m_readOffset += alignUp(sizeof(Message), Alignment) + alignUp(m.m_dataSize, Alignment);
+    m_readIndex++;
     m_currentCount--;
 
     return m;
@@ -62,11 +80,25 @@ bool MessageBus::empty()
 {
     if (m_currentCount == 0)
     {
-        m_currentBuffer.swap(m_pendingBuffer);
-        m_inPointer = m_pendingBuffer.data();
-        m_outPointer = m_currentBuffer.data();
-        m_currentCount = m_pendingCount;
-        m_pendingCount = 0;
+        std::scoped_lock lock(m_pageMutex);
+
+        //pages which have been read can be reused
+        for (auto& page : m_currentPages)
+        {
+            page->used = 0;
+            page->messageCount = 0;
+            m_freePages.push_back(std::move(page));
+        }
+        m_currentPages.clear();
+        m_currentPages.swap(m_pendingPages);
+
+        m_pendingPages.push_back(getFreePage());
+        m_activePage = m_pendingPages.back().get();
+
+        m_currentCount = m_pendingCount.exchange(0);
+        m_readPage = 0;
+        m_readOffset = 0;
+        m_readIndex = 0;
         return true;
     }
     return false;
@@ -75,4 +107,54 @@ bool MessageBus::empty()
 std::size_t MessageBus::pendingMessageCount() const
 {
     return m_pendingCount;
-}
\ No newline at end of file
+}
+
+//private
+void* MessageBus::allocate(Message::ID id, std::size_t dataSize)
+{
+    if (!m_enabled) return m_disabledBuffer.data();
+
+    CRO_ASSERT(dataSize <= MaxDataSize, "message size exceeds 128 bytes");
+    const auto headerSize = alignUp(sizeof(Message), Alignment);
+    const auto size = headerSize + alignUp(dataSize, Alignment);
+
+    while (true)
+    {
+        auto* page = m_activePage.load(std::memory_order_acquire);
+        const auto offset = page->used.fetch_add(size, std::memory_order_relaxed);
+
+        //once an allocation fails every subsequent one on this page does too,
+        //so the messages on a page are always contiguous from the beginning
+        if (offset + size <= PageSize)
+        {
+            Message* msg = new (page->data.data() + offset)Message();
+            msg->id = id;
+            msg->m_dataSize = dataSize;
+            msg->m_data = page->data.data() + offset + headerSize;
+
+            page->messageCount.fetch_add(1, std::memory_order_release);
+            m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+            return msg->m_data;
+        }
+
+        //page is full - the first thread to get here adds a new one
+        std::scoped_lock lock(m_pageMutex);
+        if (m_activePage.load(std::memory_order_relaxed) == page)
+        {
+            m_pendingPages.push_back(getFreePage());
+            m_activePage.store(m_pendingPages.back().get(), std::memory_order_release);
+        }
+    }
+}
+
+MessageBus::PagePtr MessageBus::getFreePage()
+{
+    if (m_freePages.empty())
+    {
+        return std::make_unique<Page>();
+    }
+
+    auto page = std::move(m_freePages.back());
+    m_freePages.pop_back();
+    return page;
+}
@@ -63,13 +63,18 @@ BalancedTree::BalancedTree(float fattenAmount)
 //public
 std::int32_t BalancedTree::addToTree(Entity entity, Box bounds)
 {
-    auto treeID = allocateNode();
-
     const auto& tx = entity.getComponent<Transform>();
 
     bounds += tx.getOrigin();
     bounds = tx.getWorldTransform() * bounds;
 
+    return addWorldBounds(entity, bounds);
+}
+
+std::int32_t BalancedTree::addWorldBounds(Entity entity, Box bounds)
+{
+    auto treeID = allocateNode();
+
     //fatten AABB
     bounds[0] -= m_fattenAmount;
     bounds[1] += m_fattenAmount;
@@ -371,7 +376,7 @@ void BalancedTree::insertLeaf(std::int32_t treeID)
         CRO_ASSERT(childA != TreeNode::Null, "Can't be null");
         CRO_ASSERT(childB != TreeNode::Null, "Can't be null");
 
-        m_nodes[index].height = std::max(m_nodes[childA].height, m_nodes[childB].height);
+        m_nodes[index].height = std::max(m_nodes[childA].height, m_nodes[childB].height) + 1;
         m_nodes[index].fatBounds = Box::merge(m_nodes[childA].fatBounds, m_nodes[childB].fatBounds);
 
         index = m_nodes[index].parent;
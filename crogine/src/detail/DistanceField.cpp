@@ -66,6 +66,61 @@ std::vector<std::uint8_t> DistanceField::toDF(const SDL_Surface* input)
     return toBytes(floatData);
 }
 
+std::vector<std::uint8_t> DistanceField::toSignedDF(const std::uint8_t* coverage, std::int32_t width, std::int32_t height, float spread)
+{
+    const std::size_t size = width * height;
+    std::vector<std::uint8_t> retVal(size, 0);
+
+    //distance from each outside pixel to the shape, and each inside pixel to the outside.
+    //A large finite value is used rather than INF so that rows or columns without
+    //any edge pixels don't produce NaN
+    constexpr float Far = 1e20f;
+    std::vector<float> outside(size);
+    std::vector<float> inside(size);
+    bool hasInside = false;
+    for (auto i = 0u; i < size; ++i)
+    {
+        const bool isInside = coverage[i] > 127;
+        hasInside = hasInside || isInside;
+
+        outside[i] = isInside ? 0.f : Far;
+        inside[i] = isInside ? Far : 0.f;
+    }
+
+    if (!hasInside)
+    {
+        return retVal;
+    }
+
+    twoD(outside, width, height);
+    twoD(inside, width, height);
+
+    for (auto i = 0u; i < size; ++i)
+    {
+        //distances are measured between pixel centres so move
+        //the edge half way between them, or use the coverage
+        //to estimate it for pixels which straddle the edge
+        float dist = 0.f;
+        if (coverage[i] != 0 && coverage[i] != 255)
+        {
+            dist = 0.5f - (static_cast<float>(coverage[i]) / 255.f);
+        }
+        else if (coverage[i] > 127)
+        {
+            dist = 0.5f - std::sqrt(inside[i]);
+        }
+        else
+        {
+            dist = std::sqrt(outside[i]) - 0.5f;
+        }
+
+        const float value = std::clamp(0.5f - (dist / (spread * 2.f)), 0.f, 1.f);
+        retVal[i] = static_cast<std::uint8_t>(value * 255.f);
+    }
+
+    return retVal;
+}
+
 //private
 void DistanceField::twoD(std::vector<float>& floatData, std::int32_t width, std::int32_t height)
 {
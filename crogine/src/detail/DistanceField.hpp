@@ -46,6 +46,14 @@ namespace cro
         public:
             static std::vector<std::uint8_t> toDF(const SDL_Surface* input);
 
+            /*!
+            \brief Creates a signed distance field from a single channel coverage
+            buffer, such as a rasterised glyph. The edge of the shape is stored as
+            128, increasing inside the shape and decreasing outside of it, reaching
+            0 or 255 at the given spread, in pixels, from the edge.
+            */
+            static std::vector<std::uint8_t> toSignedDF(const std::uint8_t* coverage, std::int32_t width, std::int32_t height, float spread);
+
         private:
             static void twoD(std::vector<float>&, std::int32_t, std::int32_t);
             static std::vector<float> oneD(const std::vector<float>&, std::size_t);
@@ -0,0 +1,187 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "GLCheck.hpp"
+
+#include <crogine/detail/GLStateCache.hpp>
+
+using namespace cro;
+using namespace cro::Detail;
+
+GLStateCache::GLStateCache()
+    : m_program     (Unknown),
+    m_activeUnit    (Unknown),
+    m_depthMask     (Unknown),
+    m_blendEquation (Unknown),
+    m_frontFace     (Unknown),
+    m_avoidedCount  (0)
+{
+    invalidate();
+}
+
+//public
+void GLStateCache::invalidate()
+{
+    m_program = Unknown;
+    m_activeUnit = Unknown;
+    m_textures.fill({});
+    m_capabilities.fill(Unknown);
+    m_depthMask = Unknown;
+    m_blendFunc.fill(Unknown);
+    m_blendEquation = Unknown;
+    m_frontFace = Unknown;
+}
+
+bool GLStateCache::useProgram(std::uint32_t program)
+{
+    if (m_program == program)
+    {
+        m_avoidedCount++;
+        return false;
+    }
+
+    glCheck(glUseProgram(program));
+    m_program = program;
+    return true;
+}
+
+void GLStateCache::bindTexture(std::uint32_t unit, std::uint32_t target, std::uint32_t texture)
+{
+    if (unit >= MaxTextureUnits)
+    {
+        //not tracked, so always bind
+        glCheck(glActiveTexture(GL_TEXTURE0 + unit));
+        glCheck(glBindTexture(target, texture));
+        m_activeUnit = unit;
+        return;
+    }
+
+    auto& binding = m_textures[unit];
+    if (binding.target == target
+        && binding.texture == texture)
+    {
+        m_avoidedCount += 2; //active texture and bind
+        return;
+    }
+
+    if (m_activeUnit != unit)
+    {
+        glCheck(glActiveTexture(GL_TEXTURE0 + unit));
+        m_activeUnit = unit;
+    }
+    else
+    {
+        m_avoidedCount++;
+    }
+
+    glCheck(glBindTexture(target, texture));
+    binding.target = target;
+    binding.texture = texture;
+}
+
+void GLStateCache::setEnabled(std::uint32_t capability, bool enabled)
+{
+    std::int32_t idx = -1;
+    switch (capability)
+    {
+    default:
+        //untracked, pass through
+        glCheck(enabled ? glEnable(capability) : glDisable(capability));
+        return;
+    case GL_BLEND:
+        idx = Capability::Blend;
+        break;
+    case GL_DEPTH_TEST:
+        idx = Capability::DepthTest;
+        break;
+    case GL_CULL_FACE:
+        idx = Capability::CullFace;
+        break;
+    }
+
+    const std::uint32_t value = enabled ? 1 : 0;
+    if (m_capabilities[idx] == value)
+    {
+        m_avoidedCount++;
+        return;
+    }
+
+    glCheck(enabled ? glEnable(capability) : glDisable(capability));
+    m_capabilities[idx] = value;
+}
+
+void GLStateCache::setDepthMask(bool enabled)
+{
+    const std::uint32_t value = enabled ? GL_TRUE : GL_FALSE;
+    if (m_depthMask == value)
+    {
+        m_avoidedCount++;
+        return;
+    }
+
+    glCheck(glDepthMask(static_cast<GLboolean>(value)));
+    m_depthMask = value;
+}
+
+void GLStateCache::setBlendFunc(std::uint32_t src, std::uint32_t dst)
+{
+    if (m_blendFunc[0] == src
+        && m_blendFunc[1] == dst)
+    {
+        m_avoidedCount++;
+        return;
+    }
+
+    glCheck(glBlendFunc(src, dst));
+    m_blendFunc = { src, dst };
+}
+
+void GLStateCache::setBlendEquation(std::uint32_t equation)
+{
+    if (m_blendEquation == equation)
+    {
+        m_avoidedCount++;
+        return;
+    }
+
+    glCheck(glBlendEquation(equation));
+    m_blendEquation = equation;
+}
+
+void GLStateCache::setFrontFace(std::uint32_t mode)
+{
+    if (m_frontFace == mode)
+    {
+        m_avoidedCount++;
+        return;
+    }
+
+    glCheck(glFrontFace(mode));
+    m_frontFace = mode;
+}
@@ -0,0 +1,113 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+namespace cro::Detail
+{
+    /*!
+    \brief Stable LSD radix sort of a vector of items by a 64 bit key.
+    The key is sorted 8 bits at a time, with all histograms built in a single
+    pass over the data. Any byte which is the same for every item is skipped,
+    so keys which only vary in a few bits are sorted in very few passes.
+    \param items Vector of items to sort in ascending key order
+    \param scratch Vector used as a temporary buffer. This is resized as
+    necessary, so keep it around between calls to prevent reallocations.
+    The capacity of items is never changed.
+    \param getKey Functor which returns the std::uint64_t key of an item
+    */
+    template <typename T, typename KeyFunc>
+    void radixSort(std::vector<T>& items, std::vector<T>& scratch, KeyFunc getKey)
+    {
+        static constexpr std::size_t Radix = 256;
+        static constexpr std::size_t Passes = sizeof(std::uint64_t);
+
+        const auto count = items.size();
+        if (count < 2)
+        {
+            return;
+        }
+
+        std::array<std::array<std::size_t, Radix>, Passes> histograms = {};
+        for (const auto& item : items)
+        {
+            const std::uint64_t key = getKey(item);
+            for (auto i = 0u; i < Passes; ++i)
+            {
+                histograms[i][(key >> (i * 8)) & 0xff]++;
+            }
+        }
+
+        scratch.resize(count);
+        auto* src = &items;
+        auto* dst = &scratch;
+
+        for (auto i = 0u; i < Passes; ++i)
+        {
+            auto& histogram = histograms[i];
+            
+            //if every key has the same value for this byte the pass does nothing
+            const auto firstKey = (getKey((*src)[0]) >> (i * 8)) & 0xff;
+            if (histogram[firstKey] == count)
+            {
+                continue;
+            }
+
+            //convert counts to offsets
+            std::size_t offset = 0;
+            for (auto& bucket : histogram)
+            {
+                const auto c = bucket;
+                bucket = offset;
+                offset += c;
+            }
+
+            for (auto& item : *src)
+            {
+                const auto idx = (getKey(item) >> (i * 8)) & 0xff;
+                (*dst)[histogram[idx]++] = std::move(item);
+            }
+            std::swap(src, dst);
+        }
+
+        //move the result back rather than swapping the buffers, so that
+        //sorting several lists with the same scratch buffer doesn't
+        //shuffle capacity between them and cause reallocations
+        if (src != &items)
+        {
+            std::move(scratch.begin(), scratch.end(), items.begin());
+        }
+    }
+}
@@ -0,0 +1,224 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "StreamBuffer.hpp"
+#include "GLCheck.hpp"
+
+#include <crogine/core/Log.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(PLATFORM_DESKTOP) && !defined(GL41)
+#define PERSISTENT_MAPPING
+#endif
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    //time in nanoseconds to wait on a fence before trying again
+    constexpr GLuint64 FenceTimeout = 1000000;
+}
+
+StreamBuffer::StreamBuffer(std::size_t frameSize)
+    : m_handle      (0),
+    m_frameSize     (0),
+    m_frameIndex    (0),
+    m_writePosition (0),
+    m_mappedData    (nullptr)
+{
+    CRO_ASSERT(frameSize > 0, "");
+    create(frameSize);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    destroy();
+}
+
+//public
+void StreamBuffer::beginFrame(std::size_t requiredSize)
+{
+#ifdef PERSISTENT_MAPPING
+    if (m_mappedData)
+    {
+        //mark the end of the commands which read the region we just used
+        if (m_fences[m_frameIndex])
+        {
+            glCheck(glDeleteSync(static_cast<GLsync>(m_fences[m_frameIndex])));
+        }
+        GLsync fence = nullptr;
+        glCheck(fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        m_fences[m_frameIndex] = fence;
+    }
+#endif
+
+    if (requiredSize > m_frameSize)
+    {
+        //grow by at least half again so we're not recreating this every frame
+        destroy();
+        create(std::max(requiredSize, m_frameSize + (m_frameSize / 2)));
+        return;
+    }
+
+    m_frameIndex = (m_frameIndex + 1) % FrameCount;
+    m_writePosition = getRegionStart();
+
+#ifdef PERSISTENT_MAPPING
+    if (m_mappedData)
+    {
+        //this will only block if the GPU is more than FrameCount - 1 frames behind
+        if (m_fences[m_frameIndex])
+        {
+            auto fence = static_cast<GLsync>(m_fences[m_frameIndex]);
+            GLenum result = GL_TIMEOUT_EXPIRED;
+            while (result == GL_TIMEOUT_EXPIRED)
+            {
+                glCheck(result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeout));
+            }
+
+            if (result == GL_WAIT_FAILED)
+            {
+                LogE << "Failed waiting on stream buffer fence" << std::endl;
+            }
+
+            glCheck(glDeleteSync(fence));
+            m_fences[m_frameIndex] = nullptr;
+        }
+        return;
+    }
+#endif
+
+    //orphan the existing storage so the driver can hand us a new
+    //block rather than waiting for pending draw calls to finish
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_handle));
+    glCheck(glBufferData(GL_ARRAY_BUFFER, m_frameSize, nullptr, GL_STREAM_DRAW));
+}
+
+std::size_t StreamBuffer::write(const void* data, std::size_t size, std::size_t alignment)
+{
+    CRO_ASSERT(alignment > 0, "");
+
+    const auto offset = ((m_writePosition + alignment - 1) / alignment) * alignment;
+    if (offset + size > getRegionStart() + m_frameSize)
+    {
+        return NoSpace;
+    }
+
+    if (m_mappedData)
+    {
+        std::memcpy(m_mappedData + offset, data, size);
+    }
+    else
+    {
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_handle));
+        glCheck(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
+    }
+
+    m_writePosition = offset + size;
+    return offset;
+}
+
+//private
+void StreamBuffer::create(std::size_t frameSize)
+{
+    m_frameSize = frameSize;
+    m_frameIndex = 0;
+    m_writePosition = 0;
+
+    glCheck(glGenBuffers(1, &m_handle));
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_handle));
+
+#ifdef PERSISTENT_MAPPING
+    if (GLAD_GL_VERSION_4_4)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        const auto bufferSize = m_frameSize * FrameCount;
+
+        glCheck(glBufferStorage(GL_ARRAY_BUFFER, bufferSize, nullptr, flags));
+
+        void* data = nullptr;
+        glCheck(data = glMapBufferRange(GL_ARRAY_BUFFER, 0, bufferSize, flags));
+        m_mappedData = static_cast<std::uint8_t*>(data);
+
+        if (m_mappedData)
+        {
+            glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+            return;
+        }
+
+        //buffer storage is immutable so start again
+        LogW << "Failed mapping stream buffer, falling back to orphaning" << std::endl;
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        glCheck(glDeleteBuffers(1, &m_handle));
+        glCheck(glGenBuffers(1, &m_handle));
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_handle));
+    }
+#endif
+
+    glCheck(glBufferData(GL_ARRAY_BUFFER, m_frameSize, nullptr, GL_STREAM_DRAW));
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+}
+
+void StreamBuffer::destroy()
+{
+#ifdef PERSISTENT_MAPPING
+    for (auto& fence : m_fences)
+    {
+        if (fence)
+        {
+            glCheck(glDeleteSync(static_cast<GLsync>(fence)));
+            fence = nullptr;
+        }
+    }
+
+    if (m_mappedData)
+    {
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_handle));
+        glCheck(glUnmapBuffer(GL_ARRAY_BUFFER));
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        m_mappedData = nullptr;
+    }
+#endif
+
+    if (m_handle)
+    {
+        glCheck(glDeleteBuffers(1, &m_handle));
+        m_handle = 0;
+    }
+}
+
+std::size_t StreamBuffer::getRegionStart() const
+{
+    //orphaned buffers only have a single region
+    return m_mappedData ? m_frameIndex * m_frameSize : 0;
+}
@@ -0,0 +1,126 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace cro
+{
+    namespace Detail
+    {
+        /*!
+        \brief Ring buffer used to stream dynamic vertex data to the GPU.
+
+        Rather than each object owning a VBO which is re-uploaded every
+        frame, producers of dynamic geometry write their vertex data into
+        the current frame's region of a single StreamBuffer, and draw from
+        the offset returned by write().
+
+        On GL 4.4 and higher the buffer is mapped persistently and split
+        into FrameCount regions, each of which is guarded by a fence so
+        that a region is never written while the GPU may still be reading
+        it. On GL 4.1 and GLES the buffer is orphaned at the start of each
+        frame and the data is uploaded with glBufferSubData()
+        */
+        class StreamBuffer final
+        {
+        public:
+            /*!
+            \brief Constructor.
+            \param frameSize The initial size in bytes of a single frame's data.
+            This grows as needed when beginFrame() is called.
+            */
+            explicit StreamBuffer(std::size_t frameSize);
+            ~StreamBuffer();
+
+            StreamBuffer(const StreamBuffer&) = delete;
+            StreamBuffer(StreamBuffer&&) = delete;
+            StreamBuffer& operator = (const StreamBuffer&) = delete;
+            StreamBuffer& operator = (StreamBuffer&&) = delete;
+
+            /*!
+            \brief Moves on to the next region of the buffer.
+            This should be called before any data is written each frame, after
+            everything drawing from the previous frame's data has been submitted.
+            Producers which can't know how much data they'll write in a frame
+            may instead call this only once write() returns NoSpace, which
+            moves on to the next region part way through the frame.
+            \param requiredSize The total number of bytes which will be
+            written this frame, including any alignment padding. If this is
+            larger than the current frame size the buffer is recreated, in
+            which case getHandle() will return a new value.
+            */
+            void beginFrame(std::size_t requiredSize);
+
+            /*!
+            \brief Copies the given data into the current frame's region.
+            \param data Pointer to the data to copy
+            \param size Size of the data in bytes
+            \param alignment The returned offset will be a multiple of this,
+            for example the vertex stride so the offset can be converted to a
+            vertex index
+            \returns Offset in bytes from the start of the buffer at which the
+            data was written, or NoSpace if there's not enough room left in the
+            frame's region
+            */
+            std::size_t write(const void* data, std::size_t size, std::size_t alignment = 4);
+
+            /*!
+            \brief Returns the handle of the underlying GL_ARRAY_BUFFER
+            */
+            std::uint32_t getHandle() const { return m_handle; }
+
+            /*!
+            \brief Returns true if the buffer is persistently mapped
+            */
+            bool isPersistent() const { return m_mappedData != nullptr; }
+
+            static constexpr std::size_t NoSpace = static_cast<std::size_t>(-1);
+            static constexpr std::size_t FrameCount = 3;
+
+        private:
+            std::uint32_t m_handle;
+            std::size_t m_frameSize;
+            std::size_t m_frameIndex;
+            std::size_t m_writePosition; //< relative to the start of the buffer
+            std::uint8_t* m_mappedData;
+
+            //GLsync is a pointer type - we store them as void* so GL
+            //headers aren't needed here
+            std::array<void*, FrameCount> m_fences = {};
+
+            void create(std::size_t frameSize);
+            void destroy();
+            std::size_t getRegionStart() const;
+        };
+    }
+}
@@ -38,10 +38,10 @@ void Detail::Text::addQuad(std::vector<Vertex2D>& vertices, glm::vec2 position,
 {
     //this might sound counter intuitive - but we're
     //making the characters top to bottom
-    float left = glyph.bounds.left;
-    float bottom = glyph.bounds.bottom;
-    float right = glyph.bounds.left + glyph.bounds.width;
-    float top = glyph.bounds.bottom + glyph.bounds.height;
+    float left = glyph.bounds.left - glyph.padding;
+    float bottom = glyph.bounds.bottom - glyph.padding;
+    float right = glyph.bounds.left + glyph.bounds.width + glyph.padding;
+    float top = glyph.bounds.bottom + glyph.bounds.height + glyph.padding;
 
     float u1 = static_cast<float>(glyph.textureBounds.left) / textureSize.x;
     float v1 = static_cast<float>(glyph.textureBounds.bottom) / textureSize.y;
@@ -59,68 +59,64 @@ void Detail::Text::addQuad(std::vector<Vertex2D>& vertices, glm::vec2 position,
 
 FloatRect Detail::Text::updateVertices(std::vector<Vertex2D>& dst, TextContext& context)
 {
-    std::vector<Vertex2D> outlineVerts;
-    std::vector<Vertex2D> shadowVerts;
-    std::vector<Vertex2D> characterVerts;
-
-    std::size_t rowStart = 0; //index of first vert in current row
-    const auto realign = [&](float diff)
-    {
-        for (auto i = rowStart; i < characterVerts.size(); ++i)
-        {
-            characterVerts[i].position.x -= diff;
+    Layout layout;
+    return updateVertices(dst, context, layout, true);
+}
 
-            if (context.outlineThickness != 0)
-            {
-                outlineVerts[i].position.x -= diff;
-            }
+FloatRect Detail::Text::updateVertices(std::vector<Vertex2D>& dst, TextContext& context, Layout& layout, bool rebuild)
+{
+    const auto& string = context.string;
 
-            if (glm::length2(context.shadowOffset) != 0)
-            {
-                shadowVerts[i].position.x -= diff;
-            }
-        }
-    };
-    const auto eol = [&]()
+    //find the first character which changed - kerning only depends
+    //on the previous character so everything before it can be kept
+    std::size_t start = 0;
+    if (!rebuild
+        && !layout.pens.empty())
     {
-        if (rowStart == characterVerts.size())
+        const auto count = std::min(string.size(), layout.string.size());
+        while (start < count && string[start] == layout.string[start])
         {
-            //newline was at the end of the string
-            //so do nothing
-            return;
+            start++;
         }
+    }
+    else
+    {
+        layout.pens.resize(1);
+        layout.pens[0] = {};
+    }
 
-        if (context.alignment == std::int32_t(cro::Text::Alignment::Centre))
-        {
-            float diff = std::floor((characterVerts.back().position.x - characterVerts[rowStart].position.x) / 2.f);
-            realign(diff);
-        }
-        else if (context.alignment == std::int32_t(cro::Text::Alignment::Right))
-        {
-            float diff = std::floor(characterVerts.back().position.x - characterVerts[rowStart].position.x);
-            realign(diff);
-        }
-    };
+    auto pen = layout.pens[start];
+    layout.pens.resize(start);
+    layout.outlineVerts.resize(pen.outlineCount);
+    layout.shadowVerts.resize(pen.shadowCount);
+    layout.characterVerts.resize(pen.characterCount);
+    layout.string = string;
+
+    //distance field fonts are outlined by the shader
+    const float outlineThickness = context.font->isDistanceField() ? 0.f : context.outlineThickness;
 
     const auto& texture = context.font->getTexture(context.charSize);
-    float xOffset = static_cast<float>(context.font->getGlyph(L' ', context.charSize, context.bold, context.outlineThickness).advance);
+    float xOffset = static_cast<float>(context.font->getGlyph(L' ', context.charSize, context.bold, outlineThickness).advance);
     float yOffset = static_cast<float>(context.font->getLineHeight(context.charSize));
-    float x = 0.f;
-    float y = 0.f;// static_cast<float>(m_charSize);
 
-    float minX = x;
-    float minY = y;
-    float maxX = 0.f;
-    float maxY = 0.f;
+    auto& x = pen.position.x;
+    auto& y = pen.position.y;
+    auto& minX = pen.min.x;
+    auto& minY = pen.min.y;
+    auto& maxX = pen.max.x;
+    auto& maxY = pen.max.y;
 
-    std::uint32_t prevChar = 0;
-    const auto& string = context.string;
-    for (auto i = 0u; i < string.size(); ++i)
+    for (auto i = start; i < string.size(); ++i)
     {
+        pen.outlineCount = static_cast<std::uint32_t>(layout.outlineVerts.size());
+        pen.shadowCount = static_cast<std::uint32_t>(layout.shadowVerts.size());
+        pen.characterCount = static_cast<std::uint32_t>(layout.characterVerts.size());
+        layout.pens.push_back(pen);
+
         std::uint32_t currChar = string[i];
 
-        x += context.font->getKerning(prevChar, currChar, context.charSize);
-        prevChar = currChar;
+        x += context.font->getKerning(pen.prevChar, currChar, context.charSize);
+        pen.prevChar = currChar;
 
         //whitespace chars
         //might seem wasteful to render an empty glyph for spaces - 
@@ -142,10 +138,6 @@ FloatRect Detail::Text::updateVertices(std::vector<Vertex2D>& dst, TextContext&
             case '\n':
                 y -= yOffset + context.verticalSpacing;
                 x = 0.f;
-
-                eol();
-
-                rowStart = characterVerts.size();
                 break;
             }
 
@@ -158,7 +150,7 @@ FloatRect Detail::Text::updateVertices(std::vector<Vertex2D>& dst, TextContext&
         //create the quads.
         auto addOutline = [&]()
         {
-            const auto& glyph = context.font->getGlyph(currChar, context.charSize, context.bold, context.outlineThickness);
+            const auto& glyph = context.font->getGlyph(currChar, context.charSize, context.bold, outlineThickness);
 
             //TODO mental jiggery to figure out why these cause an alignment
             //offset - although it's not important, it just means the localBounds
@@ -169,7 +161,7 @@ FloatRect Detail::Text::updateVertices(std::vector<Vertex2D>& dst, TextContext&
             float bottom = glyph.bounds.bottom;*/
 
             //add the outline glyph to the vertices
-            Detail::Text::addQuad(outlineVerts, glm::vec2(x, y), context.outlineColour, glyph, texture.getSize(), context.outlineThickness);
+            Detail::Text::addQuad(layout.outlineVerts, glm::vec2(x, y), context.outlineColour, glyph, texture.getSize(), outlineThickness);
 
             /*minX = std::min(minX, x + left - m_outlineThickness);
             maxX = std::max(maxX, x + right + m_outlineThickness);
@@ -180,16 +172,16 @@ FloatRect Detail::Text::updateVertices(std::vector<Vertex2D>& dst, TextContext&
         const auto& glyph = context.font->getGlyph(currChar, context.charSize, context.bold, 0.f);
 
         //if outline is larger, add first
-        if (context.outlineThickness != 0)
+        if (outlineThickness != 0)
         {
             addOutline();
         }
         else if (glm::length2(context.shadowOffset) != 0)
         {
             //add a shadow if only no outline
-            Detail::Text::addQuad(shadowVerts, glm::vec2(x, y) + context.shadowOffset, context.shadowColour, glyph, texture.getSize());
+            Detail::Text::addQuad(layout.shadowVerts, glm::vec2(x, y) + context.shadowOffset, context.shadowColour, glyph, texture.getSize());
         }
-        Detail::Text::addQuad(characterVerts, glm::vec2(x, y), glyph.useFillColour ? context.fillColour : cro::Colour(1.f,1.f,1.f, context.fillColour.getAlpha()), glyph, texture.getSize());
+        Detail::Text::addQuad(layout.characterVerts, glm::vec2(x, y), glyph.useFillColour ? context.fillColour : cro::Colour(1.f,1.f,1.f, context.fillColour.getAlpha()), glyph, texture.getSize());
 
         //only do this if not outlined
         //if (context.outlineThickness == 0)
@@ -207,18 +199,68 @@ FloatRect Detail::Text::updateVertices(std::vector<Vertex2D>& dst, TextContext&
 
         x += glyph.advance;
     }
-    //update alignment if there is no newline at the end
-    if (rowStart != characterVerts.size())
-    {
-        eol();
-    }
+    pen.outlineCount = static_cast<std::uint32_t>(layout.outlineVerts.size());
+    pen.shadowCount = static_cast<std::uint32_t>(layout.shadowVerts.size());
+    pen.characterCount = static_cast<std::uint32_t>(layout.characterVerts.size());
+    layout.pens.push_back(pen);
 
 
     //ensures the outline/shadow is always drawn first
-    outlineVerts.insert(outlineVerts.end(), shadowVerts.begin(), shadowVerts.end());
-    outlineVerts.insert(outlineVerts.end(), characterVerts.begin(), characterVerts.end());
-    dst.swap(outlineVerts);
+    dst.clear();
+    dst.reserve(layout.outlineVerts.size() + layout.shadowVerts.size() + layout.characterVerts.size());
+    dst.insert(dst.end(), layout.outlineVerts.begin(), layout.outlineVerts.end());
+    dst.insert(dst.end(), layout.shadowVerts.begin(), layout.shadowVerts.end());
+    dst.insert(dst.end(), layout.characterVerts.begin(), layout.characterVerts.end());
+
+    //align each row. Outlines and shadows have a quad
+    //for every character quad, if they exist at all
+    if (context.alignment != std::int32_t(cro::Text::Alignment::Left))
+    {
+        const auto characterOffset = layout.outlineVerts.size() + layout.shadowVerts.size();
+        const auto& verts = layout.characterVerts;
+
+        const auto realign = [&](std::size_t rowStart, std::size_t rowEnd)
+        {
+            if (rowStart == rowEnd)
+            {
+                //newline was at the end of the string
+                //so do nothing
+                return;
+            }
+
+            float diff = std::floor(verts[rowEnd - 1].position.x - verts[rowStart].position.x);
+            if (context.alignment == std::int32_t(cro::Text::Alignment::Centre))
+            {
+                diff = std::floor((verts[rowEnd - 1].position.x - verts[rowStart].position.x) / 2.f);
+            }
+
+            for (auto i = rowStart; i < rowEnd; ++i)
+            {
+                dst[characterOffset + i].position.x -= diff;
 
+                if (!layout.outlineVerts.empty())
+                {
+                    dst[i].position.x -= diff;
+                }
+
+                if (!layout.shadowVerts.empty())
+                {
+                    dst[layout.outlineVerts.size() + i].position.x -= diff;
+                }
+            }
+        };
+
+        std::size_t rowStart = 0;
+        for (auto i = 0u; i < string.size(); ++i)
+        {
+            if (string[i] == '\n')
+            {
+                realign(rowStart, layout.pens[i].characterCount);
+                rowStart = layout.pens[i + 1].characterCount;
+            }
+        }
+        realign(rowStart, verts.size());
+    }
 
 
     FloatRect localBounds;
@@ -240,4 +282,4 @@ FloatRect Detail::Text::updateVertices(std::vector<Vertex2D>& dst, TextContext&
     localBounds.left -= offset;
 
     return localBounds;
-}
\ No newline at end of file
+}
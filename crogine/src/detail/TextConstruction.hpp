@@ -35,7 +35,41 @@ source distribution.
 
 namespace cro::Detail::Text
 {
+    //state of the layout before a character is added
+    struct Pen final
+    {
+        glm::vec2 position = glm::vec2(0.f);
+        glm::vec2 min = glm::vec2(0.f);
+        glm::vec2 max = glm::vec2(0.f);
+        std::uint32_t prevChar = 0;
+
+        std::uint32_t characterCount = 0;
+        std::uint32_t outlineCount = 0;
+        std::uint32_t shadowCount = 0;
+    };
+
+    //the result of laying out a string, kept so that it can be
+    //resumed from the first character which changes, rather than
+    //rebuilding the entire string. Vertices are stored unaligned
+    //and alignment is applied when they are copied to the output.
+    struct Layout final
+    {
+        String string;
+        std::vector<Pen> pens; //one for each character, plus the final state
+        std::vector<Vertex2D> outlineVerts;
+        std::vector<Vertex2D> shadowVerts;
+        std::vector<Vertex2D> characterVerts;
+    };
+
     void addQuad(std::vector<Vertex2D>& vertices, glm::vec2 position, Colour colour, const Glyph& glyph, glm::vec2 textureSize, float outlineThickness = 0.f);
 
     FloatRect updateVertices(std::vector<Vertex2D>& dst, TextContext& ctx);
+
+    /*
+    Updates the given layout with the context string and writes the result to dst.
+    Unless rebuild is true only the characters following the common prefix of the
+    context and layout strings are updated, so the layout must have been created
+    with the same font, size and style as the context.
+    */
+    FloatRect updateVertices(std::vector<Vertex2D>& dst, TextContext& ctx, Layout& layout, bool rebuild);
 }
\ No newline at end of file
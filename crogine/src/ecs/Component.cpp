@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2020
+Matt Marchant 2017 - 2024
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -30,10 +30,27 @@ source distribution.
 #include <crogine/ecs/Component.hpp>
 #include <crogine/ecs/Entity.hpp>
 
+#include <atomic>
+
 using namespace cro;
 
+std::uint32_t Detail::nextTypeIndex()
+{
+    static std::atomic<std::uint32_t> counter = 0;
+    return counter++;
+}
+
+ComponentManager::ComponentManager()
+{
+    for (auto& id : m_lookup)
+    {
+        id.store(InvalidID, std::memory_order_relaxed);
+    }
+}
+
 ComponentManager::ID ComponentManager::getFromTypeID(std::type_index id)
 {
+    std::scoped_lock lock(m_mutex);
     auto result = std::find(std::begin(m_IDs), std::end(m_IDs), id);
     if (result == m_IDs.end())
     {
@@ -42,4 +59,16 @@ ComponentManager::ID ComponentManager::getFromTypeID(std::type_index id)
         return static_cast<ID>(m_IDs.size() - 1);
     }
     return static_cast<ID>(std::distance(m_IDs.begin(), result));
+}
+
+//private
+ComponentManager::ID ComponentManager::cacheID(std::uint32_t idx, std::type_index id)
+{
+    //if two threads get here at once they both store the same value
+    const auto result = getFromTypeID(id);
+    if (idx < m_lookup.size())
+    {
+        m_lookup[idx].store(result, std::memory_order_release);
+    }
+    return result;
 }
\ No newline at end of file
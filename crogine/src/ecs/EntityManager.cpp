@@ -68,6 +68,7 @@ Entity EntityManager::createEntity()
             m_componentMasks.resize(m_componentMasks.size() + MinComponentMasks);
             m_labels.resize(m_componentMasks.size());
             m_destructionFlags.resize(m_componentMasks.size());
+            m_modifiedFlags.resize(m_componentMasks.size());
         }
     }
 
@@ -77,6 +78,11 @@ Entity EntityManager::createEntity()
 
     m_destructionFlags[idx] = false;
 
+    //new entities always need routing to systems, even if
+    //a previous entity at this index is already in the list
+    m_modifiedFlags[idx] = true;
+    m_modifiedEntities.push_back(e);
+
     m_entityCount++;
 
     return e;
@@ -99,8 +105,9 @@ void EntityManager::destroyEntity(Entity entity)
 
         m_entityCount--;
 
-        //forcefully reset components which might
-        //otherwise orphan moveable only types
+        //remove the components from their pools - this
+        //also resets stable types which might otherwise
+        //orphan moveable only types
         for (auto& pool : m_componentPools)
         {
             if (pool)
@@ -167,6 +174,43 @@ const std::string& EntityManager::getLabel(Entity entity) const
     return m_labels[idx];
 }
 
+const std::vector<Entity>& EntityManager::fetchModifiedEntities()
+{
+    m_modifiedBuffer.clear();
+    for (auto entity : m_modifiedEntities)
+    {
+        m_modifiedFlags[entity.getIndex()] = false;
+
+        //skips stale handles to entities destroyed since being modified
+        if (entityValid(entity))
+        {
+            m_modifiedBuffer.push_back(entity);
+        }
+    }
+    m_modifiedEntities.clear();
+
+    m_removedBuffer.swap(m_removedComponents);
+    m_removedComponents.clear();
+
+    return m_modifiedBuffer;
+}
+
+void EntityManager::flushRemovedComponents()
+{
+    for (const auto& [entity, componentID] : m_removedBuffer)
+    {
+        //the component may have been added again since it was removed
+        const auto index = entity.getIndex();
+        if (entityValid(entity)
+            && !m_componentMasks[index].test(componentID)
+            && m_componentPools[componentID])
+        {
+            m_componentPools[componentID]->reset(index);
+        }
+    }
+    m_removedBuffer.clear();
+}
+
 void EntityManager::markDestroyed(Entity entity)
 {
     const auto id = entity.getIndex();
@@ -174,4 +218,15 @@ void EntityManager::markDestroyed(Entity entity)
     CRO_ASSERT(id < m_destructionFlags.size(), "Generation index out of range");
 
     m_destructionFlags[id] = true;
-}
\ No newline at end of file
+}
+
+//private
+void EntityManager::markModified(Entity entity)
+{
+    const auto index = entity.getIndex();
+    if (!m_modifiedFlags[index])
+    {
+        m_modifiedFlags[index] = true;
+        m_modifiedEntities.push_back(entity);
+    }
+}
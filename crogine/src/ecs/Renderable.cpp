@@ -28,11 +28,21 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include <crogine/ecs/Renderable.hpp>
+#include <crogine/ecs/Entity.hpp>
 #include <crogine/core/App.hpp>
 #include "../detail/GLCheck.hpp"
 
 using namespace cro;
 
+//public
+void Renderable::updateDrawLists(const std::vector<Entity>& cameras)
+{
+    for (auto camera : cameras)
+    {
+        updateDrawList(camera);
+    }
+}
+
 //protected
 IntRect Renderable::applyViewport(FloatRect vp, const RenderTarget& rt)
 {
@@ -28,6 +28,8 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include "../detail/GLCheck.hpp"
+#include "TransformPass.hpp"
+#include "VisibilityPass.hpp"
 
 #include <crogine/ecs/Scene.hpp>
 #include <crogine/ecs/components/Camera.hpp>
@@ -193,6 +195,8 @@ Scene::Scene(MessageBus& mb, std::size_t initialPoolSize, std::uint32_t infoFlag
     m_uid                   (++uid),
     m_entityManager         (mb, m_componentManager, initialPoolSize),
     m_systemManager         (*this, m_componentManager, infoFlags),
+    m_transformPass         (std::make_unique<Detail::TransformPass>()),
+    m_visibilityPass        (std::make_unique<Detail::VisibilityPass>(*this)),
     m_projectionMapCount    (0),
     m_waterLevel            (0.f),
     m_activeSkyboxTexture   (0),
@@ -237,11 +241,10 @@ void Scene::simulate(float dt)
         d->process(dt);
     }
 
-    for (const auto& entity : m_pendingEntities)
-    {
-        m_systemManager.addToSystems(entity);
-    }
-    m_pendingEntities.clear();
+    //new entities and those which have had components added or
+    //removed are moved to the systems matching their component mask
+    m_systemManager.updateSystems(m_entityManager.fetchModifiedEntities());
+    m_entityManager.flushRemovedComponents();
 
     /*
     Destroyed ents are double buffered so any calls
@@ -249,9 +252,9 @@ void Scene::simulate(float dt)
     don't affect the entity vector mid iteration
     */
     m_destroyedEntities.swap(m_destroyedBuffer);
+    m_systemManager.removeFromSystems(m_destroyedEntities);
     for (const auto& entity : m_destroyedEntities)
     {
-        m_systemManager.removeFromSystems(entity);
         m_entityManager.destroyEntity(entity);
     }
     m_destroyedEntities.clear();
@@ -261,12 +264,15 @@ void Scene::simulate(float dt)
     {
         p->process(dt);
     }
+
+    //update any transforms modified this frame in a single
+    //pass, so they don't have to be calculated on demand
+    updateTransforms();
 }
 
 Entity Scene::createEntity()
 {
-    m_pendingEntities.push_back(m_entityManager.createEntity());
-    return m_pendingEntities.back();
+    return m_entityManager.createEntity();
 }
 
 void Scene::destroyEntity(Entity entity)
@@ -580,18 +586,70 @@ void Scene::updateDrawLists(Entity camera)
     CRO_ASSERT(camera.hasComponent<Camera>(), "Camera component missing!");
     CRO_ASSERT(m_entityManager.owns(camera), "This entity must belong to this scene!");
 
+    //models may have moved since the last update, eg between
+    //cameras drawn to different targets, so recalculate bounds
+    m_visibilityPass->invalidate();
+
     for (auto r : m_renderables)
     {
         r->updateDrawList(camera);
     }
 }
 
+void Scene::updateDrawLists(const std::vector<Entity>& cameras)
+{
+    if (cameras.empty())
+    {
+        return;
+    }
+
+#ifdef CRO_DEBUG_
+    for (auto camera : cameras)
+    {
+        CRO_ASSERT(camera.hasComponent<Camera>(), "Camera component missing!");
+        CRO_ASSERT(m_entityManager.owns(camera), "This entity must belong to this scene!");
+    }
+#endif
+
+    //make sure nothing is lazily updated once the renderables are
+    //reading world transforms and model bounds from multiple threads
+    updateTransforms();
+    m_visibilityPass->invalidate();
+    m_visibilityPass->prepare(cameras);
+
+    auto& jobSystem = App::getJobSystem();
+    JobSystem::Counter counter;
+    for (auto r : m_renderables)
+    {
+        if (r->hasConcurrentDrawLists())
+        {
+            jobSystem.schedule([r, &cameras]() { r->updateDrawLists(cameras); }, &counter);
+        }
+    }
+
+    //the rest are updated on this thread in the meantime
+    for (auto r : m_renderables)
+    {
+        if (!r->hasConcurrentDrawLists())
+        {
+            r->updateDrawLists(cameras);
+        }
+    }
+
+    jobSystem.wait(counter);
+}
+
 void Scene::setSkyboxOrientation(glm::quat q)
 {
     m_skybox.modelMatrix = glm::mat4(q);
 }
 
 //private
+void Scene::updateTransforms()
+{
+    m_transformPass->update(m_entityManager.getPool<Transform>());
+}
+
 void Scene::applySkyboxColours()
 {
     const auto& [dark, mid, light] = m_skybox.colours;
@@ -28,16 +28,30 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include <crogine/ecs/System.hpp>
+#include <crogine/ecs/Scene.hpp>
+#include <crogine/core/App.hpp>
 #include <crogine/core/Clock.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 using namespace cro;
 
+namespace
+{
+    //enough batches that workers which finish early
+    //can steal work from any which are still busy
+    constexpr std::size_t BatchesPerThread = 4;
+}
+
 System::System(MessageBus& mb, UniqueType t)
     : m_messageBus  (mb),
     m_type          (t),
     m_scene         (nullptr),
     m_updateIndex   (0),
-    m_active        (false)
+    m_active            (false),
+    m_concurrent        (false),
+    m_inConcurrentStage (false)
 {}
 
 //public
@@ -53,22 +67,45 @@ const std::vector<Entity>& System::getEntities() const
 
 void System::addEntity(Entity entity)
 {
+    const auto index = entity.getIndex();
+    if (index >= m_entitySlots.size())
+    {
+        m_entitySlots.resize(std::min(static_cast<std::size_t>(Detail::MinFreeIDs), static_cast<std::size_t>(index) + 128), NullSlot);
+    }
+
+    m_entitySlots[index] = static_cast<std::uint32_t>(m_entities.size());
     m_entities.push_back(entity);
     onEntityAdded(entity);
+
+    //onEntityAdded() may have rejected the entity
+    //by removing it from the list again
+    if (m_entitySlots[index] >= m_entities.size()
+        || m_entities[m_entitySlots[index]] != entity)
+    {
+        m_entitySlots[index] = NullSlot;
+    }
 }
 
 void System::removeEntity(Entity entity)
 {
-    m_entities.erase(std::remove_if(std::begin(m_entities), std::end(m_entities),
-        [&entity, this](const Entity& e)
+    const auto slot = getSlot(entity);
+    if (slot != NullSlot)
     {
-        if (entity == e)
+        m_entitySlots[entity.getIndex()] = NullSlot;
+        if (slot != m_entities.size() - 1)
         {
-            onEntityRemoved(e);
-            return true;
+            m_entities[slot] = m_entities.back();
+            m_entitySlots[m_entities[slot].getIndex()] = slot;
         }
-        return false;
-    }), std::end(m_entities));
+        m_entities.pop_back();
+
+        onEntityRemoved(entity);
+    }
+}
+
+bool System::hasEntity(Entity entity) const
+{
+    return getSlot(entity) != NullSlot;
 }
 
 const ComponentMask& System::getComponentMask() const
@@ -78,9 +115,105 @@ const ComponentMask& System::getComponentMask() const
 
 void System::handleMessage(const Message&) {}
 
+bool System::isSubscribed(Message::ID id) const
+{
+    return m_subscriptions.empty()
+        || std::find(m_subscriptions.begin(), m_subscriptions.end(), id) != m_subscriptions.end();
+}
+
 void System::process(float) {}
 
 //protected
+void System::parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t, std::size_t)>& func, std::size_t minBatchSize)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    const auto batchCount = getBatchCount(count, minBatchSize);
+    if (batchCount == 1)
+    {
+        func(0, 0, count);
+        return;
+    }
+
+    //world transforms are updated lazily when read, so make sure they're
+    //up to date. The SystemManager has already done this if we're in a stage
+    //which is processed concurrently.
+    if (!m_inConcurrentStage
+        && m_scene)
+    {
+        m_scene->updateTransforms();
+    }
+
+    //so batches calling hasEntity() only read the slots
+    updateEntitySlots();
+
+    if (m_batchMessages.size() < batchCount)
+    {
+        m_batchMessages.resize(batchCount);
+    }
+
+    const auto processBatch = [&](std::size_t batch)
+    {
+        const auto begin = (count * batch) / batchCount;
+        const auto end = (count * (batch + 1)) / batchCount;
+
+        //this thread may be processing another batch when it starts this one
+        auto& messages = getBatchMessageBuffer();
+        auto* previous = messages;
+        messages = &m_batchMessages[batch];
+        func(batch, begin, end);
+        messages = previous;
+    };
+
+    //the first batch is processed on this thread while we wait
+    auto& jobSystem = App::getJobSystem();
+    JobSystem::Counter counter;
+    for (auto i = 1u; i < batchCount; ++i)
+    {
+        jobSystem.schedule([&processBatch, i]() { processBatch(i); }, &counter);
+    }
+    processBatch(0);
+    jobSystem.wait(counter);
+
+    //forward any messages in the order they would have been posted by a single loop
+    for (auto i = 0u; i < batchCount; ++i)
+    {
+        for (const auto& msg : m_batchMessages[i])
+        {
+            std::memcpy(m_messageBus.allocate(msg.id, msg.size), msg.data.data(), msg.size);
+        }
+        m_batchMessages[i].clear();
+    }
+}
+
+std::size_t System::getBatchCount(std::size_t count, std::size_t minBatchSize) const
+{
+    if (!App::isValid())
+    {
+        return 1;
+    }
+
+    const auto workerCount = App::getJobSystem().getWorkerCount();
+    if (workerCount == 0)
+    {
+        return 1;
+    }
+
+    const auto maxBatches = (workerCount + 1) * BatchesPerThread;
+    return std::clamp(count / std::max(std::size_t(1), minBatchSize), std::size_t(1), maxBatches);
+}
+
+void System::subscribe(Message::ID id)
+{
+    if (std::find(m_subscriptions.begin(), m_subscriptions.end(), id) == m_subscriptions.end())
+    {
+        m_subscriptions.push_back(id);
+    }
+}
+
 void System::setScene(Scene& scene)
 {
     m_scene = &scene;
@@ -92,7 +225,61 @@ Scene* System::getScene()
     return m_scene;
 }
 
+void System::updateEntitySlots() const
+{
+    for (auto i = 0u; i < m_entities.size(); ++i)
+    {
+        const auto index = m_entities[i].getIndex();
+        if (index >= m_entitySlots.size()
+            || m_entitySlots[index] != i)
+        {
+            rebuildSlots();
+            return;
+        }
+    }
+
+    //entities removed from the list may still have a slot
+    const auto slotCount = std::count_if(m_entitySlots.begin(), m_entitySlots.end(), [](std::uint32_t s) { return s != NullSlot; });
+    if (static_cast<std::size_t>(slotCount) != m_entities.size())
+    {
+        rebuildSlots();
+    }
+}
+
 //private
+std::uint32_t System::getSlot(Entity entity) const
+{
+    const auto index = entity.getIndex();
+    if (index >= m_entitySlots.size()
+        || m_entitySlots[index] == NullSlot)
+    {
+        return NullSlot;
+    }
+
+    //the entity list is available via getEntities() so
+    //may have been modified without updating the slots
+    if (m_entitySlots[index] >= m_entities.size()
+        || !(m_entities[m_entitySlots[index]] == entity))
+    {
+        rebuildSlots();
+    }
+    return m_entitySlots[index];
+}
+
+void System::rebuildSlots() const
+{
+    std::fill(m_entitySlots.begin(), m_entitySlots.end(), NullSlot);
+    for (auto i = 0u; i < m_entities.size(); ++i)
+    {
+        const auto index = m_entities[i].getIndex();
+        if (index >= m_entitySlots.size())
+        {
+            m_entitySlots.resize(index + 1, NullSlot);
+        }
+        m_entitySlots[index] = i;
+    }
+}
+
 void System::processTypes(ComponentManager& cm)
 {
     for (const auto& componentType : m_pendingTypes)
@@ -100,4 +287,28 @@ void System::processTypes(ComponentManager& cm)
         m_componentMask.set(cm.getFromTypeID(componentType));
     }
     m_pendingTypes.clear();
+
+    for (const auto& componentType : m_pendingReadTypes)
+    {
+        m_readMask.set(cm.getFromTypeID(componentType));
+    }
+    m_pendingReadTypes.clear();
+
+    for (const auto& componentType : m_pendingWriteTypes)
+    {
+        m_writeMask.set(cm.getFromTypeID(componentType));
+    }
+    m_pendingWriteTypes.clear();
+
+    //required components are at least read
+    if (m_concurrent)
+    {
+        m_readMask |= m_componentMask;
+    }
+}
+
+System::MessageBuffer*& System::getBatchMessageBuffer()
+{
+    thread_local MessageBuffer* buffer = nullptr;
+    return buffer;
 }
\ No newline at end of file
@@ -27,13 +27,16 @@ source distribution.
 
 -----------------------------------------------------------------------*/
 
+#include <crogine/core/App.hpp>
 #include <crogine/core/Clock.hpp>
 #include <crogine/core/SysTime.hpp>
 #include <crogine/ecs/InfoFlags.hpp>
 #include <crogine/ecs/Scene.hpp>
 #include <crogine/ecs/System.hpp>
+#include <crogine/ecs/components/Transform.hpp>
 #include <crogine/gui/Gui.hpp>
 
+#include <algorithm>
 #include <sstream>
 
 using namespace cro;
@@ -47,7 +50,10 @@ SystemManager::SystemManager(Scene& scene, ComponentManager& cm, std::uint32_t i
     : m_scene                   (scene),
     m_componentManager          (cm),
     m_infoFlags                 (infoFlags),
-    m_systemUpdateAccumulator   (0.f)
+    m_systemUpdateAccumulator   (0.f),
+    m_scheduleDirty             (true),
+    m_jobSystem                 (nullptr),
+    m_recipientsDirty           (false)
 {
     //TODO refactor this into a single window with panes for each flag
     if (infoFlags & INFO_FLAG_SYSTEMS_ACTIVE)
@@ -141,9 +147,78 @@ void SystemManager::removeFromSystems(Entity entity)
     }
 }
 
-void SystemManager::forwardMessage(const Message& msg)
+void SystemManager::addToSystems(const std::vector<Entity>& entities)
 {
     for (auto& sys : m_systems)
+    {
+        const auto& sysMask = sys->getComponentMask();
+        for (auto entity : entities)
+        {
+            if ((entity.getComponentMask() & sysMask) == sysMask)
+            {
+                sys->addEntity(entity);
+            }
+        }
+    }
+}
+
+void SystemManager::removeFromSystems(const std::vector<Entity>& entities)
+{
+    for (auto& sys : m_systems)
+    {
+        for (auto entity : entities)
+        {
+            sys->removeEntity(entity);
+        }
+    }
+}
+
+void SystemManager::updateSystems(const std::vector<Entity>& entities)
+{
+    for (auto& sys : m_systems)
+    {
+        const auto& sysMask = sys->getComponentMask();
+        for (auto entity : entities)
+        {
+            const bool matches = (entity.getComponentMask() & sysMask) == sysMask;
+            if (matches != sys->hasEntity(entity))
+            {
+                if (matches)
+                {
+                    sys->addEntity(entity);
+                }
+                else
+                {
+                    sys->removeEntity(entity);
+                }
+            }
+        }
+    }
+}
+
+void SystemManager::forwardMessage(const Message& msg)
+{
+    if (m_recipientsDirty)
+    {
+        m_messageRecipients.clear();
+        m_recipientsDirty = false;
+    }
+
+    auto result = m_messageRecipients.find(msg.id);
+    if (result == m_messageRecipients.end())
+    {
+        std::vector<System*> recipients;
+        for (auto& sys : m_systems)
+        {
+            if (sys->isSubscribed(msg.id))
+            {
+                recipients.push_back(sys.get());
+            }
+        }
+        result = m_messageRecipients.emplace(msg.id, std::move(recipients)).first;
+    }
+
+    for (auto* sys : result->second)
     {
         sys->handleMessage(msg);
     }
@@ -151,6 +226,8 @@ void SystemManager::forwardMessage(const Message& msg)
 
 void SystemManager::process(float dt)
 {
+    bool sample = false;
+
     //hmm I wish this could be conditionally compiled...
     if (m_infoFlags)
     {        
@@ -160,26 +237,146 @@ void SystemManager::process(float dt)
         {
             m_systemUpdateAccumulator -= SystemTimeUpdateRate;
             m_systemSamples.clear();
-        
-            for (auto& system : m_activeSystems)
+            sample = true;
+        }
+    }
+
+    if (m_scheduleDirty)
+    {
+        buildSchedule();
+    }
+
+    if (!m_jobSystem)
+    {
+        for (auto& system : m_activeSystems)
+        {
+            system->process(dt);
+            if (sample)
             {
-                system->process(dt);
                 m_systemSamples.emplace_back(system, m_systemTimer.restart() * 1000.f);
             }
         }
-        else
+        return;
+    }
+
+    //world transforms are updated lazily when read, so make sure
+    //they're up to date before any stage which reads them concurrently
+    const auto transformID = m_componentManager.getID<Transform>();
+    bool transformsDirty = true;
+
+    for (const auto& stage : m_schedule)
+    {
+        if (stage.size() > 1
+            && transformsDirty)
         {
-            for (auto& system : m_activeSystems)
+            m_scene.updateTransforms();
+            transformsDirty = false;
+        }
+
+        processStage(stage, dt, sample);
+
+        for (const auto* system : stage)
+        {
+            if (!system->isConcurrent()
+                || system->m_writeMask.test(transformID))
             {
-                system->process(dt);
+                transformsDirty = true;
             }
         }
     }
-    else
+}
+
+//private
+void SystemManager::buildSchedule()
+{
+    const auto conflicts = [](const System* a, const System* b)
     {
-        for (auto& system : m_activeSystems)
+        return !a->isConcurrent() || !b->isConcurrent()
+            || (a->m_writeMask & (b->m_readMask | b->m_writeMask)).any()
+            || (b->m_writeMask & a->m_readMask).any();
+    };
+
+    //each system is placed in the stage after the last
+    //stage containing a system it conflicts with, so
+    //conflicting systems are still processed in order
+    std::vector<std::size_t> stages(m_activeSystems.size());
+    std::size_t stageCount = 0;
+    for (auto i = 0u; i < m_activeSystems.size(); ++i)
+    {
+        std::size_t stage = 0;
+        for (auto j = 0u; j < i; ++j)
         {
-            system->process(dt);
+            if (conflicts(m_activeSystems[i], m_activeSystems[j]))
+            {
+                stage = std::max(stage, stages[j] + 1);
+            }
+        }
+        stages[i] = stage;
+        stageCount = std::max(stageCount, stage + 1);
+    }
+
+    m_schedule.clear();
+    m_schedule.resize(stageCount);
+    for (auto i = 0u; i < m_activeSystems.size(); ++i)
+    {
+        m_schedule[stages[i]].push_back(m_activeSystems[i]);
+    }
+
+    //only use the schedule if it has something to run concurrently
+    const bool concurrent = std::any_of(m_schedule.begin(), m_schedule.end(), 
+        [](const std::vector<System*>& stage)
+        {
+            return stage.size() > 1;
+        });
+
+    m_jobSystem = nullptr;
+    if (concurrent
+        && App::isValid()
+        && App::getJobSystem().getWorkerCount() != 0)
+    {
+        m_jobSystem = &App::getJobSystem();
+    }
+
+    m_scheduleDirty = false;
+}
+
+void SystemManager::processStage(const std::vector<System*>& stage, float dt, bool sample)
+{
+    if (stage.size() == 1)
+    {
+        stage[0]->process(dt);
+        if (sample)
+        {
+            m_systemSamples.emplace_back(stage[0], m_systemTimer.restart() * 1000.f);
+        }
+        return;
+    }
+
+    m_taskTimes.resize(stage.size());
+    const auto processSystem = [&](std::size_t i)
+    {
+        HiResTimer timer;
+        stage[i]->m_inConcurrentStage = true;
+        stage[i]->process(dt);
+        stage[i]->m_inConcurrentStage = false;
+        m_taskTimes[i] = timer.restart() * 1000.f;
+    };
+
+    //the first system is processed on this thread while we wait
+    JobSystem::Counter counter;
+    for (auto i = 1u; i < stage.size(); ++i)
+    {
+        m_jobSystem->schedule([&processSystem, i]() { processSystem(i); }, &counter);
+    }
+    processSystem(0);
+    m_jobSystem->wait(counter);
+
+    if (sample)
+    {
+        for (auto i = 0u; i < stage.size(); ++i)
+        {
+            m_systemSamples.emplace_back(stage[i], m_taskTimes[i]);
         }
     }
+    m_systemTimer.restart();
 }
\ No newline at end of file
@@ -0,0 +1,236 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "TransformPass.hpp"
+
+#include <crogine/ecs/components/Transform.hpp>
+#include <crogine/ecs/ComponentPool.hpp>
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CRO_TX_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CRO_TX_NEON
+#endif
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    //this mirrors glm_mat4_mul() from glm/simd/matrix.h - we can't include
+    //that directly without GLM_FORCE_INTRINSICS, which changes the alignment
+    //of glm types for this translation unit only.
+    void multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& out)
+    {
+#if defined(CRO_TX_SSE2)
+        const __m128 a0 = _mm_loadu_ps(&a[0][0]);
+        const __m128 a1 = _mm_loadu_ps(&a[1][0]);
+        const __m128 a2 = _mm_loadu_ps(&a[2][0]);
+        const __m128 a3 = _mm_loadu_ps(&a[3][0]);
+
+        for (auto i = 0; i < 4; ++i)
+        {
+            const __m128 b0 = _mm_set1_ps(b[i][0]);
+            const __m128 b1 = _mm_set1_ps(b[i][1]);
+            const __m128 b2 = _mm_set1_ps(b[i][2]);
+            const __m128 b3 = _mm_set1_ps(b[i][3]);
+
+            const __m128 r0 = _mm_add_ps(_mm_mul_ps(a0, b0), _mm_mul_ps(a1, b1));
+            const __m128 r1 = _mm_add_ps(_mm_mul_ps(a2, b2), _mm_mul_ps(a3, b3));
+            _mm_storeu_ps(&out[i][0], _mm_add_ps(r0, r1));
+        }
+#elif defined(CRO_TX_NEON)
+        const float32x4_t a0 = vld1q_f32(&a[0][0]);
+        const float32x4_t a1 = vld1q_f32(&a[1][0]);
+        const float32x4_t a2 = vld1q_f32(&a[2][0]);
+        const float32x4_t a3 = vld1q_f32(&a[3][0]);
+
+        for (auto i = 0; i < 4; ++i)
+        {
+            float32x4_t r = vmulq_n_f32(a0, b[i][0]);
+            r = vmlaq_n_f32(r, a1, b[i][1]);
+            r = vmlaq_n_f32(r, a2, b[i][2]);
+            r = vmlaq_n_f32(r, a3, b[i][3]);
+            vst1q_f32(&out[i][0], r);
+        }
+#else
+        out = a * b;
+#endif
+    }
+}
+
+void TransformPass::update(ComponentPool<Transform>& pool)
+{
+    gather(pool);
+    composeLocal();
+    composeWorld();
+}
+
+//private
+void TransformPass::gather(ComponentPool<Transform>& pool)
+{
+    m_unsorted.clear();
+    m_transforms.clear();
+
+    std::size_t maxDepth = 0;
+    for (auto i = 0u; i < pool.size(); ++i)
+    {
+        auto& tx = pool.at(i);
+        if (tx.m_dirtyFlags & Transform::World)
+        {
+            m_unsorted.push_back(&tx);
+            maxDepth = std::max(maxDepth, tx.m_depth);
+        }
+    }
+
+    //counting sort by depth, so parents are always
+    //updated before any of their children
+    m_depthCounts.assign(maxDepth + 2, 0);
+    for (const auto* tx : m_unsorted)
+    {
+        m_depthCounts[tx->m_depth + 1]++;
+    }
+
+    for (auto i = 1u; i < m_depthCounts.size(); ++i)
+    {
+        m_depthCounts[i] += m_depthCounts[i - 1];
+    }
+
+    m_transforms.resize(m_unsorted.size());
+    for (auto* tx : m_unsorted)
+    {
+        m_transforms[m_depthCounts[tx->m_depth]++] = tx;
+    }
+}
+
+void TransformPass::composeLocal()
+{
+    m_localIndices.clear();
+    m_positions.clear();
+    m_rotations.clear();
+    m_scales.clear();
+    m_origins.clear();
+
+    for (auto i = 0u; i < m_transforms.size(); ++i)
+    {
+        const auto* tx = m_transforms[i];
+        if (tx->m_dirtyFlags & Transform::Tx)
+        {
+            m_localIndices.push_back(i);
+            m_positions.push_back(tx->m_position);
+            m_rotations.push_back(tx->m_rotation);
+            m_scales.push_back(tx->m_scale);
+            m_origins.push_back(tx->m_origin);
+        }
+    }
+
+    //equivalent to translate(position) * toMat4(rotation) * scale(scale) * translate(-origin)
+    const auto count = m_localIndices.size();
+    m_localMatrices.resize(count);
+    for (auto i = 0u; i < count; ++i)
+    {
+        const auto& q = m_rotations[i];
+        const float xx = q.x * q.x;
+        const float yy = q.y * q.y;
+        const float zz = q.z * q.z;
+        const float xy = q.x * q.y;
+        const float xz = q.x * q.z;
+        const float yz = q.y * q.z;
+        const float wx = q.w * q.x;
+        const float wy = q.w * q.y;
+        const float wz = q.w * q.z;
+
+        const auto& s = m_scales[i];
+        const glm::vec3 c0 = glm::vec3(1.f - 2.f * (yy + zz), 2.f * (xy + wz), 2.f * (xz - wy)) * s.x;
+        const glm::vec3 c1 = glm::vec3(2.f * (xy - wz), 1.f - 2.f * (xx + zz), 2.f * (yz + wx)) * s.y;
+        const glm::vec3 c2 = glm::vec3(2.f * (xz + wy), 2.f * (yz - wx), 1.f - 2.f * (xx + yy)) * s.z;
+
+        const auto& o = m_origins[i];
+        const glm::vec3 c3 = m_positions[i] - (c0 * o.x) - (c1 * o.y) - (c2 * o.z);
+
+        auto& m = m_localMatrices[i];
+        m[0] = glm::vec4(c0, 0.f);
+        m[1] = glm::vec4(c1, 0.f);
+        m[2] = glm::vec4(c2, 0.f);
+        m[3] = glm::vec4(c3, 1.f);
+    }
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        auto* tx = m_transforms[m_localIndices[i]];
+        tx->m_transform = m_localMatrices[i];
+        tx->m_dirtyFlags &= ~Transform::Tx;
+        tx->doCallbacks();
+    }
+}
+
+void TransformPass::composeWorld()
+{
+    glm::mat4 local = glm::mat4(1.f);
+    for (auto* tx : m_transforms)
+    {
+        //callbacks may have already caused this to be updated, or
+        //modified the local transform since it was composed
+        if ((tx->m_dirtyFlags & Transform::World) == 0)
+        {
+            continue;
+        }
+
+        if (tx->m_dirtyFlags & Transform::Tx)
+        {
+            tx->getLocalTransform();
+        }
+        multiply(tx->m_attachmentTransform, tx->m_transform, local);
+
+        if (const auto* parent = tx->m_parent; parent)
+        {
+            //parents are updated first, but may belong to
+            //another scene in which case update them lazily
+            if (parent->m_dirtyFlags & Transform::World)
+            {
+                parent->updateWorldTransform();
+            }
+
+            multiply(parent->m_worldTransform, local, tx->m_worldTransform);
+            tx->m_worldRotation = parent->m_worldRotation * tx->m_rotation;
+            tx->m_worldScale = parent->m_worldScale * tx->m_scale;
+        }
+        else
+        {
+            tx->m_worldTransform = local;
+            tx->m_worldRotation = tx->m_rotation;
+            tx->m_worldScale = tx->m_scale;
+        }
+        tx->m_dirtyFlags &= ~Transform::World;
+    }
+}
@@ -0,0 +1,89 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/detail/glm/vec3.hpp>
+#include <crogine/detail/glm/mat4x4.hpp>
+#include <crogine/detail/glm/gtc/quaternion.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace cro
+{
+    class Transform;
+    namespace Detail
+    {
+        template <class T>
+        class ComponentPool;
+
+        /*!
+        \brief Updates the world transforms of all dirty Transform components
+        in a Scene in a single pass, once per frame.
+
+        Dirty transforms are gathered and sorted by their depth in the scene
+        graph so that parents are always updated before their children, and
+        each world matrix only requires a single matrix multiplication. Local
+        transform properties are copied into structure-of-arrays buffers so
+        that local matrices can be composed in tight, vectorisable loops, and
+        world matrices are concatenated with SIMD where it is available.
+
+        The results are written back to each Transform's cached world values
+        so renderers reading getWorldTransform() afterwards do no further work.
+        */
+        class TransformPass final
+        {
+        public:
+            void update(ComponentPool<Transform>&);
+
+            /*!
+            \brief Number of transforms updated by the last call to update()
+            */
+            std::size_t getUpdateCount() const { return m_transforms.size(); }
+
+        private:
+            std::vector<Transform*> m_transforms; //< dirty transforms sorted by depth
+            std::vector<Transform*> m_unsorted;
+            std::vector<std::uint32_t> m_depthCounts;
+
+            //SoA local properties for transforms with a dirty local matrix
+            std::vector<std::uint32_t> m_localIndices;
+            std::vector<glm::vec3> m_positions;
+            std::vector<glm::quat> m_rotations;
+            std::vector<glm::vec3> m_scales;
+            std::vector<glm::vec3> m_origins;
+            std::vector<glm::mat4> m_localMatrices;
+
+            void gather(ComponentPool<Transform>&);
+            void composeLocal();
+            void composeWorld();
+        };
+    }
+}
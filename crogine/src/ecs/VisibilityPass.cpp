@@ -0,0 +1,212 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "VisibilityPass.hpp"
+
+#include <crogine/ecs/Scene.hpp>
+#include <crogine/ecs/components/Camera.hpp>
+#include <crogine/ecs/components/Model.hpp>
+#include <crogine/ecs/components/Transform.hpp>
+#include <crogine/util/Frustum.hpp>
+
+#include <algorithm>
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    //for some reason the tighter fitting Spheres cause incorrect culling
+    //so this is a hack to mitigate it somewhat
+    constexpr float SpherePadding = 1.2f;
+}
+
+VisibilityPass::VisibilityPass(Scene& scene)
+    : m_scene       (scene),
+    m_frameID       (1),
+    m_boundsDirty   (true)
+{
+
+}
+
+//public
+void VisibilityPass::invalidate()
+{
+    m_frameID++;
+    m_boundsDirty = true;
+}
+
+void VisibilityPass::prepare(const std::vector<Entity>& cameras)
+{
+    updateBounds();
+
+    std::size_t listCount = 0;
+    for (auto camera : cameras)
+    {
+        listCount = std::max(listCount, camera.getComponent<Camera>().getDrawListIndex() + 1);
+    }
+
+    if (m_cameraVisibility.size() < listCount)
+    {
+        m_cameraVisibility.resize(listCount);
+    }
+
+    for (auto camera : cameras)
+    {
+        const auto& cam = camera.getComponent<Camera>();
+        cull(cam, Camera::Pass::Final);
+
+        if (cam.reflectionBuffer.available())
+        {
+            cull(cam, Camera::Pass::Reflection);
+        }
+    }
+}
+
+const std::vector<Entity>& VisibilityPass::getEntities()
+{
+    std::scoped_lock lock(m_mutex);
+    updateBounds();
+    return m_entities;
+}
+
+const std::vector<Sphere>& VisibilityPass::getSpheres()
+{
+    std::scoped_lock lock(m_mutex);
+    updateBounds();
+    return m_spheres;
+}
+
+const std::vector<std::uint32_t>& VisibilityPass::getVisible(const Camera& camera, std::int32_t passIndex)
+{
+    CRO_ASSERT(passIndex >= 0 && passIndex < 2, "Invalid pass index");
+
+    std::scoped_lock lock(m_mutex);
+    updateBounds();
+
+    if (m_cameraVisibility.size() <= camera.getDrawListIndex())
+    {
+        m_cameraVisibility.resize(camera.getDrawListIndex() + 1);
+    }
+    return cull(camera, passIndex);
+}
+
+//private
+const std::vector<std::uint32_t>& VisibilityPass::cull(const Camera& camera, std::int32_t passIndex)
+{
+    const auto listIndex = camera.getDrawListIndex();
+
+    //the camera may have been updated more than once this frame, in
+    //which case the results already returned for its previous frustum
+    //may still be in use, so are left untouched
+    const auto& frustum = camera.getPass(passIndex).getFrustum();
+    auto& results = m_cameraVisibility[listIndex][passIndex];
+    auto result = std::find_if(results.begin(), results.end(),
+        [&](const PassVisibility& v)
+        {
+            return v.frameID == m_frameID && v.frustum == frustum;
+        });
+
+    if (result != results.end())
+    {
+        return result->indices;
+    }
+
+    //reuse results from a previous frame if possible
+    result = std::find_if(results.begin(), results.end(),
+        [&](const PassVisibility& v)
+        {
+            return v.frameID != m_frameID;
+        });
+    auto& visibility = result == results.end() ? results.emplace_back() : *result;
+    visibility.frameID = m_frameID;
+    visibility.frustum = frustum;
+
+    visibility.mask.resize((m_spheres.size() + 31) / 32);
+    Util::Frustum::visible(frustum, m_spheres.data(), m_spheres.size(), visibility.mask.data());
+
+    visibility.indices.clear();
+    for (auto i = 0u; i < visibility.mask.size(); ++i)
+    {
+        const auto bits = visibility.mask[i];
+        if (bits == 0)
+        {
+            continue;
+        }
+
+        for (auto j = 0u; j < 32; ++j)
+        {
+            if (bits & (1u << j))
+            {
+                visibility.indices.push_back((i * 32) + j);
+            }
+        }
+    }
+
+    return visibility.indices;
+}
+
+void VisibilityPass::updateBounds()
+{
+    if (!m_boundsDirty)
+    {
+        return;
+    }
+    m_boundsDirty = false;
+
+    m_entities.clear();
+    m_spheres.clear();
+
+    auto& models = m_scene.getComponentPool<Model>();
+    auto& transforms = m_scene.getComponentPool<Transform>();
+
+    for (auto i = 0u; i < models.size(); ++i)
+    {
+        const auto entityIndex = models.getEntityIndex(i);
+        if (!transforms.contains(entityIndex))
+        {
+            continue;
+        }
+
+        auto& model = models.at(i);
+        if (model.m_meshBox != model.m_meshData.boundingBox)
+        {
+            model.updateBounds();
+        }
+
+        const auto& tx = transforms[entityIndex];
+        auto& sphere = m_spheres.emplace_back(model.getBoundingSphere());
+
+        sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre, 1.f));
+        const auto scale = tx.getWorldScale();
+        sphere.radius *= ((scale.x + scale.y + scale.z) / 3.f) * SpherePadding;
+
+        m_entities.push_back(m_scene.getEntity(entityIndex));
+    }
+}
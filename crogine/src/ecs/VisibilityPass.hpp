@@ -0,0 +1,132 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/ecs/Entity.hpp>
+#include <crogine/graphics/Spatial.hpp>
+
+#include <vector>
+#include <array>
+#include <deque>
+#include <mutex>
+#include <cstdint>
+
+namespace cro
+{
+    class Camera;
+    class Scene;
+    namespace Detail
+    {
+        /*!
+        \brief Calculates the world space bounds of every Model in a Scene
+        once per frame, and culls them against the passes of each Camera.
+
+        Renderers which need to know which Models are visible to a Camera
+        share the results of getVisible(), rather than each transforming
+        the bounds of every Model and culling them independently. Bounds
+        are updated the first time they're requested after invalidate()
+        and the results for each Camera frustum are cached until the next
+        call to invalidate(). Results which have been returned are never
+        modified before then, culling a different frustum for the same
+        Camera pass stores its results separately.
+        */
+        class VisibilityPass final
+        {
+        public:
+            explicit VisibilityPass(Scene&);
+
+            /*!
+            \brief Marks the bounds and any cached results out of date.
+            Called by the Scene each time it updates its draw lists, so
+            models moved since the last update are culled correctly. Any
+            references returned before this is called become invalid.
+            */
+            void invalidate();
+
+            /*!
+            \brief Updates the bounds and culls them against the given cameras.
+            This must be called before getVisible() is used from more than one
+            thread at a time, after which the results for these cameras are
+            read without modifying them. Results for other cameras or frusta
+            may still be requested from any thread, as they're stored without
+            modifying those already returned.
+            */
+            void prepare(const std::vector<Entity>& cameras);
+
+            /*!
+            \brief Returns the entities of every Model which has a Transform,
+            in the same order as their bounds returned from getSpheres()
+            */
+            const std::vector<Entity>& getEntities();
+
+            /*!
+            \brief Returns the world space bounding sphere of each Model.
+            These are slightly enlarged compared to the Model's bounds, as
+            the bounding sphere of a mesh doesn't always fit it tightly.
+            */
+            const std::vector<Sphere>& getSpheres();
+
+            /*!
+            \brief Returns the indices into getEntities() of the Models which
+            are at least partially inside the frustum of the given Camera pass.
+            Renderers should check for themselves that the entities belong to
+            them, and that the Model isn't hidden. The returned list remains
+            unchanged until the next call to invalidate().
+            */
+            const std::vector<std::uint32_t>& getVisible(const Camera&, std::int32_t passIndex);
+
+        private:
+            Scene& m_scene;
+            std::uint32_t m_frameID;
+            bool m_boundsDirty;
+            std::mutex m_mutex;
+
+            std::vector<Entity> m_entities;
+            std::vector<Sphere> m_spheres;
+
+            struct PassVisibility final
+            {
+                std::uint32_t frameID = 0;
+                Frustum frustum = {};
+                std::vector<std::uint32_t> mask;
+                std::vector<std::uint32_t> indices;
+            };
+            //each pass keeps one result per frustum culled since the last
+            //invalidate(). These are deques so that neither culling a new
+            //frustum nor adding a new draw list, eg from a renderable on the
+            //main thread while the Scene's jobs are reading the results,
+            //moves any results which have already been returned.
+            std::deque<std::array<std::deque<PassVisibility>, 2u>> m_cameraVisibility; //< indexed by camera draw list
+
+            void updateBounds();
+            const std::vector<std::uint32_t>& cull(const Camera&, std::int32_t passIndex);
+        };
+    }
+}
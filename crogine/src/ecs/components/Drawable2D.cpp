@@ -31,6 +31,7 @@ source distribution.
 #include <crogine/ecs/components/Drawable2D.hpp>
 #include <crogine/graphics/Texture.hpp>
 
+#include <algorithm>
 #include <limits>
 
 using namespace cro;
@@ -48,6 +49,7 @@ Drawable2D::Drawable2D()
     m_primitiveType         (GL_TRIANGLE_STRIP),
     m_vbo                   (0),
     m_vao                   (0),
+    m_vboSize               (0),
     m_updateBufferData      (false),
     m_renderFlags           (DefaultRenderFlag),
     m_croppingArea          (std::numeric_limits<float>::lowest() / 2.f, std::numeric_limits<float>::lowest() / 2.f,
@@ -282,6 +284,33 @@ Drawable2D::Facing Drawable2D::getFacing() const
 }
 
 //private
+void Drawable2D::unbindUniform(const std::string& name)
+{
+    if (!m_shader
+        || m_shader->getUniformMap().count(name) == 0)
+    {
+        return;
+    }
+
+    const auto uniform = m_shader->getUniformMap().at(name);
+    const auto unbind = [uniform](auto& bindings)
+    {
+        bindings.erase(std::remove_if(bindings.begin(), bindings.end(),
+            [uniform](const auto& pair)
+            {
+                return pair.first == uniform;
+            }), bindings.end());
+    };
+
+    unbind(m_textureIDBindings);
+    unbind(m_floatBindings);
+    unbind(m_vec2Bindings);
+    unbind(m_vec3Bindings);
+    unbind(m_vec4Bindings);
+    unbind(m_boolBindings);
+    unbind(m_matBindings);
+}
+
 void Drawable2D::applyShader()
 {
     if (m_shader)
@@ -34,7 +34,6 @@ source distribution.
 #include <crogine/detail/glm/gtc/matrix_inverse.hpp>
 
 #include <algorithm>
-#include <cstring>
 
 using namespace cro;
 
@@ -239,9 +238,9 @@ void Model::setMaterial(std::size_t idx, Material::Data data)
     {
         //remove any existing animations
         m_animations.erase(std::remove_if(m_animations.begin(), m_animations.end(),
-            [idx](const std::pair<std::size_t, Material::Property*>& a)
+            [idx](std::size_t a)
             {
-                return a.first == idx;
+                return a == idx;
             }), m_animations.end());
 
         //the order in which this happens is important!
@@ -414,13 +413,13 @@ void Model::initMaterialAnimation(std::size_t index)
     if (material.animation.active
         && material.properties.count("u_subrect") != 0)
     {
-        m_animations.emplace_back(std::make_pair(index, &material.properties.at("u_subrect").second));
+        m_animations.push_back(index);
     }
 }
 
 void Model::updateMaterialAnimations(float dt)
 {
-    for (auto [index, prop] : m_animations)
+    for (auto index : m_animations)
     {
         auto& material = m_materials[Mesh::IndexData::Final][index];
         material.animation.currentTime += dt;
@@ -435,12 +434,13 @@ void Model::updateMaterialAnimations(float dt)
                 material.animation.frame.x = std::fmod(material.animation.frame.x + material.animation.frame.z, 1.f);
             }
 
-            std::memcpy(prop->vecValue, &material.animation.frame, sizeof(glm::vec4));
+            //this also updates the compiled properties
+            material.setProperty("u_subrect", material.animation.frame);
         }
     }
 }
 
-void Model::bindMaterial(Material::Data& material)
+void Model::bindMaterial(Material::Data& material) const
 {
     //map attributes to material
     std::size_t pointerOffset = 0;
@@ -479,6 +479,9 @@ void Model::bindMaterial(Material::Data& material)
     {
         material.attribCount++;
     }
+
+    //the properties may have been modified directly
+    material.compile();
 }
 
 void Model::updateBounds()
@@ -34,11 +34,18 @@ source distribution.
 
 using namespace cro;
 
+namespace
+{
+    std::uint64_t randomSeed()
+    {
+        return (static_cast<std::uint64_t>(Util::Random::rndEngine()) << 32) | Util::Random::rndEngine();
+    }
+}
+
 ParticleEmitter::ParticleEmitter()
-    : m_vbo                 (0),
-    m_vao                   (0),
-    m_particles             (MaxParticles),
+    : m_firstVertex         (0),
     m_nextFreeParticle      (0),
+    m_randomGenerator       (randomSeed()),
     m_running               (false),
     m_emissionTime          (0.f),
     m_previousPosition      (0.f),
@@ -49,7 +56,7 @@ ParticleEmitter::ParticleEmitter()
     m_renderFlags           (std::numeric_limits<std::uint64_t>::max()),
     m_releaseCount          (-1)
 {
-
+    m_particles.resize(MaxParticles);
 }
 
 //void ParticleEmitter::applySettings(const EmitterSettings& es)
@@ -62,6 +69,9 @@ ParticleEmitter::ParticleEmitter()
 
 void ParticleEmitter::start()
 {
+    //reseed so copied emitters don't share a spawn pattern
+    m_randomGenerator.seed(randomSeed());
+
     m_running = true;
     m_emissionTimestamp = m_prevTimestamp;
     m_emissionTime = 0.f;
@@ -78,6 +88,42 @@ void ParticleEmitter::stop()
     m_releaseCount = -1;
 }
 
+void Detail::ParticleData::resize(std::size_t count)
+{
+    positionX.resize(count);
+    positionY.resize(count);
+    positionZ.resize(count);
+    velocityX.resize(count);
+    velocityY.resize(count);
+    velocityZ.resize(count);
+    lifetime.resize(count);
+    inverseMaxLifetime.resize(count, 1.f);
+    rotation.resize(count);
+    scale.resize(count, 1.f);
+    frameTime.resize(count);
+    frameID.resize(count);
+    loopCount.resize(count);
+    colour.resize(count);
+}
+
+void Detail::ParticleData::copy(std::size_t src, std::size_t dst)
+{
+    positionX[dst] = positionX[src];
+    positionY[dst] = positionY[src];
+    positionZ[dst] = positionZ[src];
+    velocityX[dst] = velocityX[src];
+    velocityY[dst] = velocityY[src];
+    velocityZ[dst] = velocityZ[src];
+    lifetime[dst] = lifetime[src];
+    inverseMaxLifetime[dst] = inverseMaxLifetime[src];
+    rotation[dst] = rotation[src];
+    scale[dst] = scale[src];
+    frameTime[dst] = frameTime[src];
+    frameID[dst] = frameID[src];
+    loopCount[dst] = loopCount[src];
+    colour[dst] = colour[src];
+}
+
 bool EmitterSettings::loadFromFile(const std::string& path, cro::TextureResource& textures)
 {
     ConfigFile cfg;
@@ -286,7 +286,7 @@ void Attachment::setModel(cro::Entity model)
         m_model.isValid() &&
         m_model.hasComponent<cro::Transform>())
     {
-        m_model.getComponent<cro::Transform>().m_attachmentTransform = glm::mat4(1.f);
+        m_model.getComponent<cro::Transform>().setAttachmentTransform(glm::mat4(1.f));
     }
 
     m_model = model;
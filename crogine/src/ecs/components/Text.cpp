@@ -60,7 +60,8 @@ Text::Text(const Text& other)
 }
 
 Text::Text(Text&& other) noexcept
-    : m_dirtyFlags(DirtyFlags::All)
+    : m_dirtyFlags  (DirtyFlags::All),
+    m_layout        (std::move(other.m_layout))
 {
     m_context = other.m_context;
     if (m_context.font)
@@ -114,6 +115,7 @@ Text& Text::operator=(Text&& other) noexcept
 
     m_dirtyFlags = DirtyFlags::All;
     m_context = other.m_context;
+    m_layout = std::move(other.m_layout);
 
     if (m_context.font)
     {
@@ -163,7 +165,7 @@ void Text::setString(const String& str)
     if (m_context.string != str)
     {
         m_context.string = str;
-        m_dirtyFlags |= DirtyFlags::All;
+        m_dirtyFlags |= DirtyFlags::String;
 
         /*if (!m_context.font->isRegistered(this))
         {
@@ -334,7 +336,9 @@ void Text::setAlignment(Text::Alignment alignment)
     if (m_context.alignment != std::int32_t(alignment))
     {
         m_context.alignment = std::int32_t(alignment);
-        m_dirtyFlags |= DirtyFlags::All;
+
+        //alignment is applied to the existing layout
+        m_dirtyFlags |= DirtyFlags::String;
     }
 }
 
@@ -352,9 +356,15 @@ void Text::updateVertices(Drawable2D& drawable)
         return;
     }
     
+    if (!m_layout)
+    {
+        m_layout = std::make_unique<Detail::Text::Layout>();
+    }
+
     //update glyphs
     auto& vertices = drawable.getVertexData();
-    localBounds = Detail::Text::updateVertices(vertices, m_context);
+    const bool rebuild = (m_dirtyFlags & ~DirtyFlags::String) != 0;
+    localBounds = Detail::Text::updateVertices(vertices, m_context, *m_layout, rebuild);
 
     auto maxY = localBounds.bottom + localBounds.height;
 
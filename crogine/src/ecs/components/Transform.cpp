@@ -50,9 +50,12 @@ Transform::Transform()
     m_scale                 (1.f, 1.f, 1.f),
     m_rotation              (1.f, 0.f, 0.f, 0.f),
     m_transform             (1.f),
+    m_worldTransform        (1.f),
+    m_worldRotation         (1.f, 0.f, 0.f, 0.f),
+    m_worldScale            (1.f, 1.f, 1.f),
     m_parent                (nullptr),
     m_depth                 (0),
-    m_dirtyFlags            (Flags::Tx),
+    m_dirtyFlags            (Flags::Tx | Flags::World),
     m_attachmentTransform   (1.f)
 {
 
@@ -64,9 +67,12 @@ Transform::Transform(Transform&& other) noexcept
     m_scale                 (1.f, 1.f, 1.f),
     m_rotation              (1.f, 0.f, 0.f, 0.f),
     m_transform             (1.f),
+    m_worldTransform        (1.f),
+    m_worldRotation         (1.f, 0.f, 0.f, 0.f),
+    m_worldScale            (1.f, 1.f, 1.f),
     m_parent                (nullptr),
     m_depth                 (0),
-    m_dirtyFlags            (Flags::Tx),
+    m_dirtyFlags            (Flags::Tx | Flags::World),
     m_attachmentTransform   (1.f)
 {
     CRO_ASSERT(other.m_parent != this, "Invalid assignment");
@@ -82,6 +88,7 @@ Transform::Transform(Transform&& other) noexcept
             {
                 c->decreaseDepth();
             }
+            c->invalidateWorld();
         }
 
         //and adopt new
@@ -130,8 +137,15 @@ Transform::Transform(Transform&& other) noexcept
         setRotation(other.getRotation());
         setScale(other.getScale());
         setOrigin(other.getOrigin());
-        m_dirtyFlags = Flags::Tx;
         m_attachmentTransform = other.m_attachmentTransform;
+
+        //adopted children won't have been marked if we
+        //were already dirty, so make sure they're updated
+        m_dirtyFlags |= (Tx | World);
+        for (auto c : m_children)
+        {
+            c->invalidateWorld();
+        }
         m_callbacks.swap(other.m_callbacks);
 
         other.reset();
@@ -159,6 +173,7 @@ Transform& Transform::operator=(Transform&& other) noexcept
             {
                 c->decreaseDepth();
             }
+            c->invalidateWorld();
         }
 
         m_parent = other.m_parent;
@@ -204,8 +219,15 @@ Transform& Transform::operator=(Transform&& other) noexcept
         setRotation(other.getRotation());
         setScale(other.getScale());
         setOrigin(other.getOrigin());
-        m_dirtyFlags = Flags::Tx;
         m_attachmentTransform = other.m_attachmentTransform;
+
+        //adopted children won't have been marked if we
+        //were already dirty, so make sure they're updated
+        m_dirtyFlags |= (Tx | World);
+        for (auto c : m_children)
+        {
+            c->invalidateWorld();
+        }
         m_callbacks.swap(other.m_callbacks);
 
         other.reset();
@@ -230,6 +252,7 @@ Transform::~Transform()
         {
             c->decreaseDepth();
         }
+        c->invalidateWorld();
     }
 }
 
@@ -237,7 +260,7 @@ Transform::~Transform()
 void Transform::setOrigin(glm::vec3 o)
 {
     m_origin = o;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::setOrigin(glm::vec2 o)
@@ -248,21 +271,21 @@ void Transform::setOrigin(glm::vec2 o)
 void Transform::setPosition(glm::vec3 position)
 {
     m_position = position;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::setPosition(glm::vec2 position)
 {
     m_position.x = position.x;
     m_position.y = position.t;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::setRotation(glm::vec3 axis, float angle)
 {
     glm::quat q = glm::quat(1.f, 0.f, 0.f, 0.f);
     m_rotation = glm::rotate(q, angle, axis);
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::setRotation(float radians)
@@ -273,19 +296,19 @@ void Transform::setRotation(float radians)
 void Transform::setRotation(glm::quat rotation)
 {
     m_rotation = rotation;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::setRotation(glm::mat4 rotation)
 {
     m_rotation = glm::quat_cast(rotation);
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::setScale(glm::vec3 scale)
 {
     m_scale = scale;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::setScale(glm::vec2 scale)
@@ -296,7 +319,7 @@ void Transform::setScale(glm::vec2 scale)
 void Transform::move(glm::vec3 distance)
 {
     m_position += distance;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::move(glm::vec2 distance)
@@ -307,7 +330,7 @@ void Transform::move(glm::vec2 distance)
 void Transform::rotate(glm::vec3 axis, float rotation)
 {
     m_rotation = glm::rotate(m_rotation, rotation, glm::normalize(axis));
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::rotate(float amount)
@@ -318,18 +341,19 @@ void Transform::rotate(float amount)
 void Transform::rotate(glm::quat rotation)
 {
     m_rotation = rotation * m_rotation;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::rotate(glm::mat4 rotation)
 {
     m_rotation = glm::quat_cast(rotation) * m_rotation;
+    markDirty();
 }
 
 void Transform::scale(glm::vec3 scale)
 {
     m_scale *= scale;
-    m_dirtyFlags |= Tx;
+    markDirty();
 }
 
 void Transform::scale(glm::vec2 amount)
@@ -364,11 +388,11 @@ float Transform::getRotation2D() const
 
 glm::quat Transform::getWorldRotation() const
 {
-    if (m_parent)
+    if (m_dirtyFlags & World)
     {
-        return m_parent->getWorldRotation() * m_rotation;
+        updateWorldTransform();
     }
-    return m_rotation;
+    return m_worldRotation;
 }
 
 glm::vec3 Transform::getScale() const
@@ -378,11 +402,11 @@ glm::vec3 Transform::getScale() const
 
 glm::vec3 Transform::getWorldScale() const
 {
-    if (m_parent)
+    if (m_dirtyFlags & World)
     {
-        return m_parent->getWorldScale() * m_scale;
+        updateWorldTransform();
     }
-    return m_scale;
+    return m_worldScale;
 }
 
 glm::mat4 Transform::getLocalTransform() const
@@ -430,6 +454,7 @@ void Transform::setLocalTransform(glm::mat4 transform)
     }
     //m_dirtyFlags |= Tx;
     m_transform = glm::translate(transform, -m_origin);
+    invalidateWorld();
     m_dirtyFlags &= ~Tx;
 
     doCallbacks();
@@ -437,11 +462,11 @@ void Transform::setLocalTransform(glm::mat4 transform)
 
 glm::mat4 Transform::getWorldTransform() const
 {
-    if (m_parent)
+    if (m_dirtyFlags & World)
     {
-        return m_parent->getWorldTransform() * getLocalTransform();
+        updateWorldTransform();
     }
-    return getLocalTransform();
+    return m_worldTransform;
 }
 
 glm::vec3 Transform::getForwardVector() const
@@ -497,6 +522,7 @@ bool Transform::addChild(Transform& child)
         }
 
         m_children.push_back(&child);
+        child.invalidateWorld();
 
         return true;
     }
@@ -520,6 +546,8 @@ void Transform::removeChild(Transform& tx)
         {
             return ptr == &tx;
         }), m_children.end());
+
+    tx.invalidateWorld();
 }
 
 void Transform::addCallback(std::function<void()> cb)
@@ -535,6 +563,9 @@ void Transform::reset()
     m_scale = glm::vec3(1.f, 1.f, 1.f);
     m_rotation = glm::quat(1.f, 0.f, 0.f, 0.f);
     m_transform = glm::mat4(1.f);
+    m_worldTransform = glm::mat4(1.f);
+    m_worldRotation = glm::quat(1.f, 0.f, 0.f, 0.f);
+    m_worldScale = glm::vec3(1.f, 1.f, 1.f);
     m_parent = nullptr;
     m_dirtyFlags = 0;
     m_depth = 0;
@@ -544,6 +575,51 @@ void Transform::reset()
     m_children.clear();
 }
 
+void Transform::setAttachmentTransform(const glm::mat4& tx)
+{
+    m_attachmentTransform = tx;
+    invalidateWorld();
+}
+
+void Transform::markDirty()
+{
+    m_dirtyFlags |= Tx;
+    invalidateWorld();
+}
+
+void Transform::invalidateWorld()
+{
+    //if we're already dirty then so are all our children
+    //as they are marked when we are, so we can skip them
+    if ((m_dirtyFlags & World) == 0)
+    {
+        m_dirtyFlags |= World;
+        for (auto c : m_children)
+        {
+            c->invalidateWorld();
+        }
+    }
+}
+
+void Transform::updateWorldTransform() const
+{
+    if (m_parent)
+    {
+        //these are cached on the parent, so walking up the
+        //tree only happens if the parent is also dirty
+        m_worldTransform = m_parent->getWorldTransform() * getLocalTransform();
+        m_worldRotation = m_parent->getWorldRotation() * m_rotation;
+        m_worldScale = m_parent->getWorldScale() * m_scale;
+    }
+    else
+    {
+        m_worldTransform = getLocalTransform();
+        m_worldRotation = m_rotation;
+        m_worldScale = m_scale;
+    }
+    m_dirtyFlags &= ~World;
+}
+
 void Transform::doCallbacks() const
 {
     for (auto& c : m_callbacks)
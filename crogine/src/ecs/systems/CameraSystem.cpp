@@ -43,6 +43,8 @@ CameraSystem::CameraSystem(cro::MessageBus& mb)
 {
     requireComponent<Camera>();
     requireComponent<Transform>();
+
+    subscribe(Message::WindowMessage);
 }
 
 //public
@@ -73,6 +75,7 @@ void CameraSystem::handleMessage(const Message& msg)
 void CameraSystem::process(float)
 {
     auto& entities = getEntities();
+    m_activeCameras.clear();
 
     for (auto entity : entities)
     {
@@ -83,15 +86,22 @@ void CameraSystem::process(float)
             const auto& tx = entity.getComponent<Transform>();
             camera.updateMatrices(tx, -getScene()->getWaterLevel() * 2.f);
 
-            //don't clear these then systems updating them can just do swaps
-            //finalPass.drawList.clear();
-            //reflectionPass.drawList.clear();
-            getScene()->updateDrawLists(entity);
+            m_activeCameras.push_back(entity);
+        }
+    }
 
-            if (camera.isStatic)
-            {
-                camera.active = false;
-            }
+    //don't clear these then systems updating them can just do swaps
+    //finalPass.drawList.clear();
+    //reflectionPass.drawList.clear();
+    //all the cameras are updated together so that renderers can process them in parallel
+    getScene()->updateDrawLists(m_activeCameras);
+
+    for (auto entity : m_activeCameras)
+    {
+        auto& camera = entity.getComponent<Camera>();
+        if (camera.isStatic)
+        {
+            camera.active = false;
         }
     }
 }
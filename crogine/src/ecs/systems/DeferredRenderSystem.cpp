@@ -28,6 +28,7 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include "../../detail/GLCheck.hpp"
+#include "../VisibilityPass.hpp"
 
 #include <crogine/ecs/systems/DeferredRenderSystem.hpp>
 
@@ -96,7 +97,8 @@ DeferredRenderSystem::DeferredRenderSystem(MessageBus& mb)
     m_deferredVao   (0),
     m_forwardVao    (0),
     m_vbo           (0),
-    m_envMap        (nullptr)
+    m_envMap        (nullptr),
+    m_passBuffer    (Detail::PassData::BlockName)
 {
     requireComponent<Model>();
     requireComponent<Transform>();
@@ -153,92 +155,89 @@ void DeferredRenderSystem::updateDrawList(Entity camera)
 
 
     auto cameraPos = camera.getComponent<Transform>().getWorldPosition();
-    auto& entities = getEntities();
 
     if (m_visibleLists.size() == m_cameraCount)
     {
         m_visibleLists.emplace_back();
     }
-    auto& [deferred, forward] = m_visibleLists[m_cameraCount];
+    auto& [deferred, forward, materialIDs] = m_visibleLists[m_cameraCount];
     deferred.clear(); //TODO if we had a dirty flag on the cam transform we could only update this if the camera moved...
     forward.clear();
+    materialIDs.clear();
 
-    for (auto& entity : entities)
+    //TODO we *could* do every camera pass - but for now we're
+    //expecting screen space reflections rather than using camera reflection mapping
+
+    //models are culled by the scene, so the results are shared with
+    //the ModelRenderer and any other cameras using the same frustum
+    auto& visibility = *getScene()->m_visibilityPass;
+    const auto& entities = visibility.getEntities();
+    const auto& spheres = visibility.getSpheres();
+    const auto forwardVector = cro::Util::Matrix::getForwardVector(cam.getPass(Camera::Pass::Final).viewMatrix);
+
+    for (auto index : visibility.getVisible(cam, Camera::Pass::Final))
     {
+        auto entity = entities[index];
+        if (!hasEntity(entity))
+        {
+            continue;
+        }
+
         auto& model = entity.getComponent<Model>();
         if (model.isHidden())
         {
             continue;
         }
 
-        //cull entities from frustum - TODO using a dynamic tree could improve this
-        //on bigger scenes
-        auto sphere = model.m_meshData.boundingSphere;
-        const auto& tx = entity.getComponent<Transform>();
+        auto direction = (spheres[index].centre - cameraPos);
+        float distance = glm::dot(forwardVector, direction);
 
-        sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre, 1.f));
-        auto scale = tx.getScale();
-        sphere.radius *= ((scale.x + scale.y + scale.z) / 3.f);
+        SortData d;
+        d.entity = entity;
+        d.distanceFromCamera = distance;
 
-        //TODO we *could* do every camera pass - but for now we're
-        //expecting screen space reflections rather than using camera reflection mapping
+        SortData f;
+        f.entity = entity;
+        f.distanceFromCamera = distance;
 
-        //for(pass in cam.passes)
-        //{
-            const auto& frustum = cam.getPass(Camera::Pass::Final).getFrustum();
-            auto forwardVector = cro::Util::Matrix::getForwardVector(cam.getPass(Camera::Pass::Final).viewMatrix);
+        //TODO a large model with a centre behind the camera
+        //might still intersect the view but register as being
+        //further away than smaller objects in front
 
-            bool visible = true;
-            std::size_t i = 0;
-            while (visible && i < frustum.size())
+        //foreach material
+        //add the index to the shared list so that each
+        //entity's deferred and forward IDs are contiguous
+        d.firstMaterial = static_cast<std::uint32_t>(materialIDs.size());
+        for (auto i = 0u; i < model.m_meshData.submeshCount; ++i)
+        {
+            if (model.m_materials[Mesh::IndexData::Final][i].deferred)
             {
-                visible = (Spatial::intersects(frustum[i++], sphere) != Planar::Back);
+                materialIDs.push_back(static_cast<std::int32_t>(i));
+                d.materialCount++;
             }
+        }
 
-            if (visible)
+        f.firstMaterial = static_cast<std::uint32_t>(materialIDs.size());
+        for (auto i = 0u; i < model.m_meshData.submeshCount; ++i)
+        {
+            if (!model.m_materials[Mesh::IndexData::Final][i].deferred)
             {
-                auto direction = (sphere.centre - cameraPos);
-                float distance = glm::dot(forwardVector, direction);
-
-                SortData d;
-                d.entity = entity;
-                d.distanceFromCamera = distance;
-
-                SortData f;
-                f.entity = entity;
-                d.distanceFromCamera = distance;
-
-                //TODO a large model with a centre behind the camera
-                //might still intersect the view but register as being
-                //further away than smaller objects in front
-
-                //foreach material
-                //add ent/index pair to deferred or forward list
-                for (i = 0u; i < model.m_meshData.submeshCount; ++i)
-                {
-                    if (!model.m_materials[Mesh::IndexData::Final][i].deferred)
-                    {
-                        f.materialIDs.push_back(static_cast<std::int32_t>(i));
-                    }
-                    else
-                    {
-                        d.materialIDs.push_back(static_cast<std::int32_t>(i));
-                    }
-                }
-
-                //store the entity in the appropriate list
-                //if it has any materials associated with it
-                if (!d.materialIDs.empty())
-                {
-                    deferred.push_back(d);
-                }
-
-                if (!f.materialIDs.empty())
-                {
-                    forward.push_back(f);
-                }
+                materialIDs.push_back(static_cast<std::int32_t>(i));
+                f.materialCount++;
             }
-        //}
+        }
+
+        //store the entity in the appropriate list
+        //if it has any materials associated with it
+        if (d.materialCount != 0)
+        {
+            deferred.push_back(d);
+        }
+
+        if (f.materialCount != 0)
+        {
+            forward.push_back(f);
+        }
     }
     
     //sort deferred list by distance to Camera.
@@ -262,7 +261,7 @@ void DeferredRenderSystem::render(Entity camera, const RenderTarget& rt)
     const auto& pass = cam.getPass(Camera::Pass::Final);
 
     auto listID = m_listIndices[cam.getDrawListIndex()];
-    const auto& [deferred, forward] = m_visibleLists[listID];
+    const auto& [deferred, forward, materialIDs] = m_visibleLists[listID];
 
     glm::vec4 clipPlane = glm::vec4(0.f, 1.f, 0.f, -getScene()->getWaterLevel() + (0.08f * pass.getClipPlaneMultiplier())) * pass.getClipPlaneMultiplier();
 
@@ -270,6 +269,19 @@ void DeferredRenderSystem::render(Entity camera, const RenderTarget& rt)
     auto cameraPosition = camTx.getWorldPosition();
     auto screenSize = glm::vec2(rt.getSize());
 
+    //the built-in material shaders read these from a uniform block
+    const auto& sunlight = getScene()->getSunlight().getComponent<Sunlight>();
+    m_passData.viewMatrix = pass.viewMatrix;
+    m_passData.viewProjectionMatrix = pass.viewProjectionMatrix;
+    m_passData.projectionMatrix = cam.getProjectionMatrix();
+    m_passData.clipPlane = clipPlane;
+    m_passData.cameraWorldPosition = cameraPosition;
+    m_passData.lightDirection = sunlight.getDirection();
+    m_passData.lightColour = sunlight.getColour().getVec4();
+    m_passData.screenSize = screenSize;
+    m_passBuffer.setData(m_passData);
+    m_passBuffer.bind(Detail::PassData::BindPoint);
+
     glCheck(glCullFace(pass.getCullFace()));
     glCheck(glEnable(GL_CULL_FACE));
     glCheck(glEnable(GL_DEPTH_TEST));
@@ -279,7 +291,7 @@ void DeferredRenderSystem::render(Entity camera, const RenderTarget& rt)
     auto& buffer = camera.getComponent<GBuffer>().buffer;
     buffer.clear(ClearColours);
 
-    for (auto [entity, matIDs, depth] : deferred)
+    for (auto [entity, firstMaterial, materialCount, depth] : deferred)
     {
         //foreach submesh / material:
         const auto& model = entity.getComponent<Model>();
@@ -294,8 +306,10 @@ void DeferredRenderSystem::render(Entity camera, const RenderTarget& rt)
         glm::mat4 worldMat = tx.getWorldTransform();
         glm::mat4 worldView = pass.viewMatrix * worldMat;
 
-        for (auto i : matIDs)
+        for (auto j = firstMaterial; j < firstMaterial + materialCount; ++j)
         {
+            const auto i = materialIDs[j];
+
             //bind shader
             glCheck(glUseProgram(model.m_materials[Mesh::IndexData::Final][i].shader));
 
@@ -332,7 +346,7 @@ void DeferredRenderSystem::render(Entity camera, const RenderTarget& rt)
     glCheck(glBlendEquationi(TextureIndex::Accum, GL_FUNC_ADD));
     glCheck(glBlendEquationi(TextureIndex::Reveal, GL_FUNC_ADD));
 
-    for (auto [entity, matIDs, depth] : forward)
+    for (auto [entity, firstMaterial, materialCount, depth] : forward)
     {
         //foreach submesh / material:
         const auto& model = entity.getComponent<Model>();
@@ -347,8 +361,10 @@ void DeferredRenderSystem::render(Entity camera, const RenderTarget& rt)
         glm::mat4 worldMat = tx.getWorldTransform();
         glm::mat4 worldView = pass.viewMatrix * worldMat;
 
-        for (auto i : matIDs)
+        for (auto j = firstMaterial; j < firstMaterial + materialCount; ++j)
         {
+            const auto i = materialIDs[j];
+
             //bind shader
             glCheck(glUseProgram(model.m_materials[Mesh::IndexData::Final][i].shader));
 
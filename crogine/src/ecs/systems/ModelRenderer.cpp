@@ -32,7 +32,10 @@ source distribution.
 #include "../../graphics/shaders/PBR.hpp"
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/RadixSort.hpp"
+#include "../VisibilityPass.hpp"
 
+#include <crogine/core/App.hpp>
 #include <crogine/core/Clock.hpp>
 #include <crogine/core/Console.hpp>
 #include <crogine/ecs/Scene.hpp>
@@ -40,6 +43,7 @@ source distribution.
 #include <crogine/ecs/components/Camera.hpp>
 #include <crogine/ecs/components/Transform.hpp>
 #include <crogine/ecs/components/Model.hpp>
+#include <crogine/graphics/ShaderResource.hpp>
 #include <crogine/util/Matrix.hpp>
 #include <crogine/util/Frustum.hpp>
 
@@ -49,86 +53,269 @@ source distribution.
 #include <crogine/detail/glm/gtc/matrix_inverse.hpp>
 #include <crogine/detail/glm/gtx/norm.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <cstring>
+#include <cstddef>
+
 using namespace cro;
 
 namespace
 {
+    //culling each entity is cheap, so use fairly large batches
+    constexpr std::size_t CullBatchSize = 256;
+
+    //built in shader IDs are the BuiltIn type ORd with the BuiltInFlags
+    constexpr std::int32_t BuiltInTypeMask = 0x7f000000;
+
+    //instanced copies of materials are released if they go unused for this many frames
+    constexpr std::uint32_t MaxUnusedFrames = 60;
+
+    //sort keys are packed from the most significant bit down:
+    //opaque:      [1 translucent = 0][12 shader][12 material][12 mesh][27 depth, front to back]
+    //transparent: [1 translucent = 1][27 depth, back to front][12 shader][12 material][12 mesh]
+    //so opaque draws are grouped by state and transparent draws keep their
+    //depth order. Each pass has its own draw list so is not part of the key.
+    //The mesh is keyed by its buffers rather than the model's VAO so that
+    //models sharing a mesh end up next to each other and can be instanced.
+    constexpr std::uint64_t TranslucentBit = (1ull << 63);
+    constexpr std::uint64_t FieldMask = 0xfff;
+    constexpr std::uint64_t DepthMask = 0x7ffffff;
+
+    std::uint64_t quantiseDepth(float distance)
+    {
+        //positive floats sort in the same order as their bit
+        //patterns, so keep the top 27 bits below the sign bit
+        distance = std::max(0.f, distance);
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &distance, sizeof(bits));
+        return (bits >> 4) & DepthMask;
+    }
+
+    std::uint64_t getMaterialKey(const Material::Data& material)
+    {
+        //materials are copied to each model so have no shared ID,
+        //instead group them by the textures they bind
+        std::uint32_t hash = 0;
+        for (const auto& [uniform, prop] : material.compiledProperties)
+        {
+            if (prop.type >= Material::Property::Texture)
+            {
+                hash += prop.textureID * 2654435761u;
+            }
+        }
+        return (hash ^ (hash >> 12) ^ (hash >> 24)) & FieldMask;
+    }
+
+    std::uint64_t getSortKey(const Material::Data& material, std::uint32_t vbo, std::uint32_t ibo, float distance)
+    {
+        const auto shader = static_cast<std::uint64_t>(material.shader) & FieldMask;
+        const auto materialKey = getMaterialKey(material);
+        const auto meshKey = static_cast<std::uint64_t>(vbo ^ (ibo << 6)) & FieldMask;
+        const auto depth = quantiseDepth(distance);
+
+        if (material.blendMode != Material::BlendMode::None)
+        {
+            return TranslucentBit | ((DepthMask - depth) << 36) | (shader << 24) | (materialKey << 12) | meshKey;
+        }
+        return (shader << 51) | (materialKey << 39) | (meshKey << 27) | depth;
+    }
+
+    bool samePropertyValue(const Material::Property& a, const Material::Property& b)
+    {
+        if (a.type != b.type)
+        {
+            return false;
+        }
+
+        switch (a.type)
+        {
+        default: return true;
+        case Material::Property::Number:
+            return a.numberValue == b.numberValue;
+        case Material::Property::Vec2:
+            return a.vecValue[0] == b.vecValue[0] && a.vecValue[1] == b.vecValue[1];
+        case Material::Property::Vec3:
+            return a.vecValue[0] == b.vecValue[0] && a.vecValue[1] == b.vecValue[1]
+                && a.vecValue[2] == b.vecValue[2];
+        case Material::Property::Vec4:
+            return a.vecValue[0] == b.vecValue[0] && a.vecValue[1] == b.vecValue[1]
+                && a.vecValue[2] == b.vecValue[2] && a.vecValue[3] == b.vecValue[3];
+        case Material::Property::Mat4:
+            return a.matrixValue == b.matrixValue;
+        case Material::Property::Texture:
+        case Material::Property::TextureArray:
+        case Material::Property::Cubemap:
+        case Material::Property::CubemapArray:
+            return a.textureID == b.textureID;
+        }
+    }
+
+    //returns true if drawing with either material results in the same output
+    bool sameMaterial(const Material::Data& a, const Material::Data& b)
+    {
+        if (&a == &b)
+        {
+            return true;
+        }
+
+        if (a.shader != b.shader
+            || a.blendMode != b.blendMode
+            || a.doubleSided != b.doubleSided
+            || a.enableDepthTest != b.enableDepthTest
+            || a.propertyHash != b.propertyHash
+            || a.compiledProperties.size() != b.compiledProperties.size())
+        {
+            return false;
+        }
+
+        if (a.blendMode == Material::BlendMode::Custom
+            && (a.blendData.writeDepthMask != b.blendData.writeDepthMask
+                || a.blendData.equation != b.blendData.equation
+                || a.blendData.blendFunc != b.blendData.blendFunc
+                || a.blendData.enableProperties != b.blendData.enableProperties))
+        {
+            return false;
+        }
 
+        //the hashes match so this is almost certainly the same, but check
+        //anyway. Copies of the same material compile their properties in
+        //the same order - anything else is treated as a different material.
+        for (auto i = 0u; i < a.compiledProperties.size(); ++i)
+        {
+            if (a.compiledProperties[i].uniform != b.compiledProperties[i].uniform
+                || !samePropertyValue(a.compiledProperties[i].property, b.compiledProperties[i].property))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //uniforms which are the same for every draw in a pass
+    constexpr std::uint32_t PassUniformCount = 6;
+    //uniforms which are the same for every sub-mesh of a model
+    constexpr std::uint32_t ModelUniformCount = 3;
+
+    //models moving less than this don't need to be reinserted into the tree
+    constexpr float TreeFattenAmount = 1.f;
+    constexpr std::uint32_t AllFrustumPlanes = 0x3f;
 }
 
 ModelRenderer::ModelRenderer(MessageBus& mb)
     : System        (mb, typeid(ModelRenderer)),
     m_drawLists     (1),
-    m_pass          (Mesh::IndexData::Final)/*,
-    m_tree          (1.f),
-    m_useTreeQueries(false)*/
+    m_drawListScratch(1),
+    m_passBuffer    (Detail::PassData::BlockName),
+#ifdef PLATFORM_DESKTOP
+    m_instanceBuffer(0),
+    m_runBuildID    (0),
+#endif
+    m_pass          (Mesh::IndexData::Final),
+    m_cullingMode   (CullingMode::Auto),
+    m_tree          (TreeFattenAmount),
+    m_useTreeQueries(false),
+    m_frameID       (0),
+    m_treeFrameID   (0)
 {
     requireComponent<Transform>();
     requireComponent<Model>();
+
+    setConcurrentDrawLists(true);
 }
 
-//public
-void ModelRenderer::updateDrawList(Entity cameraEnt)
+ModelRenderer::~ModelRenderer()
 {
-    auto& camComponent = cameraEnt.getComponent<Camera>();
-    if (m_drawLists.size() <= camComponent.getDrawListIndex())
+#ifdef PLATFORM_DESKTOP
+    if (m_instanceBuffer)
     {
-        m_drawLists.resize(camComponent.getDrawListIndex() + 1);
+        glCheck(glDeleteBuffers(1, &m_instanceBuffer));
     }
 
-    /*if (m_useTreeQueries)
+    for (const auto& instancedMaterial : m_instancedMaterials)
     {
-        updateDrawListBalancedTree(cameraEnt);
+        glCheck(glDeleteVertexArrays(1, &instancedMaterial.vao));
     }
-    else*/
+#endif
+}
+
+//public
+void ModelRenderer::updateDrawList(Entity cameraEnt)
+{
+    const auto& camComponent = cameraEnt.getComponent<Camera>();
+    resizeDrawLists(camComponent.getDrawListIndex() + 1);
+
+    updateTree();
+    if (buildDrawList(cameraEnt, true))
     {
-        updateDrawListDefault(cameraEnt);
+        m_frameStats.drawListAllocations++;
     }
-    
-    auto passCount = camComponent.reflectionBuffer.available() ? 2 : 1;
 
     DPRINT("Visible 3D ents in Scene " + std::to_string(getScene()->getInstanceID()) 
         + ", Camera " + std::to_string(cameraEnt.getIndex()), std::to_string(m_drawLists[camComponent.getDrawListIndex()][0].size()));
     //DPRINT("Total ents", std::to_string(entities.size()));
+}
 
-    //sort lists by depth
-    //flag values make sure transparent materials are rendered last
-    //with opaque going front to back and transparent back to front
-    auto& drawList = m_drawLists[camComponent.getDrawListIndex()];
-    for (auto i = 0; i < passCount; ++i)
+void ModelRenderer::updateDrawLists(const std::vector<Entity>& cameras)
+{
+    if (cameras.size() < 2)
+    {
+        //a single camera is culled in parallel batches instead
+        Renderable::updateDrawLists(cameras);
+        return;
+    }
+
+    //anything shared by the cameras is updated before the jobs start
+    std::size_t listCount = 0;
+    for (auto camera : cameras)
     {
-        std::sort(std::begin(drawList[i]), std::end(drawList[i]),
-            [](MaterialPair& a, MaterialPair& b)
+        listCount = std::max(listCount, camera.getComponent<Camera>().getDrawListIndex() + 1);
+    }
+    resizeDrawLists(listCount);
+    updateTree();
+
+    //the jobs check entities with hasEntity() which
+    //mustn't rebuild the slots while they're running
+    updateEntitySlots();
+
+    //each job only touches the draw list and scratch memory of its own camera
+    std::atomic<std::uint32_t> allocations = 0;
+    auto& jobSystem = App::getJobSystem();
+    JobSystem::Counter counter;
+    for (auto camera : cameras)
+    {
+        jobSystem.schedule([this, camera, &allocations]()
             {
-                return a.second.flags < b.second.flags;
-            });
+                if (buildDrawList(camera, false))
+                {
+                    allocations++;
+                }
+            }, &counter);
+    }
+    jobSystem.wait(counter);
+
+    m_frameStats.drawListAllocations += allocations;
+
+    for (auto camera : cameras)
+    {
+        DPRINT("Visible 3D ents in Scene " + std::to_string(getScene()->getInstanceID())
+            + ", Camera " + std::to_string(camera.getIndex()), std::to_string(m_drawLists[camera.getComponent<Camera>().getDrawListIndex()][0].size()));
     }
 }
 
 void ModelRenderer::process(float dt)
 {
+    m_lastFrameStats = m_frameStats;
+    m_frameStats = {};
+    m_frameID++;
+
     auto& entities = getEntities();
     for (auto entity : entities)
     {
         auto& model = entity.getComponent<Model>();
         model.updateMaterialAnimations(dt);
-
-        /*if (m_useTreeQueries)
-        {
-            if (!entity.destroyed())
-            {
-                const auto& tx = entity.getComponent<Transform>();
-                auto worldPosition = tx.getWorldPosition();
-                auto worldBounds = model.getAABB();
-
-                worldBounds += tx.getOrigin();
-                worldBounds = tx.getWorldTransform() * worldBounds;
-
-                m_tree.moveNode(model.m_treeID, worldBounds, worldPosition - model.m_lastWorldPosition);
-
-                model.m_lastWorldPosition = worldPosition;
-            }
-        }*/
     }
 }
 
@@ -145,12 +332,77 @@ void ModelRenderer::render(Entity camera, const RenderTarget& rt)
         auto cameraPosition = camTx.getWorldPosition();
         auto screenSize = glm::vec2(rt.getSize());
 
-        glCheck(glCullFace(pass.getCullFace()));
+#ifdef PLATFORM_DESKTOP
+        //built-in shaders read the per-pass values from a
+        //uniform block, so upload them once for all programs
+        const auto& sunlight = getScene()->getSunlight().getComponent<Sunlight>();
+        m_passData.viewMatrix = pass.viewMatrix;
+        m_passData.viewProjectionMatrix = pass.viewProjectionMatrix;
+        m_passData.projectionMatrix = camComponent.getProjectionMatrix();
+        m_passData.clipPlane = clipPlane;
+        m_passData.cameraWorldPosition = cameraPosition;
+        m_passData.lightDirection = sunlight.getDirection();
+        m_passData.lightColour = sunlight.getColour().getVec4();
+        m_passData.screenSize = screenSize;
+        m_passBuffer.setData(m_passData);
+        m_passBuffer.bind(Detail::PassData::BindPoint);
+#endif
 
         //DPRINT("Render count", std::to_string(m_visibleEntities.size()));
         const auto& visibleEntities = m_drawLists[camComponent.getDrawListIndex()][camComponent.getActivePassIndex()];
-        for (const auto& [entity, sortData] : visibleEntities)
+
+        const auto runCapacity = m_drawRuns.capacity();
+#ifdef PLATFORM_DESKTOP
+        const auto instanceCapacity = m_instanceData.capacity();
+#endif
+        buildDrawRuns(visibleEntities);
+
+        if (runCapacity != m_drawRuns.capacity()
+#ifdef PLATFORM_DESKTOP
+            || instanceCapacity != m_instanceData.capacity()
+#endif
+            )
+        {
+            m_frameStats.drawListAllocations++;
+        }
+
+#ifdef PLATFORM_DESKTOP
+        if (!m_instanceData.empty())
+        {
+            if (m_instanceBuffer == 0)
+            {
+                glCheck(glGenBuffers(1, &m_instanceBuffer));
+            }
+
+            //respecifying the whole buffer lets the driver orphan the
+            //previous storage rather than waiting for it to be drawn
+            glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer));
+            glCheck(glBufferData(GL_ARRAY_BUFFER, m_instanceData.size() * sizeof(InstanceData), m_instanceData.data(), GL_STREAM_DRAW));
+            glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        }
+#endif
+
+        glCheck(glCullFace(pass.getCullFace()));
+
+        //other systems may have changed the state since we last rendered
+        m_stateCache.invalidate();
+        m_stateCache.resetAvoidedCount();
+        m_passPrograms.clear();
+        m_programMaterials.clear();
+        std::uint32_t uniformsAvoided = 0;
+
+        //instanced draws use an identity world transform, represented by a null entity
+        bool transformSet = false;
+        Entity lastEntity;
+        glm::mat4 worldMat = glm::mat4(1.f);
+        glm::mat4 worldView = glm::mat4(1.f);
+        glm::mat3 normalMat = glm::mat3(1.f);
+
+        for (const auto& run : m_drawRuns)
         {
+            const auto& item = visibleEntities[run.firstItem];
+            auto entity = item.entity;
+
             //may have been marked for deletion - OK to draw but will trigger assert
 #ifdef CRO_DEBUG_
             if (!entity.isValid())
@@ -159,83 +411,146 @@ void ModelRenderer::render(Entity camera, const RenderTarget& rt)
             }
 #endif
 
-            //foreach submesh / material:
             const auto& model = entity.getComponent<Model>();
-            glCheck(glFrontFace(model.m_facing));
+#ifdef PLATFORM_DESKTOP
+            const auto& material = run.instancedMaterial == -1 ?
+                model.m_materials[Mesh::IndexData::Final][item.matID] : m_instancedMaterials[run.instancedMaterial].material;
+#else
+            const auto& material = model.m_materials[Mesh::IndexData::Final][item.matID];
+#endif
+            m_stateCache.setFrontFace(model.m_facing);
 
-            //calc entity transform
-            const auto& tx = entity.getComponent<Transform>();
-            const glm::mat4 worldMat = tx.getWorldTransform();
-            const glm::mat4 worldView = pass.viewMatrix * worldMat;
-            //hmm for some reason doning this only once breaks rendering
-            //const glm::mat4 normalMat = glm::inverseTranspose(glm::mat3(worldMat));
+            //bind shader
+            const bool programChanged = m_stateCache.useProgram(material.shader);
 
-#ifndef PLATFORM_DESKTOP
-            glCheck(glBindBuffer(GL_ARRAY_BUFFER, model.m_meshData.vbo));
-#endif //PLATFORM
+            //apply standard uniforms - these only need setting once per shader each pass,
+            //and not at all if the shader reads them from the pass data block
+            if (!material.passData
+                && std::find(m_passPrograms.begin(), m_passPrograms.end(), material.shader) == m_passPrograms.end())
+            {
+                m_passPrograms.push_back(material.shader);
+
+                glCheck(glUniform3f(material.uniforms[Material::Camera], cameraPosition.x, cameraPosition.y, cameraPosition.z));
+                glCheck(glUniform2f(material.uniforms[Material::ScreenSize], screenSize.x, screenSize.y));
+                glCheck(glUniform4f(material.uniforms[Material::ClipPlane], clipPlane[0], clipPlane[1], clipPlane[2], clipPlane[3]));
+                glCheck(glUniformMatrix4fv(material.uniforms[Material::View], 1, GL_FALSE, glm::value_ptr(pass.viewMatrix)));
+                glCheck(glUniformMatrix4fv(material.uniforms[Material::ViewProjection], 1, GL_FALSE, glm::value_ptr(pass.viewProjectionMatrix)));
+                glCheck(glUniformMatrix4fv(material.uniforms[Material::Projection], 1, GL_FALSE, glm::value_ptr(camComponent.getProjectionMatrix())));
+            }
+            else
+            {
+                uniformsAvoided += PassUniformCount;
+            }
 
-            for (auto i : sortData.matIDs)
+            //calc entity transform - consecutive sub-meshes of the
+            //same model using the same shader can skip the upload
+            const auto transformEntity = run.instanced ? Entity() : entity;
+            const bool entityChanged = !transformSet || !(transformEntity == lastEntity);
+            if (entityChanged)
             {
-                //bind shader
-                glCheck(glUseProgram(model.m_materials[Mesh::IndexData::Final][i].shader));
+                if (run.instanced)
+                {
+                    //instance transforms are multiplied by the world matrix
+                    worldMat = glm::mat4(1.f);
+                    normalMat = glm::mat3(1.f);
+                }
+                else
+                {
+                    const auto& tx = entity.getComponent<Transform>();
+                    worldMat = tx.getWorldTransform();
+                    normalMat = glm::inverseTranspose(glm::mat3(worldMat));
+                }
+                worldView = pass.viewMatrix * worldMat;
+
+                lastEntity = transformEntity;
+                transformSet = true;
+            }
 
-                //apply shader uniforms from material
-                glCheck(glUniformMatrix4fv(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::WorldView], 1, GL_FALSE, glm::value_ptr(worldView)));
-                applyProperties(model.m_materials[Mesh::IndexData::Final][i], model, *getScene(), camComponent);
+            if (entityChanged || programChanged)
+            {
+                glCheck(glUniformMatrix4fv(material.uniforms[Material::WorldView], 1, GL_FALSE, glm::value_ptr(worldView)));
+                glCheck(glUniformMatrix4fv(material.uniforms[Material::World], 1, GL_FALSE, glm::value_ptr(worldMat)));
+                glCheck(glUniformMatrix3fv(material.uniforms[Material::Normal], 1, GL_FALSE, glm::value_ptr(normalMat)));
+            }
+            else
+            {
+                uniformsAvoided += ModelUniformCount;
+            }
 
-                //apply standard uniforms
-                glCheck(glUniform3f(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::Camera], cameraPosition.x, cameraPosition.y, cameraPosition.z));
-                glCheck(glUniform2f(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::ScreenSize], screenSize.x, screenSize.y));
-                glCheck(glUniform4f(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::ClipPlane], clipPlane[0], clipPlane[1], clipPlane[2], clipPlane[3]));
-                glCheck(glUniformMatrix4fv(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::View], 1, GL_FALSE, glm::value_ptr(pass.viewMatrix)));
-                glCheck(glUniformMatrix4fv(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::ViewProjection], 1, GL_FALSE, glm::value_ptr(pass.viewProjectionMatrix)));
-                glCheck(glUniformMatrix4fv(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::Projection], 1, GL_FALSE, glm::value_ptr(camComponent.getProjectionMatrix())));
-                glCheck(glUniformMatrix4fv(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::World], 1, GL_FALSE, glm::value_ptr(worldMat)));
-                glCheck(glUniformMatrix3fv(model.m_materials[Mesh::IndexData::Final][i].uniforms[Material::Normal], 1, GL_FALSE, glm::value_ptr(glm::inverseTranspose(glm::mat3(worldMat)))));
+            //apply shader uniforms from material - skipping them if
+            //the shader already has the same values from a previous draw
+            bool uploadProperties = true;
+            auto programMaterial = std::find_if(m_programMaterials.begin(), m_programMaterials.end(),
+                [&material](const std::pair<std::uint32_t, std::uint64_t>& p)
+                {
+                    return p.first == material.shader;
+                });
 
-                applyBlendMode(model.m_materials[Mesh::IndexData::Final][i]/*.blendMode*/);
+            if (programMaterial == m_programMaterials.end())
+            {
+                m_programMaterials.emplace_back(material.shader, material.propertyHash);
+            }
+            else if (programMaterial->second == material.propertyHash)
+            {
+                uploadProperties = false;
+                uniformsAvoided += static_cast<std::uint32_t>(material.compiledProperties.size());
+            }
+            else
+            {
+                programMaterial->second = material.propertyHash;
+            }
+            applyProperties(material, model, *getScene(), camComponent, &m_stateCache, uploadProperties);
 
-                glCheck(model.m_materials[Mesh::IndexData::Final][i].doubleSided ? glDisable(GL_CULL_FACE) : glEnable(GL_CULL_FACE));
-                glCheck(model.m_materials[Mesh::IndexData::Final][i].enableDepthTest ? glEnable(GL_DEPTH_TEST) : glDisable(GL_DEPTH_TEST));
+            applyBlendMode(material, &m_stateCache);
+            m_stateCache.setEnabled(GL_CULL_FACE, !material.doubleSided);
+            m_stateCache.setEnabled(GL_DEPTH_TEST, material.enableDepthTest);
 
 #ifdef PLATFORM_DESKTOP
-                model.draw(i, Mesh::IndexData::Final);
+            if (run.instanced)
+            {
+                drawInstanced(model, item.matID, run);
+                m_frameStats.instancedSubmeshes += static_cast<std::uint32_t>(run.itemCount);
+            }
+            else
+            {
+                model.draw(item.matID, Mesh::IndexData::Final);
+            }
 
 #else //GLES 2 doesn't have VAO support without extensions
 
-                //bind attribs
-                const auto& attribs = model.m_materials[Mesh::IndexData::Final][i].attribs;
-                for (auto j = 0u; j < model.m_materials[Mesh::IndexData::Final][i].attribCount; ++j)
-                {
-                    glCheck(glEnableVertexAttribArray(attribs[j][Material::Data::Index]));
-                    glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
-                        GL_FLOAT, GL_FALSE, static_cast<GLsizei>(model.m_meshData.vertexSize),
-                        reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
-                }
+            glCheck(glBindBuffer(GL_ARRAY_BUFFER, model.m_meshData.vbo));
 
-                //bind element/index buffer
-                const auto& indexData = model.m_meshData.indexData[i];
-                glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexData.ibo));
+            //bind attribs
+            const auto& attribs = material.attribs;
+            for (auto j = 0u; j < material.attribCount; ++j)
+            {
+                glCheck(glEnableVertexAttribArray(attribs[j][Material::Data::Index]));
+                glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
+                    GL_FLOAT, GL_FALSE, static_cast<GLsizei>(model.m_meshData.vertexSize),
+                    reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
+            }
 
-                //draw elements
-                glCheck(glDrawElements(static_cast<GLenum>(indexData.primitiveType), indexData.indexCount, static_cast<GLenum>(indexData.format), 0));
+            //bind element/index buffer
+            const auto& indexData = model.m_meshData.indexData[item.matID];
+            glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexData.ibo));
 
-                glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+            //draw elements
+            glCheck(glDrawElements(static_cast<GLenum>(indexData.primitiveType), indexData.indexCount, static_cast<GLenum>(indexData.format), 0));
 
-                //unbind attribs
-                for (auto j = 0u; j < model.m_materials[Mesh::IndexData::Final][i].attribCount; ++j)
-                {
-                    glCheck(glDisableVertexAttribArray(attribs[j][Material::Data::Index]));
+            glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+
+            //unbind attribs
+            for (auto j = 0u; j < material.attribCount; ++j)
+            {
+                glCheck(glDisableVertexAttribArray(attribs[j][Material::Data::Index]));
             }
 #endif //PLATFORM 
         }
-    }
 
 #ifdef PLATFORM_DESKTOP
         glCheck(glBindVertexArray(0));
-#else
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
 #endif //PLATFORM
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
 
         //glCheck(glUseProgram(0));
 
@@ -244,7 +559,11 @@ void ModelRenderer::render(Entity camera, const RenderTarget& rt)
         glCheck(glDisable(GL_CULL_FACE));
         glCheck(glDisable(GL_DEPTH_TEST));
         glCheck(glDepthMask(GL_TRUE)); //restore this else clearing the depth buffer fails
-}
+
+        m_frameStats.drawCalls += static_cast<std::uint32_t>(m_drawRuns.size());
+        m_frameStats.stateChangesAvoided += m_stateCache.getAvoidedCount();
+        m_frameStats.uniformUploadsAvoided += uniformsAvoided;
+    }
 }
 
 std::size_t ModelRenderer::getVisibleCount(std::size_t cameraIndex, std::int32_t passIndex) const
@@ -303,16 +622,63 @@ void ModelRenderer::onEntityAdded(Entity entity)
     auto& model = entity.getComponent<Model>();
     model.updateBounds();
 
-    //model.m_treeID = m_tree.addToTree(entity, model.getAABB());
+    //models are added to the tree when it's next updated
+    model.m_treeID = -1;
 }
 
 void ModelRenderer::onEntityRemoved(Entity entity)
 {
-    //m_tree.removeFromTree(entity.getComponent<Model>().m_treeID);
+    auto& model = entity.getComponent<Model>();
+    if (model.m_treeID != -1)
+    {
+        m_tree.removeFromTree(model.m_treeID);
+        model.m_treeID = -1;
+    }
 }
 
 //private
-void ModelRenderer::updateDrawListDefault(Entity cameraEnt)
+void ModelRenderer::resizeDrawLists(std::size_t count)
+{
+    if (m_drawLists.size() < count)
+    {
+        m_drawLists.resize(count);
+        m_drawListScratch.resize(count);
+    }
+}
+
+bool ModelRenderer::buildDrawList(Entity cameraEnt, bool parallel)
+{
+    const auto& camComponent = cameraEnt.getComponent<Camera>();
+    const auto listIndex = camComponent.getDrawListIndex();
+
+    //lists are only ever cleared, so once they've grown
+    //large enough for the scene they no longer allocate
+    const auto capacity = getDrawListCapacity(listIndex);
+
+    if (m_useTreeQueries)
+    {
+        updateDrawListBalancedTree(cameraEnt);
+    }
+    else
+    {
+        updateDrawListDefault(cameraEnt, parallel);
+    }
+
+    //sort lists by key - this makes sure transparent materials are rendered
+    //last, with opaque grouped by shader, material and VAO then sorted front
+    //to back and transparent sorted back to front
+    auto& drawList = m_drawLists[listIndex];
+    auto& sortBuffer = m_drawListScratch[listIndex].sortBuffer;
+    const auto passCount = camComponent.reflectionBuffer.available() ? 2 : 1;
+    for (auto i = 0; i < passCount; ++i)
+    {
+        Detail::radixSort(drawList[i], sortBuffer, [](const SortData& s) { return s.key; });
+    }
+
+    return getDrawListCapacity(listIndex) != capacity;
+}
+
+void ModelRenderer::updateDrawListDefault(Entity cameraEnt, bool parallel)
 {
     const auto& camComponent = cameraEnt.getComponent<Camera>();
     const auto cameraPos = cameraEnt.getComponent<Transform>().getWorldPosition();
@@ -320,7 +686,6 @@ void ModelRenderer::updateDrawListDefault(Entity cameraEnt)
     //entities for the second pass...
     const auto passCount = camComponent.reflectionBuffer.available() ? 2 : 1;
 
-    auto& entities = getEntities();
     auto& drawList = m_drawLists[camComponent.getDrawListIndex()];
 
     //cull entities by viewable into draw lists by pass
@@ -329,304 +694,641 @@ void ModelRenderer::updateDrawListDefault(Entity cameraEnt)
         list.clear();
     }
 
-    for (auto& entity : entities)
+    //world bounds are shared with the other renderers and culled
+    //by the scene, which returns the models visible to each pass
+    auto& visibility = *getScene()->m_visibilityPass;
+    const auto& entities = visibility.getEntities();
+    const auto& spheres = visibility.getSpheres();
+
+    //for each pass in the list (different passes may use different projections, eg reflections)
+    for (auto p = 0; p < passCount; ++p)
     {
-        auto& model = entity.getComponent<Model>();
-        if (model.isHidden())
+        const auto& pass = camComponent.getPass(p);
+        const auto& visible = visibility.getVisible(camComponent, p);
+
+        const auto addVisible = [&](std::size_t begin, std::size_t end, MaterialList& list)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                const auto index = visible[i];
+                auto entity = entities[index];
+                if (!hasEntity(entity))
+                {
+                    continue;
+                }
+
+                const auto& model = entity.getComponent<Model>();
+                if (model.isHidden()
+                    || (model.m_renderFlags & pass.renderFlags) == 0)
+                {
+                    continue;
+                }
+
+                //this is a good approximation of distance based on the centre
+                //of the model (large models might suffer without face sorting...)
+                //assuming the forward vector is normalised - though WHY would you
+                //scale the view matrix???
+                const auto& sphere = spheres[index];
+                auto direction = (sphere.centre - cameraPos);
+                float distance = glm::dot(pass.forwardVector, direction);
+
+                if (distance < -sphere.radius)
+                {
+                    //model is behind the camera
+                    continue;
+                }
+
+                //foreach material add a draw item to the list
+                for (auto j = 0u; j < model.m_meshData.submeshCount; ++j)
+                {
+                    auto& item = list.emplace_back();
+                    item.key = getSortKey(model.m_materials[Mesh::IndexData::Final][j], model.m_meshData.vbo, model.m_meshData.indexData[j].ibo, distance);
+                    item.entity = entity;
+                    item.matID = static_cast<std::int32_t>(j);
+                }
+            }
+        };
+
+        if (!parallel)
         {
+            //this camera is already being updated on its own thread
+            addVisible(0, visible.size(), drawList[p]);
             continue;
         }
 
-        if (model.m_meshBox != model.m_meshData.boundingBox)
+        //visible entities are sorted into parallel batches, then
+        //appended to the list of the pass in order
+        const auto batchCount = getBatchCount(visible.size(), CullBatchSize);
+        if (m_batchLists.size() < batchCount)
         {
-            model.updateBounds();
+            m_batchLists.resize(batchCount);
         }
 
-        //use the bounding sphere for depth testing
-        auto sphere = model.getBoundingSphere();
-        const auto& tx = entity.getComponent<Transform>();
+        parallelFor(visible.size(),
+            [&](std::size_t batch, std::size_t begin, std::size_t end)
+        {
+            auto& batchList = m_batchLists[batch][p];
+            batchList.clear();
+            addVisible(begin, end, batchList);
+        }, CullBatchSize);
 
-        sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre, 1.f));
-        auto scale = tx.getWorldScale();
+        for (auto i = 0u; i < batchCount; ++i)
+        {
+            auto& list = m_batchLists[i][p];
+            drawList[p].insert(drawList[p].end(), std::make_move_iterator(list.begin()), std::make_move_iterator(list.end()));
+            list.clear();
+        }
+    }
+}
 
-        /*if (scale.x * scale.y * scale.z == 0)
+std::size_t ModelRenderer::getDrawListCapacity(std::size_t listIndex) const
+{
+    const auto& scratch = m_drawListScratch[listIndex];
+    std::size_t retVal = scratch.sortBuffer.capacity() + scratch.treeStack.capacity() + m_batchLists.capacity();
+    for (const auto& list : m_drawLists[listIndex])
+    {
+        retVal += list.capacity();
+    }
+
+    for (const auto& batch : m_batchLists)
+    {
+        for (const auto& list : batch)
         {
-            continue;
-        }*/
+            retVal += list.capacity();
+        }
+    }
+    return retVal;
+}
 
-        sphere.radius *= ((scale.x + scale.y + scale.z) / 3.f);
+void ModelRenderer::updateTree()
+{
+    const auto& entities = getEntities();
 
-        //for some reason the tighter fitting Spheres cause incorrect culling
-        //so this is a hack to mitigate it somewhat
-        sphere.radius *= 1.2f;
+    //the threshold is halved once the tree is active so that
+    //scenes hovering around it don't keep rebuilding the tree
+    bool useTree = m_cullingMode == CullingMode::Tree;
+    if (m_cullingMode == CullingMode::Auto)
+    {
+        const auto threshold = m_useTreeQueries ? TreeCullingThreshold / 2 : TreeCullingThreshold;
+        useTree = entities.size() >= threshold;
+    }
 
-        //for each pass in the list (different passes may use different projections, eg reflections)
-        for (auto p = 0; p < passCount; ++p)
+    if (!useTree)
+    {
+        if (m_useTreeQueries)
         {
-            if ((model.m_renderFlags & camComponent.getPass(p).renderFlags) == 0)
+            m_tree = Detail::BalancedTree(TreeFattenAmount);
+            for (auto entity : entities)
             {
-                continue;
+                entity.getComponent<Model>().m_treeID = -1;
             }
-            
-            //this is a good approximation of distance based on the centre
-            //of the model (large models might suffer without face sorting...)
-            //assuming the forward vector is normalised - though WHY would you
-            //scale the view matrix???
-            auto direction = (sphere.centre - cameraPos);
-            float distance = glm::dot(camComponent.getPass(p).forwardVector, direction);
+            m_useTreeQueries = false;
+        }
+        return;
+    }
 
-            if (distance < -sphere.radius)
-            {
-                //model is behind the camera
-                continue;
-            }
+    m_useTreeQueries = true;
+
+    //multiple cameras only need to update the tree once per frame
+    if (m_treeFrameID == m_frameID
+        && m_tree.getRoot() != Detail::TreeNode::Null)
+    {
+        return;
+    }
+    m_treeFrameID = m_frameID;
+
+    for (auto entity : entities)
+    {
+        if (entity.destroyed())
+        {
+            continue;
+        }
+
+        auto& model = entity.getComponent<Model>();
+        if (model.m_meshBox != model.m_meshData.boundingBox)
+        {
+            model.updateBounds();
+        }
+
+        const auto& worldTransform = entity.getComponent<Transform>().getWorldTransform();
+        if (model.m_treeID == -1)
+        {
+            model.m_treeID = m_tree.addWorldBounds(entity, worldTransform * model.getAABB());
+        }
+        else if (model.m_treeTransform != worldTransform
+            || model.m_treeBounds != model.getAABB())
+        {
+            //the tree only reinserts the node if it moved outside its fattened bounds
+            const auto displacement = glm::vec3(worldTransform[3] - model.m_treeTransform[3]);
+            m_tree.moveNode(model.m_treeID, worldTransform * model.getAABB(), displacement);
+        }
+        else
+        {
+            continue;
+        }
+
+        model.m_treeTransform = worldTransform;
+        model.m_treeBounds = model.getAABB();
+    }
+}
+
+void ModelRenderer::updateDrawListBalancedTree(Entity cameraEnt)
+{
+    const auto& camComponent = cameraEnt.getComponent<Camera>();
+    const auto cameraPos = cameraEnt.getComponent<Transform>().getWorldPosition();
+    const auto passCount = camComponent.reflectionBuffer.available() ? 2 : 1;
 
+    auto& drawList = m_drawLists[camComponent.getDrawListIndex()];
+    for (auto& list : drawList)
+    {
+        list.clear();
+    }
+
+    const auto& nodes = m_tree.getNodes();
+    auto& treeStack = m_drawListScratch[camComponent.getDrawListIndex()].treeStack;
+    for (auto p = 0; p < passCount; ++p)
+    {
+        const auto& pass = camComponent.getPass(p);
+        const auto frustum = pass.getFrustum();
+
+        treeStack.clear();
+        if (m_tree.getRoot() != Detail::TreeNode::Null)
+        {
+            treeStack.emplace_back(m_tree.getRoot(), AllFrustumPlanes);
+        }
+
+        while (!treeStack.empty())
+        {
+            auto [treeID, planes] = treeStack.back();
+            treeStack.pop_back();
+
+            const auto& node = nodes[treeID];
 
+            //only test the planes the parent node was crossing. When a node is entirely
+            //in front of every plane its children are accepted without further tests
             bool visible = true;
-            //if (camComponent.isOrthographic())
+            for (auto j = 0u; j < frustum.size() && planes != 0; ++j)
             {
-                const auto& frustum = camComponent.getPass(p).getFrustum();
-
-                std::size_t j = 0;
-                while (visible && j < frustum.size())
+                const std::uint32_t plane = (1 << j);
+                if (planes & plane)
                 {
-                    visible = (Spatial::intersects(frustum[j++], sphere) != Planar::Back);
+                    const auto result = Spatial::intersects(frustum[j], node.fatBounds);
+                    if (result == Planar::Back)
+                    {
+                        visible = false;
+                        break;
+                    }
+
+                    if (result == Planar::Front)
+                    {
+                        planes &= ~plane;
+                    }
                 }
             }
-            /*else
+
+            if (!visible)
+            {
+                continue;
+            }
+
+            if (!node.isLeaf())
+            {
+                treeStack.emplace_back(node.childA, planes);
+                treeStack.emplace_back(node.childB, planes);
+                continue;
+            }
+
+            auto entity = node.entity;
+            auto& model = entity.getComponent<Model>();
+            if (model.isHidden()
+                || (model.m_renderFlags & pass.renderFlags) == 0)
             {
-                //well measuring this says it's nearly twice as slow...
-                model.m_visible = cro::Util::Frustum::visible(camComponent.getFrustumData(), camComponent.getPass(p).viewMatrix * tx.getWorldTransform(), model.getAABB());
-            }*/
+                continue;
+            }
 
-            if (visible)
+            //sort by the distance to the centre of the model, as the linear path does
+            const auto& tx = entity.getComponent<Transform>();
+            auto centre = glm::vec3(tx.getWorldTransform() * glm::vec4(model.getBoundingSphere().centre, 1.f));
+            float distance = glm::dot(pass.forwardVector, centre - cameraPos);
+
+            for (auto i = 0u; i < model.m_meshData.submeshCount; ++i)
             {
-                auto opaque = std::make_pair(entity, SortData());
-                auto transparent = std::make_pair(entity, SortData());
+                auto& item = drawList[p].emplace_back();
+                item.key = getSortKey(model.m_materials[Mesh::IndexData::Final][i], model.m_meshData.vbo, model.m_meshData.indexData[i].ibo, distance);
+                item.entity = entity;
+                item.matID = static_cast<std::int32_t>(i);
+            }
+        }
+    }
+}
+
+void ModelRenderer::buildDrawRuns(const MaterialList& items)
+{
+    m_drawRuns.clear();
+
+#ifdef PLATFORM_DESKTOP
+    m_instanceData.clear();
+    m_runBuildID++;
 
-                //foreach material
-                //add ent/index pair to alpha or opaque list
-                for (auto i = 0u; i < model.m_meshData.submeshCount; ++i)
+    //release variants which haven't been drawn for a while, eg
+    //those copied from a material whose properties are animated
+    for (auto i = 0u; i < m_instancedMaterials.size();)
+    {
+        if (m_frameID - m_instancedMaterials[i].lastFrame > MaxUnusedFrames)
+        {
+            glCheck(glDeleteVertexArrays(1, &m_instancedMaterials[i].vao));
+            m_instancedMaterials[i] = std::move(m_instancedMaterials.back());
+            m_instancedMaterials.pop_back();
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    //models can't be automatically instanced if they're
+    //already using their own instance data or a skeleton
+    const auto canInstance = [](const Model& model)
+    {
+        return model.m_instanceBuffers.instanceCount == 0
+            && model.m_jointCount == 0;
+    };
+#endif
+
+    std::size_t i = 0;
+    while (i < items.size())
+    {
+#ifdef PLATFORM_DESKTOP
+        auto entity = items[i].entity;
+#ifdef CRO_DEBUG_
+        if (!entity.isValid())
+        {
+            auto& run = m_drawRuns.emplace_back();
+            run.firstItem = i++;
+            continue;
+        }
+#endif
+        const auto& model = entity.getComponent<Model>();
+        const auto& material = model.m_materials[Mesh::IndexData::Final][items[i].matID];
+
+        if (canInstance(model))
+        {
+            const auto& indexData = model.m_meshData.indexData[items[i].matID];
+
+            //sorting has already placed the same mesh and material next to
+            //each other so we only need to look ahead until one doesn't match
+            auto next = i + 1;
+            while (next < items.size())
+            {
+                auto other = items[next].entity;
+#ifdef CRO_DEBUG_
+                if (!other.isValid())
                 {
-                    if (model.m_materials[Mesh::IndexData::Final][i].blendMode != Material::BlendMode::None)
-                    {
-                        transparent.second.matIDs.push_back(static_cast<std::int32_t>(i));
-                        transparent.second.flags = static_cast<std::int64_t>(-distance * 1000000.f); //suitably large number to shift decimal point
-                        transparent.second.flags += 0x0FFF000000000000; //gaurentees embiggenment so that sorting places transparent last
-                    }
-                    else
-                    {
-                        opaque.second.matIDs.push_back(static_cast<std::int32_t>(i));
-                        opaque.second.flags = static_cast<std::int64_t>(distance * 1000000.f);
-                    }
+                    break;
                 }
-
-                if (!opaque.second.matIDs.empty())
+#endif
+                const auto& otherModel = other.getComponent<Model>();
+                const auto& otherMaterial = otherModel.m_materials[Mesh::IndexData::Final][items[next].matID];
+
+                if (items[next].matID != items[i].matID
+                    || otherModel.m_meshData.vbo != model.m_meshData.vbo
+                    || otherModel.m_meshData.indexData[items[next].matID].ibo != indexData.ibo
+                    || otherModel.m_facing != model.m_facing
+                    || !canInstance(otherModel)
+                    || !sameMaterial(material, otherMaterial))
                 {
-                    drawList[p].push_back(opaque);
+                    break;
                 }
+                next++;
+            }
+
+            //shaders with the instance attributes must always be drawn instanced,
+            //built in shaders are only swapped for their variant if there's a run
+            const bool hasInstanceAttribs = material.attribs[Shader::AttributeID::InstanceTransform][Material::Data::Index] != -1;
+            std::int32_t instancedMaterial = -1;
+            if (!hasInstanceAttribs
+                && next - i > 1)
+            {
+                instancedMaterial = getInstancedMaterial(model, items[i].matID);
+            }
 
-                if (!transparent.second.matIDs.empty())
+            if (hasInstanceAttribs
+                || instancedMaterial != -1)
+            {
+                auto& run = m_drawRuns.emplace_back();
+                run.firstItem = i;
+                run.itemCount = next - i;
+                run.firstInstance = m_instanceData.size();
+                run.instancedMaterial = instancedMaterial;
+                run.instanced = true;
+
+                for (auto j = i; j < next; ++j)
                 {
-                    drawList[p].push_back(transparent);
+                    auto& instance = m_instanceData.emplace_back();
+                    instance.worldMatrix = items[j].entity.getComponent<Transform>().getWorldTransform();
+                    instance.normalMatrix = glm::inverseTranspose(glm::mat3(instance.worldMatrix));
                 }
+                i = next;
+                continue;
+            }
+
+            //the shader can't be instanced so draw the whole run individually
+            for (; i < next; ++i)
+            {
+                auto& run = m_drawRuns.emplace_back();
+                run.firstItem = i;
             }
+            continue;
         }
+#endif
+        auto& run = m_drawRuns.emplace_back();
+        run.firstItem = i++;
     }
 }
 
-void ModelRenderer::updateDrawListBalancedTree(Entity cameraEnt)
+#ifdef PLATFORM_DESKTOP
+std::int32_t ModelRenderer::getInstancedMaterial(const Model& model, std::int32_t matID)
 {
-    //const auto& camComponent = cameraEnt.getComponent<Camera>();
-    //auto cameraPos = cameraEnt.getComponent<Transform>().getWorldPosition();
-
-    //auto& drawList = m_drawLists[camComponent.getDrawListIndex()];
-
-    //for (auto& list : drawList)
-    //{
-    //    list.clear();
-    //}
-
-    //auto passCount = camComponent.reflectionBuffer.available() ? 2 : 1;
-
-    //for (auto p = 0; p < passCount; ++p)
-    //{
-    //    const auto& frustumBounds = camComponent.getPass(p).getAABB();
-    //    auto entities = queryTree(frustumBounds);
-
-    //    for (auto entity : entities)
-    //    {
-    //        auto& model = entity.getComponent<Model>();
-    //        if (model.isHidden())
-    //        {
-    //            continue;
-    //        }
-
-    //        if ((model.m_renderFlags & camComponent.getPass(p).renderFlags) == 0)
-    //        {
-    //            continue;
-    //        }
-
-    //        if (model.m_meshBox != model.m_meshData.boundingBox)
-    //        {
-    //            model.updateBounds();
-    //        }
-
-    //        //use the bounding sphere for depth testing
-    //        auto sphere = model.getBoundingSphere();
-    //        const auto& tx = entity.getComponent<Transform>();
-
-    //        sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre, 1.f));
-    //        auto scale = tx.getScale();
-    //        sphere.radius *= ((scale.x + scale.y + scale.z) / 3.f);
-
-    //        auto direction = (sphere.centre - cameraPos);
-    //        float distance = glm::dot(camComponent.getPass(p).forwardVector, direction);
-
-    //        if (distance < -sphere.radius)
-    //        {
-    //            //model is behind the camera
-    //            continue;
-    //        }
-
-    //        //frustum test
-    //        bool visible = true;
-    //        //if (camComponent.isOrthographic())
-    //        {
-    //            const auto& frustum = camComponent.getPass(p).getFrustum();
-
-    //            visible = true;
-    //            std::size_t j = 0;
-    //            while (visible && j < frustum.size())
-    //            {
-    //                visible = (Spatial::intersects(frustum[j++], sphere) != Planar::Back);
-    //            }
-    //        }
-    //        /*else
-    //        {
-    //            model.m_visible = cro::Util::Frustum::visible(camComponent.getFrustumData(), camComponent.getPass(p).viewMatrix * tx.getWorldTransform(), model.getAABB());
-    //        }*/
-
-    //        //add visible ents to lists for depth sorting
-    //        if (visible)
-    //        {
-    //            auto opaque = std::make_pair(entity, SortData());
-    //            auto transparent = std::make_pair(entity, SortData());
-
-    //            //foreach material
-    //            //add ent/index pair to alpha or opaque list
-    //            for (auto i = 0u; i < model.m_meshData.submeshCount; ++i)
-    //            {
-    //                if (model.m_materials[Mesh::IndexData::Final][i].blendMode != Material::BlendMode::None)
-    //                {
-    //                    transparent.second.matIDs.push_back(static_cast<std::int32_t>(i));
-    //                    transparent.second.flags = static_cast<std::int64_t>(-distance * 1000000.f); //suitably large number to shift decimal point
-    //                    transparent.second.flags += 0x0FFF000000000000; //gaurentees embiggenment so that sorting places transparent last
-    //                }
-    //                else
-    //                {
-    //                    opaque.second.matIDs.push_back(static_cast<std::int32_t>(i));
-    //                    opaque.second.flags = static_cast<std::int64_t>(distance * 1000000.f);
-    //                }
-    //            }
-
-    //            if (!opaque.second.matIDs.empty())
-    //            {
-    //                drawList[p].push_back(opaque);
-    //            }
-
-    //            if (!transparent.second.matIDs.empty())
-    //            {
-    //                drawList[p].push_back(transparent);
-    //            }
-    //        }
-    //    }
-    //}
+    const auto& material = model.m_materials[Mesh::IndexData::Final][matID];
+    if (material.builtInShader == -1)
+    {
+        return -1;
+    }
+
+    const auto type = static_cast<ShaderResource::BuiltIn>(material.builtInShader & BuiltInTypeMask);
+    const auto flags = material.builtInShader & ~BuiltInTypeMask;
+    if ((type != ShaderResource::Unlit && type != ShaderResource::VertexLit && type != ShaderResource::PBR)
+        || (flags & ShaderResource::Skinning))
+    {
+        return -1;
+    }
+
+    const auto vbo = model.m_meshData.vbo;
+    const auto ibo = model.m_meshData.indexData[matID].ibo;
+    const auto vertexSize = model.m_meshData.vertexSize;
+
+    const auto sameMesh = [&](const InstancedMaterial& m)
+    {
+        return m.vbo == vbo
+            && m.ibo == ibo
+            && m.vertexSize == vertexSize
+            && m.source.shader == material.shader;
+    };
+
+    for (auto i = 0u; i < m_instancedMaterials.size(); ++i)
+    {
+        auto& instancedMaterial = m_instancedMaterials[i];
+        if (sameMesh(instancedMaterial)
+            && sameMaterial(instancedMaterial.source, material))
+        {
+            instancedMaterial.lastBuild = m_runBuildID;
+            instancedMaterial.lastFrame = m_frameID;
+            return static_cast<std::int32_t>(i);
+        }
+    }
+
+    //compile the variant the first time it's needed
+    if (std::find(m_failedShaders.begin(), m_failedShaders.end(), material.builtInShader) != m_failedShaders.end())
+    {
+        return -1;
+    }
+
+    if (!m_instancedShaders)
+    {
+        m_instancedShaders = std::make_unique<ShaderResource>();
+    }
+
+    const auto shaderID = m_instancedShaders->loadBuiltIn(type, flags | ShaderResource::Instanced);
+    if (shaderID == -1)
+    {
+        LogW << "Failed creating instanced variant of built in shader " << material.builtInShader << ", models will be drawn individually" << std::endl;
+        m_failedShaders.push_back(material.builtInShader);
+        return -1;
+    }
+    const auto& shader = m_instancedShaders->get(shaderID);
+
+    //a copy for this mesh whose material properties have changed can be
+    //updated in place, as long as it's not already used by another run
+    auto result = std::find_if(m_instancedMaterials.begin(), m_instancedMaterials.end(),
+        [&](const InstancedMaterial& m)
+        {
+            return sameMesh(m) && m.lastBuild != m_runBuildID;
+        });
+
+    const bool newMaterial = result == m_instancedMaterials.end();
+    auto& instancedMaterial = newMaterial ? m_instancedMaterials.emplace_back() : *result;
+    instancedMaterial.source = material;
+    instancedMaterial.material = material;
+    instancedMaterial.material.attribs = {};
+    instancedMaterial.material.setShader(shader);
+    model.bindMaterial(instancedMaterial.material);
+    instancedMaterial.lastBuild = m_runBuildID;
+    instancedMaterial.lastFrame = m_frameID;
+
+    if (newMaterial)
+    {
+        instancedMaterial.vbo = vbo;
+        instancedMaterial.ibo = ibo;
+        instancedMaterial.vertexSize = vertexSize;
+
+        //the attributes are sorted by bindMaterial() so read the instance attributes from the shader
+        instancedMaterial.transformAttrib = shader.getAttribMap()[Shader::AttributeID::InstanceTransform];
+        instancedMaterial.normalAttrib = shader.getAttribMap()[Shader::AttributeID::InstanceNormal];
+
+        glCheck(glGenVertexArrays(1, &instancedMaterial.vao));
+        glCheck(glBindVertexArray(instancedMaterial.vao));
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, vbo));
+        glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo));
+
+        const auto& attribs = instancedMaterial.material.attribs;
+        for (auto j = 0u; j < instancedMaterial.material.attribCount; ++j)
+        {
+            glCheck(glEnableVertexAttribArray(attribs[j][Material::Data::Index]));
+            glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
+                GL_FLOAT, GL_FALSE, static_cast<GLsizei>(vertexSize),
+                reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
+        }
+
+        glCheck(glBindVertexArray(0));
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+    }
+
+    return static_cast<std::int32_t>(std::distance(m_instancedMaterials.data(), &instancedMaterial));
 }
 
-//std::vector<Entity> ModelRenderer::queryTree(Box area) const
-//{
-//    Detail::FixedStack<std::int32_t, 256> stack;
-//    stack.push(m_tree.getRoot());
-//
-//    std::vector<Entity> retVal;
-//    retVal.reserve(256);
-//
-//    while (stack.size() > 0)
-//    {
-//        auto treeID = stack.pop();
-//        if (treeID == Detail::TreeNode::Null)
-//        {
-//            continue;
-//        }
-//
-//        const auto& node = m_tree.getNodes()[treeID];
-//        if (area.intersects(node.fatBounds))
-//        {
-//            if (node.isLeaf() && node.entity.isValid())
-//            {
-//                //we have a candidate, stash
-//                retVal.push_back(node.entity);
-//            }
-//            else
-//            {
-//                stack.push(node.childA);
-//                stack.push(node.childB);
-//            }
-//        }
-//    }
-//    return retVal;
-//}
-
-void ModelRenderer::applyProperties(const Material::Data& material, const Model& model, const Scene& scene, const Camera& camera)
+void ModelRenderer::drawInstanced(const Model& model, std::int32_t matID, const DrawRun& run) const
 {
+    //the instance attributes of the VAO are pointed at this run's data.
+    //All draws with a VAO like this are made through here so it doesn't
+    //matter that the attributes are left enabled.
+    const auto& indexData = model.m_meshData.indexData[matID];
+    const auto offset = run.firstInstance * sizeof(InstanceData);
+
+    std::uint32_t vao = 0;
+    std::int32_t transformIndex = -1;
+    std::int32_t normalIndex = -1;
+    if (run.instancedMaterial == -1)
+    {
+        //the shader of the model's own material has the instance attributes
+        const auto& material = model.m_materials[Mesh::IndexData::Final][matID];
+        vao = model.m_vaos[matID][Mesh::IndexData::Final];
+        transformIndex = material.attribs[Shader::AttributeID::InstanceTransform][Material::Data::Index];
+        normalIndex = material.attribs[Shader::AttributeID::InstanceNormal][Material::Data::Index];
+    }
+    else
+    {
+        const auto& instancedMaterial = m_instancedMaterials[run.instancedMaterial];
+        vao = instancedMaterial.vao;
+        transformIndex = instancedMaterial.transformAttrib;
+        normalIndex = instancedMaterial.normalAttrib;
+    }
+
+    glCheck(glBindVertexArray(vao));
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer));
+
+    //attribs are labelled as mat3/4 in shader but are actually 3*vec3 and 4*vec4
+    for (auto j = 0u; j < 4u; ++j)
+    {
+        glCheck(glEnableVertexAttribArray(transformIndex + j));
+        glCheck(glVertexAttribPointer(transformIndex + j, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+            reinterpret_cast<void*>(static_cast<intptr_t>(offset + (j * sizeof(glm::vec4))))));
+        glCheck(glVertexAttribDivisor(transformIndex + j, 1));
+    }
+
+    if (normalIndex != -1)
+    {
+        for (auto j = 0u; j < 3u; ++j)
+        {
+            glCheck(glEnableVertexAttribArray(normalIndex + j));
+            glCheck(glVertexAttribPointer(normalIndex + j, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                reinterpret_cast<void*>(static_cast<intptr_t>(offset + offsetof(InstanceData, normalMatrix) + (j * sizeof(glm::vec3))))));
+            glCheck(glVertexAttribDivisor(normalIndex + j, 1));
+        }
+    }
+
+    glCheck(glDrawElementsInstanced(static_cast<GLenum>(indexData.primitiveType), indexData.indexCount, static_cast<GLenum>(indexData.format), NULL, static_cast<GLsizei>(run.itemCount)));
+}
+#endif
+
+void ModelRenderer::applyProperties(const Material::Data& material, const Model& model, const Scene& scene, const Camera& camera, Detail::GLStateCache* cache, bool uploadProperties)
+{
+    //a newly created cache has no state so passes everything through
+    Detail::GLStateCache passThrough;
+    auto& state = cache ? *cache : passThrough;
+
+    //textures are always bound as other materials may have used
+    //the same units, but uniform values are kept by the shader so
+    //only need uploading if they're not already applied.
     std::uint32_t currentTextureUnit = 0;
-    for (const auto& prop : material.properties)
+    for (const auto& [uniform, prop] : material.compiledProperties)
     {
-        switch (prop.second.second.type)
+        switch (prop.type)
         {
         default: break;
         case Material::Property::TextureArray:
-            glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
-            glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, prop.second.second.textureID));
-            glCheck(glUniform1i(prop.second.first, currentTextureUnit++));
+            state.bindTexture(currentTextureUnit, GL_TEXTURE_2D_ARRAY, prop.textureID);
+            if (uploadProperties)
+            {
+                glCheck(glUniform1i(uniform, currentTextureUnit));
+            }
+            currentTextureUnit++;
             break;        
         case Material::Property::Texture:
             //TODO textures need to track which unit they're currently bound
             //to so that they don't get bound to multiple units
-            glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
-            glCheck(glBindTexture(GL_TEXTURE_2D, prop.second.second.textureID));
-            glCheck(glUniform1i(prop.second.first, currentTextureUnit++));
+            state.bindTexture(currentTextureUnit, GL_TEXTURE_2D, prop.textureID);
+            if (uploadProperties)
+            {
+                glCheck(glUniform1i(uniform, currentTextureUnit));
+            }
+            currentTextureUnit++;
             break;
         case Material::Property::Cubemap:
-            glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
-            glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP, prop.second.second.textureID));
-            glCheck(glUniform1i(prop.second.first, currentTextureUnit++));
+            state.bindTexture(currentTextureUnit, GL_TEXTURE_CUBE_MAP, prop.textureID);
+            if (uploadProperties)
+            {
+                glCheck(glUniform1i(uniform, currentTextureUnit));
+            }
+            currentTextureUnit++;
             break;
         case Material::Property::CubemapArray:
-            glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
-            glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, prop.second.second.textureID));
-            glCheck(glUniform1i(prop.second.first, currentTextureUnit++));
+            state.bindTexture(currentTextureUnit, GL_TEXTURE_CUBE_MAP_ARRAY, prop.textureID);
+            if (uploadProperties)
+            {
+                glCheck(glUniform1i(uniform, currentTextureUnit));
+            }
+            currentTextureUnit++;
             break;
         case Material::Property::Number:
-            glCheck(glUniform1f(prop.second.first,
-                prop.second.second.numberValue));
+            if (uploadProperties)
+            {
+                glCheck(glUniform1f(uniform, prop.numberValue));
+            }
             break;
         case Material::Property::Vec2:
-            glCheck(glUniform2f(prop.second.first, 
-                prop.second.second.vecValue[0],
-                prop.second.second.vecValue[1]));
+            if (uploadProperties)
+            {
+                glCheck(glUniform2f(uniform, prop.vecValue[0], prop.vecValue[1]));
+            }
             break;
         case Material::Property::Vec3:
-            glCheck(glUniform3f(prop.second.first, prop.second.second.vecValue[0],
-                prop.second.second.vecValue[1], prop.second.second.vecValue[2]));
+            if (uploadProperties)
+            {
+                glCheck(glUniform3f(uniform, prop.vecValue[0], prop.vecValue[1], prop.vecValue[2]));
+            }
             break;
         case Material::Property::Vec4:
-            glCheck(glUniform4f(prop.second.first, prop.second.second.vecValue[0],
-                prop.second.second.vecValue[1], prop.second.second.vecValue[2], prop.second.second.vecValue[3]));
+            if (uploadProperties)
+            {
+                glCheck(glUniform4f(uniform, prop.vecValue[0], prop.vecValue[1], prop.vecValue[2], prop.vecValue[3]));
+            }
             break;
         case Material::Property::Mat4:
-            glCheck(glUniformMatrix4fv(prop.second.first, 1, GL_FALSE, &prop.second.second.matrixValue[0].x));
+            if (uploadProperties)
+            {
+                glCheck(glUniformMatrix4fv(uniform, 1, GL_FALSE, &prop.matrixValue[0].x));
+            }
             break;
         }
     }
@@ -638,8 +1340,7 @@ void ModelRenderer::applyProperties(const Material::Data& material, const Model&
         {
         default: break;
         case Material::SkyBox:
-            glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
-            glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP, scene.getCubemap().textureID));
+            state.bindTexture(currentTextureUnit, GL_TEXTURE_CUBE_MAP, scene.getCubemap().textureID);
             glCheck(glUniform1i(material.uniforms[Material::SkyBox], currentTextureUnit++));
             break;
         case Material::Skinning:
@@ -656,11 +1357,10 @@ void ModelRenderer::applyProperties(const Material::Data& material, const Model&
             glCheck(glUniformMatrix4fv(material.uniforms[Material::ShadowMapProjection], static_cast<GLsizei>(camera.getCascadeCount()), GL_FALSE, &camera.m_shadowViewProjectionMatrices[0][0][0]));
             break;
         case Material::ShadowMapSampler:
-            glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
 #ifdef PLATFORM_DESKTOP
-            glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, camera.shadowMapBuffer.getTexture().textureID));
+            state.bindTexture(currentTextureUnit, GL_TEXTURE_2D_ARRAY, camera.shadowMapBuffer.getTexture().textureID);
 #else
-            glCheck(glBindTexture(GL_TEXTURE_2D, camera.shadowMapBuffer.getTexture().textureID));
+            state.bindTexture(currentTextureUnit, GL_TEXTURE_2D, camera.shadowMapBuffer.getTexture().textureID);
 #endif
             glCheck(glUniform1i(material.uniforms[Material::ShadowMapSampler], currentTextureUnit++));
             break;
@@ -683,13 +1383,11 @@ void ModelRenderer::applyProperties(const Material::Data& material, const Model&
         }
             break;
         case Material::ReflectionMap:
-            glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
-            glCheck(glBindTexture(GL_TEXTURE_2D, camera.reflectionBuffer.getTexture().getGLHandle()));
+            state.bindTexture(currentTextureUnit, GL_TEXTURE_2D, camera.reflectionBuffer.getTexture().getGLHandle());
             glCheck(glUniform1i(material.uniforms[Material::ReflectionMap], currentTextureUnit++));
             break;
         case Material::RefractionMap:
-            glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
-            glCheck(glBindTexture(GL_TEXTURE_2D, camera.refractionBuffer.getTexture().getGLHandle()));
+            state.bindTexture(currentTextureUnit, GL_TEXTURE_2D, camera.refractionBuffer.getTexture().getGLHandle());
             glCheck(glUniform1i(material.uniforms[Material::RefractionMap], currentTextureUnit++));
             break;
         case Material::ReflectionMatrix:
@@ -702,8 +1400,11 @@ void ModelRenderer::applyProperties(const Material::Data& material, const Model&
     }
 }
 
-void ModelRenderer::applyBlendMode(const Material::Data& material)
+void ModelRenderer::applyBlendMode(const Material::Data& material, Detail::GLStateCache* cache)
 {
+    Detail::GLStateCache passThrough;
+    auto& state = cache ? *cache : passThrough;
+
     //face culling is set by material 'double sided' property
 
     switch (material.blendMode)
@@ -713,39 +1414,39 @@ void ModelRenderer::applyBlendMode(const Material::Data& material)
         CRO_ASSERT(!material.blendData.enableProperties.empty(), "You'll probably want at least GL_BLEND and GL_DEPTH_TEST");
         for (auto e : material.blendData.enableProperties)
         {
-            glCheck(glEnable(e));
+            state.setEnabled(e, true);
         }
-        glCheck(glDepthMask(material.blendData.writeDepthMask));
-        glCheck(glBlendFunc(material.blendData.blendFunc[0], material.blendData.blendFunc[1]));
-        glCheck(glBlendEquation(material.blendData.equation));
+        state.setDepthMask(material.blendData.writeDepthMask != 0);
+        state.setBlendFunc(material.blendData.blendFunc[0], material.blendData.blendFunc[1]);
+        state.setBlendEquation(material.blendData.equation);
         break;
     case Material::BlendMode::Additive:
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_FALSE));
-        glCheck(glBlendFunc(GL_ONE, GL_ONE));
-        glCheck(glBlendEquation(GL_FUNC_ADD));
+        state.setEnabled(GL_BLEND, true);
+        state.setEnabled(GL_DEPTH_TEST, true);
+        state.setDepthMask(false);
+        state.setBlendFunc(GL_ONE, GL_ONE);
+        state.setBlendEquation(GL_FUNC_ADD);
         break;
     case Material::BlendMode::Alpha:
         //make sure to test existing depth
         //values, just don't write new ones.
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_FALSE));
-        glCheck(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
-        glCheck(glBlendEquation(GL_FUNC_ADD));
+        state.setEnabled(GL_BLEND, true);
+        state.setEnabled(GL_DEPTH_TEST, true);
+        state.setDepthMask(false);
+        state.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        state.setBlendEquation(GL_FUNC_ADD);
         break;
     case Material::BlendMode::Multiply:
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_FALSE));
-        glCheck(glBlendFunc(GL_DST_COLOR, GL_ZERO));
-        glCheck(glBlendEquation(GL_FUNC_ADD));
+        state.setEnabled(GL_BLEND, true);
+        state.setEnabled(GL_DEPTH_TEST, true);
+        state.setDepthMask(false);
+        state.setBlendFunc(GL_DST_COLOR, GL_ZERO);
+        state.setBlendEquation(GL_FUNC_ADD);
         break;
     case Material::BlendMode::None:
-        glCheck(glDisable(GL_BLEND));
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_TRUE));
+        state.setEnabled(GL_BLEND, false);
+        state.setEnabled(GL_DEPTH_TEST, true);
+        state.setDepthMask(true);
         break;
     }
 }
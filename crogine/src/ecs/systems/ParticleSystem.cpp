@@ -37,11 +37,11 @@ source distribution.
 #include <crogine/core/Clock.hpp>
 #include <crogine/core/App.hpp>
 #include <crogine/core/Console.hpp>
-#include <crogine/util/Random.hpp>
 #include <crogine/util/Constants.hpp>
 #include <crogine/util/Matrix.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/StreamBuffer.hpp"
 
 #include <crogine/detail/glm/gtc/type_ptr.hpp>
 #include <crogine/detail/glm/gtx/norm.hpp>
@@ -50,6 +50,17 @@ source distribution.
 #include <crogine/gui/Gui.hpp>
 #endif
 
+#include <algorithm>
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CRO_PARTICLE_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CRO_PARTICLE_NEON
+#include <arm_neon.h>
+#endif
+
 #ifdef PLATFORM_DESKTOP
 #define ENABLE_POINT_SPRITES glCheck(glEnable(GL_PROGRAM_POINT_SIZE));
 #define DISABLE_POINT_SPRITES glCheck(glDisable(GL_PROGRAM_POINT_SIZE));
@@ -191,10 +202,168 @@ LIGHT_OUT = vec4(vec3(0.0), 1.0);
     )";
 
     constexpr std::size_t MaxVertData = ParticleEmitter::MaxParticles * (3 + 4 + 3); //pos, colour, rotation/scale vert attribs
-    const std::size_t MaxParticleSystems = 128; //max number of VBOs - must be divisible by min count
-    const std::size_t MinParticleSystems = 4; //min amount before resizing - this many added on resize (so don't make too large!!)
     const std::size_t VertexSize = 10 * sizeof(float); //pos, colour, rotation/scale vert attribs
 
+    //emitters are spawned and updated in parallel in batches of at least this many
+    constexpr std::size_t MinBatchSize = 2;
+
+    //per-emitter values which are the same for every particle
+    struct UpdateParams final
+    {
+        float dt = 0.f;
+        float acceleration = 1.f;
+        glm::vec3 velocityDelta = glm::vec3(0.f); //gravity and forces * dt
+        float rotationDelta = 0.f;
+        float scaleMultiplier = 1.f;
+    };
+
+    //updates the velocity, position, lifetime, rotation and scale of
+    //the first count particles four at a time, and expands the given
+    //bounds to contain the updated positions
+    void integrate(Detail::ParticleData& p, std::size_t count, const UpdateParams& params, glm::vec3& minBounds, glm::vec3& maxBounds)
+    {
+        std::size_t i = 0;
+
+#if defined(CRO_PARTICLE_SSE)
+        const auto dt = _mm_set1_ps(params.dt);
+        const auto acceleration = _mm_set1_ps(params.acceleration);
+        const auto deltaX = _mm_set1_ps(params.velocityDelta.x);
+        const auto deltaY = _mm_set1_ps(params.velocityDelta.y);
+        const auto deltaZ = _mm_set1_ps(params.velocityDelta.z);
+        const auto rotationDelta = _mm_set1_ps(params.rotationDelta);
+        const auto scaleMultiplier = _mm_set1_ps(params.scaleMultiplier);
+
+        auto minX = _mm_set1_ps(minBounds.x);
+        auto minY = _mm_set1_ps(minBounds.y);
+        auto minZ = _mm_set1_ps(minBounds.z);
+        auto maxX = _mm_set1_ps(maxBounds.x);
+        auto maxY = _mm_set1_ps(maxBounds.y);
+        auto maxZ = _mm_set1_ps(maxBounds.z);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const auto vx = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&p.velocityX[i]), acceleration), deltaX);
+            const auto vy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&p.velocityY[i]), acceleration), deltaY);
+            const auto vz = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&p.velocityZ[i]), acceleration), deltaZ);
+            _mm_storeu_ps(&p.velocityX[i], vx);
+            _mm_storeu_ps(&p.velocityY[i], vy);
+            _mm_storeu_ps(&p.velocityZ[i], vz);
+
+            const auto x = _mm_add_ps(_mm_loadu_ps(&p.positionX[i]), _mm_mul_ps(vx, dt));
+            const auto y = _mm_add_ps(_mm_loadu_ps(&p.positionY[i]), _mm_mul_ps(vy, dt));
+            const auto z = _mm_add_ps(_mm_loadu_ps(&p.positionZ[i]), _mm_mul_ps(vz, dt));
+            _mm_storeu_ps(&p.positionX[i], x);
+            _mm_storeu_ps(&p.positionY[i], y);
+            _mm_storeu_ps(&p.positionZ[i], z);
+
+            minX = _mm_min_ps(minX, x);
+            minY = _mm_min_ps(minY, y);
+            minZ = _mm_min_ps(minZ, z);
+            maxX = _mm_max_ps(maxX, x);
+            maxY = _mm_max_ps(maxY, y);
+            maxZ = _mm_max_ps(maxZ, z);
+
+            _mm_storeu_ps(&p.lifetime[i], _mm_sub_ps(_mm_loadu_ps(&p.lifetime[i]), dt));
+            _mm_storeu_ps(&p.rotation[i], _mm_add_ps(_mm_loadu_ps(&p.rotation[i]), rotationDelta));
+            _mm_storeu_ps(&p.scale[i], _mm_mul_ps(_mm_loadu_ps(&p.scale[i]), scaleMultiplier));
+        }
+
+        std::array<std::array<float, 4u>, 6u> bounds = {};
+        _mm_storeu_ps(bounds[0].data(), minX);
+        _mm_storeu_ps(bounds[1].data(), minY);
+        _mm_storeu_ps(bounds[2].data(), minZ);
+        _mm_storeu_ps(bounds[3].data(), maxX);
+        _mm_storeu_ps(bounds[4].data(), maxY);
+        _mm_storeu_ps(bounds[5].data(), maxZ);
+#elif defined(CRO_PARTICLE_NEON)
+        const auto dt = vdupq_n_f32(params.dt);
+        const auto acceleration = vdupq_n_f32(params.acceleration);
+        const auto deltaX = vdupq_n_f32(params.velocityDelta.x);
+        const auto deltaY = vdupq_n_f32(params.velocityDelta.y);
+        const auto deltaZ = vdupq_n_f32(params.velocityDelta.z);
+        const auto rotationDelta = vdupq_n_f32(params.rotationDelta);
+        const auto scaleMultiplier = vdupq_n_f32(params.scaleMultiplier);
+
+        auto minX = vdupq_n_f32(minBounds.x);
+        auto minY = vdupq_n_f32(minBounds.y);
+        auto minZ = vdupq_n_f32(minBounds.z);
+        auto maxX = vdupq_n_f32(maxBounds.x);
+        auto maxY = vdupq_n_f32(maxBounds.y);
+        auto maxZ = vdupq_n_f32(maxBounds.z);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const auto vx = vmlaq_f32(deltaX, vld1q_f32(&p.velocityX[i]), acceleration);
+            const auto vy = vmlaq_f32(deltaY, vld1q_f32(&p.velocityY[i]), acceleration);
+            const auto vz = vmlaq_f32(deltaZ, vld1q_f32(&p.velocityZ[i]), acceleration);
+            vst1q_f32(&p.velocityX[i], vx);
+            vst1q_f32(&p.velocityY[i], vy);
+            vst1q_f32(&p.velocityZ[i], vz);
+
+            const auto x = vmlaq_f32(vld1q_f32(&p.positionX[i]), vx, dt);
+            const auto y = vmlaq_f32(vld1q_f32(&p.positionY[i]), vy, dt);
+            const auto z = vmlaq_f32(vld1q_f32(&p.positionZ[i]), vz, dt);
+            vst1q_f32(&p.positionX[i], x);
+            vst1q_f32(&p.positionY[i], y);
+            vst1q_f32(&p.positionZ[i], z);
+
+            minX = vminq_f32(minX, x);
+            minY = vminq_f32(minY, y);
+            minZ = vminq_f32(minZ, z);
+            maxX = vmaxq_f32(maxX, x);
+            maxY = vmaxq_f32(maxY, y);
+            maxZ = vmaxq_f32(maxZ, z);
+
+            vst1q_f32(&p.lifetime[i], vsubq_f32(vld1q_f32(&p.lifetime[i]), dt));
+            vst1q_f32(&p.rotation[i], vaddq_f32(vld1q_f32(&p.rotation[i]), rotationDelta));
+            vst1q_f32(&p.scale[i], vmulq_f32(vld1q_f32(&p.scale[i]), scaleMultiplier));
+        }
+
+        std::array<std::array<float, 4u>, 6u> bounds = {};
+        vst1q_f32(bounds[0].data(), minX);
+        vst1q_f32(bounds[1].data(), minY);
+        vst1q_f32(bounds[2].data(), minZ);
+        vst1q_f32(bounds[3].data(), maxX);
+        vst1q_f32(bounds[4].data(), maxY);
+        vst1q_f32(bounds[5].data(), maxZ);
+#endif
+
+#if defined(CRO_PARTICLE_SSE) || defined(CRO_PARTICLE_NEON)
+        for (auto j = 0u; j < 4u; ++j)
+        {
+            minBounds.x = std::min(minBounds.x, bounds[0][j]);
+            minBounds.y = std::min(minBounds.y, bounds[1][j]);
+            minBounds.z = std::min(minBounds.z, bounds[2][j]);
+            maxBounds.x = std::max(maxBounds.x, bounds[3][j]);
+            maxBounds.y = std::max(maxBounds.y, bounds[4][j]);
+            maxBounds.z = std::max(maxBounds.z, bounds[5][j]);
+        }
+#endif
+
+        //remaining particles, or all of them if there's no SIMD support
+        for (; i < count; ++i)
+        {
+            p.velocityX[i] = (p.velocityX[i] * params.acceleration) + params.velocityDelta.x;
+            p.velocityY[i] = (p.velocityY[i] * params.acceleration) + params.velocityDelta.y;
+            p.velocityZ[i] = (p.velocityZ[i] * params.acceleration) + params.velocityDelta.z;
+
+            p.positionX[i] += p.velocityX[i] * params.dt;
+            p.positionY[i] += p.velocityY[i] * params.dt;
+            p.positionZ[i] += p.velocityZ[i] * params.dt;
+
+            minBounds.x = std::min(minBounds.x, p.positionX[i]);
+            minBounds.y = std::min(minBounds.y, p.positionY[i]);
+            minBounds.z = std::min(minBounds.z, p.positionZ[i]);
+            maxBounds.x = std::max(maxBounds.x, p.positionX[i]);
+            maxBounds.y = std::max(maxBounds.y, p.positionY[i]);
+            maxBounds.z = std::max(maxBounds.z, p.positionZ[i]);
+
+            p.lifetime[i] -= params.dt;
+            p.rotation[i] += params.rotationDelta;
+            p.scale[i] *= params.scaleMultiplier;
+        }
+    }
+
 
     bool inFrustum(const Frustum& frustum, const ParticleEmitter& emitter)
     {
@@ -213,25 +382,17 @@ ParticleSystem::ParticleSystem(MessageBus& mb)
     : System            (mb, typeid(ParticleSystem)),
     m_drawLists         (1),
     m_dataBuffer        (MaxVertData),
-    m_vboIDs            (MaxParticleSystems),
-    m_vaoIDs            (MaxParticleSystems),
-    m_nextBuffer        (0),
-    m_bufferCount       (0)
+    m_vertexBuffer      (std::make_unique<Detail::StreamBuffer>(MaxVertData * sizeof(float))),
+    m_vao               (0),
+    m_vaoBuffer         (0)
 {
-    for (auto& vbo : m_vboIDs)
-    {
-        vbo = 0;
-    }
-
-    //required for core profile on desktop
-    for (auto& vao : m_vaoIDs)
-    {
-        vao = 0;
-    }
-
     requireComponent<Transform>();
     requireComponent<ParticleEmitter>();
 
+    //no access is declared as process() updates vertex buffers, so
+    //must run on the main thread. The emitters are updated in parallel
+    //by process() itself.
+
     const std::array<std::string, ShaderID::Count> Defines =
     {
         "#define SUNLIGHT\n", "#define BLEND_ADD\n", "#define BLEND_MULTIPLY\n"
@@ -293,24 +454,21 @@ ParticleSystem::ParticleSystem(MessageBus& mb)
     cro::Image img;
     img.create(2, 2, cro::Colour::White);
     m_fallbackTexture.loadFromImage(img);
+
+#ifdef PLATFORM_DESKTOP
+    //required for core profile on desktop
+    glCheck(glGenVertexArrays(1, &m_vao));
+    updateVertexArray();
+#endif
 }
 
 ParticleSystem::~ParticleSystem()
 {
-    //delete VBOs
-    for (auto vbo : m_vboIDs)
-    {
-        if (vbo)
-        {
-            glCheck(glDeleteBuffers(1, &vbo));
-        }
-    }
 #ifdef PLATFORM_DESKTOP
-    for (auto vao : m_vaoIDs)
+    if (m_vao)
     {
-        glCheck(glDeleteVertexArrays(1, &vao));
+        glCheck(glDeleteVertexArrays(1, &m_vao));
     }
-
 #endif
 }
 
@@ -373,99 +531,100 @@ void ParticleSystem::process(float dt)
         handle.boundThisFrame = false;
     }*/
 
-    auto& entities = getEntities();
-    for (auto& e : entities/*m_potentiallyVisible*/)
+    //each emitter has its own random number generator so both
+    //spawning and updating can be done in parallel
+    const auto fallbackTexture = m_fallbackTexture.getGLHandle();
+    parallelForEach([dt, fallbackTexture](Entity e)
     {
         //check each emitter to see if it should spawn a new particle
         auto& emitter = e.getComponent<ParticleEmitter>();
+        const auto& settings = emitter.settings;
 
         emitter.m_prevTimestamp = emitter.m_currentTimestamp;
         emitter.m_currentTimestamp += dt;
 
-        const float rate = (1.f / emitter.settings.emitRate); //TODO this ought to be const when rate itself is set...
+        const float rate = (1.f / settings.emitRate); //TODO this ought to be const when rate itself is set...
 
         if (/*emitter.m_pendingUpdate &&*/
             emitter.m_running)
         {
-            auto& tx = e.getComponent<Transform>();
-            glm::quat rotation = glm::quat_cast(tx.getLocalTransform());
-            auto worldPos = tx.getWorldPosition();
+            //apply fallback texture if one doesn't exist
+            //this would be speedier to do once when adding the emitter to the system
+            //but the texture may change at runtime.
+            if (settings.textureID == 0)
+            {
+                emitter.settings.textureID = fallbackTexture;
+            }
+
+            const auto& tx = e.getComponent<Transform>();
+            const glm::quat rotation = glm::quat_cast(tx.getLocalTransform());
+            const auto worldTransform = tx.getWorldTransform();
+            const auto worldPos = tx.getWorldPosition();
+            const auto worldScale = tx.getWorldScale();
+            const auto scale = std::abs((worldScale.x + worldScale.y) / 2.f);
+            const auto offset = settings.spawnOffset * worldScale;
 
             emitter.m_emissionTime += dt;
 
+            auto& rng = emitter.m_randomGenerator;
+            auto& p = emitter.m_particles;
             while (emitter.m_emissionTime > rate)
             {
                 //make sure not to update this again unless it gets marked as visible next frame
                 emitter.m_pendingUpdate = false;
 
-                //apply fallback texture if one doesn't exist
-                //this would be speedier to do once when adding the emitter to the system
-                //but the texture may change at runtime.
-                if (emitter.settings.textureID == 0)
-                {
-                    emitter.settings.textureID = m_fallbackTexture.getGLHandle();
-                }
-
                 emitter.m_emissionTime -= rate;
 
                 //interpolate position
                 emitter.m_emissionTimestamp += rate;
 
                 const float t = (emitter.m_emissionTimestamp - emitter.m_prevTimestamp) / (emitter.m_currentTimestamp - emitter.m_prevTimestamp);
-                auto basePosition = glm::mix(emitter.m_previousPosition, worldPos, t);
+                const auto basePosition = glm::mix(emitter.m_previousPosition, worldPos, t);
 
                 static const float epsilon = 0.0001f;
-                auto emitCount = emitter.settings.emitCount;
+                auto emitCount = settings.emitCount;
                 while (emitCount--)
                 {
-                    if (emitter.m_nextFreeParticle < emitter.m_particles.size() - 1)
+                    if (emitter.m_nextFreeParticle < ParticleEmitter::MaxParticles - 1)
                     {
-                        //TODO a lot of this only needs to be calc'd ONCE for every particle in emitCount
-                        const auto& settings = emitter.settings;
                         CRO_ASSERT(settings.emitRate > 0, "Emit rate must be grater than 0");
                         CRO_ASSERT(settings.lifetime > 0, "Lifetime must be greater than 0");
-                        auto& p = emitter.m_particles[emitter.m_nextFreeParticle];
-                        p.colour = settings.colour;
-                        p.gravity = settings.gravity;
-                        p.lifetime = settings.lifetime + cro::Util::Random::value(-settings.lifetimeVariance, settings.lifetimeVariance + epsilon);
-                        //p.lifetime -= (emitter.m_currentTimestamp - emitter.m_emissionTimestamp);
-                        p.maxLifeTime = p.lifetime;
-                        //p.lifetime *= 1.f - t;
-
-                        auto randRot = glm::rotate(rotation, Util::Random::value(-settings.spread, (settings.spread + epsilon)) * Util::Const::degToRad, Transform::X_AXIS);
-                        randRot = glm::rotate(randRot, Util::Random::value(-settings.spread, (settings.spread + epsilon)) * Util::Const::degToRad, Transform::Z_AXIS);
-
-                        auto worldScale = tx.getWorldScale();
-
-                        p.velocity = randRot * settings.initialVelocity;
-                        p.rotation = (settings.randomInitialRotation) ? Util::Random::value(-Util::Const::PI, Util::Const::PI) : 0.f;
-                        p.scale = std::abs((worldScale.x + worldScale.y) / 2.f);// 1.f;
-                        p.acceleration = settings.acceleration;
-                        p.frameID = (settings.useRandomFrame && settings.frameCount > 1) ? cro::Util::Random::value(0, static_cast<std::int32_t>(settings.frameCount) - 1) : 0;
-                        p.frameTime = 0.f;
-                        p.loopCount = settings.loopCount;
+                        const auto i = emitter.m_nextFreeParticle;
 
-                        //spawn particle in world position
-                        //auto basePosition = worldPos + interpolation;// tx.getWorldPosition();
-                        p.position = basePosition + (settings.initialVelocity * cro::Util::Random::value(0.001f, 0.007f));
+                        p.colour[i] = settings.colour;
+                        p.lifetime[i] = settings.lifetime + rng.value(-settings.lifetimeVariance, settings.lifetimeVariance + epsilon);
+                        p.inverseMaxLifetime[i] = 1.f / p.lifetime[i];
 
-                        //add random radius placement - TODO how to do with a position table? CAN'T HAVE +- 0!!
-                        p.position.x += Util::Random::value(-settings.spawnRadius, settings.spawnRadius + epsilon);
-                        p.position.y += Util::Random::value(-settings.spawnRadius, settings.spawnRadius + epsilon);
-                        p.position.z += Util::Random::value(-settings.spawnRadius, settings.spawnRadius + epsilon);
+                        auto randRot = glm::rotate(rotation, rng.value(-settings.spread, (settings.spread + epsilon)) * Util::Const::degToRad, Transform::X_AXIS);
+                        randRot = glm::rotate(randRot, rng.value(-settings.spread, (settings.spread + epsilon)) * Util::Const::degToRad, Transform::Z_AXIS);
 
-                        if (emitter.settings.inheritRotation)
+                        auto velocity = randRot * settings.initialVelocity;
+                        if (settings.inheritRotation)
                         {
-                            /*p.position -= basePosition;
-                            p.position = rotation * glm::vec4(p.position, 1.f);
-                            p.position += basePosition;*/
-                            p.velocity = glm::vec3(tx.getWorldTransform() * glm::vec4(p.velocity, 0.0));
+                            velocity = glm::vec3(worldTransform * glm::vec4(velocity, 0.0));
                         }
+                        p.velocityX[i] = velocity.x;
+                        p.velocityY[i] = velocity.y;
+                        p.velocityZ[i] = velocity.z;
+
+                        p.rotation[i] = (settings.randomInitialRotation) ? rng.value(-Util::Const::PI, Util::Const::PI) : 0.f;
+                        p.scale[i] = scale;
+                        p.frameID[i] = (settings.useRandomFrame && settings.frameCount > 1) ? rng.value(0, static_cast<std::int32_t>(settings.frameCount) - 1) : 0;
+                        p.frameTime[i] = 0.f;
+                        p.loopCount[i] = settings.loopCount;
+
+                        //spawn particle in world position
+                        auto position = basePosition + (settings.initialVelocity * rng.value(0.001f, 0.007f));
 
-                        auto offset = settings.spawnOffset;
-                        offset *= worldScale;
-                        p.position += offset;
+                        //add random radius placement - TODO how to do with a position table? CAN'T HAVE +- 0!!
+                        position.x += rng.value(-settings.spawnRadius, settings.spawnRadius + epsilon);
+                        position.y += rng.value(-settings.spawnRadius, settings.spawnRadius + epsilon);
+                        position.z += rng.value(-settings.spawnRadius, settings.spawnRadius + epsilon);
+                        position += offset;
 
+                        p.positionX[i] = position.x;
+                        p.positionY[i] = position.y;
+                        p.positionZ[i] = position.z;
 
                         emitter.m_nextFreeParticle++;
                         if (emitter.m_releaseCount > 0)
@@ -483,96 +642,113 @@ void ParticleSystem::process(float dt)
         }
 
         //update each particle
-        glm::vec3 minBounds(std::numeric_limits<float>::max());
-        glm::vec3 maxBounds(0.f);
-
-        float framerate = 1.f / emitter.settings.framerate;
-        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+        auto forces = settings.gravity;
+        for (auto f : settings.forces)
         {
-            auto& p = emitter.m_particles[i];
+            forces += f;
+        }
 
-            p.velocity *= p.acceleration;
-            p.velocity += p.gravity * dt;
-            for (auto f : emitter.settings.forces)
-            {
-                p.velocity += f * dt;
-            }
-            p.position += p.velocity * dt;            
-           
-            p.lifetime -= dt;
-            p.colour.setAlpha(std::min(1.f, std::max(p.lifetime / p.maxLifeTime, 0.f)));
+        UpdateParams params;
+        params.dt = dt;
+        params.acceleration = settings.acceleration;
+        params.velocityDelta = forces * dt;
+        params.rotationDelta = settings.rotationSpeed * dt;
+        params.scaleMultiplier = 1.f + (settings.scaleModifier * dt);
 
-            p.rotation += emitter.settings.rotationSpeed * dt;
-            p.scale += ((p.scale * emitter.settings.scaleModifier) * dt);
+        glm::vec3 minBounds(std::numeric_limits<float>::max());
+        glm::vec3 maxBounds(std::numeric_limits<float>::lowest());
+        integrate(emitter.m_particles, emitter.m_nextFreeParticle, params, minBounds, maxBounds);
+
+        auto dist = (maxBounds - minBounds) / 2.f;
+        emitter.m_bounds.centre = dist + minBounds;
+        emitter.m_bounds.radius = glm::length(dist);
 
-            if (emitter.settings.animate)
+        //animate and remove dead particles with pop/swap
+        auto& p = emitter.m_particles;
+        const float framerate = 1.f / settings.framerate;
+        for (auto i = 0u; i < emitter.m_nextFreeParticle;)
+        {
+            if (settings.animate)
             {
-                p.frameTime += dt;
-                if (p.frameTime > framerate)
+                p.frameTime[i] += dt;
+                if (p.frameTime[i] > framerate)
                 {
-                    p.frameID++;
-                    if (p.frameID == emitter.settings.frameCount
-                        && p.loopCount)
+                    p.frameID[i]++;
+                    if (p.frameID[i] == settings.frameCount
+                        && p.loopCount[i])
                     {
-                        p.loopCount--;
-                        p.frameID = 0;
+                        p.loopCount[i]--;
+                        p.frameID[i] = 0;
                     }
-                    p.frameTime -= framerate;
+                    p.frameTime[i] -= framerate;
                 }
             }
 
-            //update bounds for culling
-            if (p.position.x < minBounds.x) minBounds.x = p.position.x;
-            if (p.position.y < minBounds.y) minBounds.y = p.position.y;
-            if (p.position.z < minBounds.z) minBounds.z = p.position.z;
-
-            if (p.position.x > maxBounds.x) maxBounds.x = p.position.x;
-            if (p.position.y > maxBounds.y) maxBounds.y = p.position.y;
-            if (p.position.z > maxBounds.z) maxBounds.z = p.position.z;
-        }
-        auto dist = (maxBounds - minBounds) / 2.f;
-        emitter.m_bounds.centre = dist + minBounds;
-        emitter.m_bounds.radius = glm::length(dist);
-
-        //go over again and remove dead particles with pop/swap
-        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
-        {
-            if (emitter.m_particles[i].lifetime < 0
-                || ((emitter.m_particles[i].frameID == emitter.settings.frameCount)
-                    && (emitter.m_particles[i].loopCount == 0)))
+            if (p.lifetime[i] < 0
+                || ((p.frameID[i] == settings.frameCount)
+                    && (p.loopCount[i] == 0)))
             {
                 emitter.m_nextFreeParticle--;
-                std::swap(emitter.m_particles[i], emitter.m_particles[emitter.m_nextFreeParticle]);                
+                p.copy(emitter.m_nextFreeParticle, i);
+            }
+            else
+            {
+                ++i;
             }
         }
         //DPRINT("Next free Particle", std::to_string(emitter.m_nextFreeParticle));
+    }, MinBatchSize);
+
+    //vertex data is uploaded on this thread as it requires the GL context
+    auto& entities = getEntities();
+    std::size_t requiredSize = VertexSize; //allow for aligning the first write
+    for (const auto& e : entities)
+    {
+        requiredSize += e.getComponent<ParticleEmitter>().m_nextFreeParticle * VertexSize;
+    }
+    m_vertexBuffer->beginFrame(requiredSize);
+
+#ifdef PLATFORM_DESKTOP
+    //the buffer is recreated if it needed to grow
+    if (m_vertexBuffer->getHandle() != m_vaoBuffer)
+    {
+        updateVertexArray();
+    }
+#endif
+
+    for (auto& e : entities)
+    {
+        auto& emitter = e.getComponent<ParticleEmitter>();
 
         //TODO sort verts by depth? should be drawing back to front for transparency really.
 
         //update VBO
         std::size_t idx = 0;
+        const auto& p = emitter.m_particles;
         for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
         {
-            const auto& p = emitter.m_particles[i];
-
             //position
-            m_dataBuffer[idx++] = p.position.x;
-            m_dataBuffer[idx++] = p.position.y;
-            m_dataBuffer[idx++] = p.position.z;
+            m_dataBuffer[idx++] = p.positionX[i];
+            m_dataBuffer[idx++] = p.positionY[i];
+            m_dataBuffer[idx++] = p.positionZ[i];
 
             //colour
-            m_dataBuffer[idx++] = p.colour.getRed();
-            m_dataBuffer[idx++] = p.colour.getGreen();
-            m_dataBuffer[idx++] = p.colour.getBlue();
-            m_dataBuffer[idx++] = p.colour.getAlpha();
+            m_dataBuffer[idx++] = p.colour[i].getRed();
+            m_dataBuffer[idx++] = p.colour[i].getGreen();
+            m_dataBuffer[idx++] = p.colour[i].getBlue();
+            m_dataBuffer[idx++] = std::min(1.f, std::max(p.lifetime[i] * p.inverseMaxLifetime[i], 0.f));
 
             //rotation/size/animation
-            m_dataBuffer[idx++] = p.rotation * Util::Const::degToRad;
-            m_dataBuffer[idx++] = p.scale;
-            m_dataBuffer[idx++] = static_cast<float>(p.frameID);
+            m_dataBuffer[idx++] = p.rotation[i] * Util::Const::degToRad;
+            m_dataBuffer[idx++] = p.scale[i];
+            m_dataBuffer[idx++] = static_cast<float>(p.frameID[i]);
+        }
+        if (idx != 0)
+        {
+            const auto offset = m_vertexBuffer->write(m_dataBuffer.data(), idx * sizeof(float), VertexSize);
+            CRO_ASSERT(offset != Detail::StreamBuffer::NoSpace, "Particle vertex buffer too small");
+            emitter.m_firstVertex = static_cast<std::int32_t>(offset / VertexSize);
         }
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, emitter.m_vbo));
-        glCheck(glBufferSubData(GL_ARRAY_BUFFER, 0, idx * sizeof(float), m_dataBuffer.data()));
 
         emitter.m_previousPosition = e.getComponent<cro::Transform>().getWorldPosition();
     }
@@ -631,7 +807,19 @@ void ParticleSystem::render(Entity camera, const RenderTarget& rt)
         };
         glCheck(glActiveTexture(GL_TEXTURE0));
 
-
+        //all emitters draw from the same buffer, at different offsets
+#ifdef PLATFORM_DESKTOP
+        glCheck(glBindVertexArray(m_vao));
+#else
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer->getHandle()));
+        for (auto [index, attribSize, offset] : m_shaderHandles[0].attribData)
+        {
+            glCheck(glEnableVertexAttribArray(index));
+            glCheck(glVertexAttribPointer(index, attribSize,
+                GL_FLOAT, GL_FALSE, VertexSize,
+                reinterpret_cast<void*>(static_cast<intptr_t>(offset))));
+        }
+#endif //PLATFORM
 
         const auto& entities = m_drawLists[cam.getDrawListIndex()][cam.getActivePassIndex()];
         for (auto entity : entities)
@@ -667,37 +855,16 @@ void ParticleSystem::render(Entity camera, const RenderTarget& rt)
             //bind emitter texture
             glCheck(glBindTexture(GL_TEXTURE_2D, emitter.settings.textureID));
 
-
-#ifdef PLATFORM_DESKTOP
-            glCheck(glBindVertexArray(emitter.m_vao));
-            glCheck(glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(emitter.m_nextFreeParticle)));
-#else
-            //bind emitter vbo
-            glCheck(glBindBuffer(GL_ARRAY_BUFFER, emitter.m_vbo));
-
-            //bind vertex attribs
-            for (auto [index, attribSize, offset] : m_shaderHandles[0].attribData)
-            {
-                glCheck(glEnableVertexAttribArray(index));
-                glCheck(glVertexAttribPointer(index, attribSize,
-                    GL_FLOAT, GL_FALSE, VertexSize,
-                    reinterpret_cast<void*>(static_cast<intptr_t>(offset))));
-            }
-
-            //draw
-            glCheck(glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(emitter.m_nextFreeParticle)));
-
-            //unbind attribs
-            for (auto j = 0u; j < m_shaderHandles[0].attribData.size(); ++j)
-            {
-                glCheck(glDisableVertexAttribArray(m_shaderHandles[0].attribData[j].index));
-            }
-#endif //PLATFORM
+            glCheck(glDrawArrays(GL_POINTS, emitter.m_firstVertex, static_cast<GLsizei>(emitter.m_nextFreeParticle)));
         }
 
 #ifdef PLATFORM_DESKTOP
         glCheck(glBindVertexArray(0));
 #else
+        for (const auto& attrib : m_shaderHandles[0].attribData)
+        {
+            glCheck(glDisableVertexAttribArray(attrib.index));
+        }
         glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
 #endif //PLATFORM
 
@@ -718,57 +885,18 @@ void ParticleSystem::render(Entity camera, const RenderTarget& rt)
 //private
 void ParticleSystem::onEntityAdded(Entity entity)
 {    
-    //check VBO count and increase if needed
-    if (m_nextBuffer == m_bufferCount)
-    {
-        for (auto i = 0u; i < MinParticleSystems; ++i)
-        {
-            allocateBuffer();
-        }
-    }
-
     auto pos = entity.getComponent<cro::Transform>().getWorldPosition();
     entity.getComponent<cro::ParticleEmitter>().m_previousPosition = pos;
-
-    entity.getComponent<ParticleEmitter>().m_vbo = m_vboIDs[m_nextBuffer];
-    entity.getComponent<ParticleEmitter>().m_vao = m_vaoIDs[m_nextBuffer];
-    m_nextBuffer++;
-}
-
-void ParticleSystem::onEntityRemoved(Entity entity)
-{
-    auto vboID = entity.getComponent<ParticleEmitter>().m_vbo;
-    auto vaoID = entity.getComponent<ParticleEmitter>().m_vao;
-    
-    //update available VBOs
-    std::size_t idx = 0;
-    while (m_vboIDs[idx] != vboID) { idx++; }
-
-    std::swap(m_vboIDs[idx], m_vboIDs[m_nextBuffer]);
-
-    //and vaos
-    idx = 0;
-    while (m_vaoIDs[idx] != vaoID) { idx++; }
-
-    std::swap(m_vaoIDs[idx], m_vaoIDs[m_nextBuffer]);
-
-    m_nextBuffer--;
 }
 
-void ParticleSystem::allocateBuffer()
+void ParticleSystem::updateVertexArray()
 {
-    CRO_ASSERT(m_bufferCount < m_vboIDs.size(), "Max Buffers Reached!");
-    glCheck(glGenBuffers(1, &m_vboIDs[m_bufferCount]));
-
 #ifdef PLATFORM_DESKTOP
-    glCheck(glGenVertexArrays(1, &m_vaoIDs[m_bufferCount]));
-    glCheck(glBindVertexArray(m_vaoIDs[m_bufferCount]));
-#endif //PLATFORM
+    m_vaoBuffer = m_vertexBuffer->getHandle();
 
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vboIDs[m_bufferCount]));
-    glCheck(glBufferData(GL_ARRAY_BUFFER, MaxVertData * sizeof(float), nullptr, GL_DYNAMIC_DRAW));
+    glCheck(glBindVertexArray(m_vao));
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vaoBuffer));
 
-#ifdef PLATFORM_DESKTOP
     //HMMMMMMM this only works because all the shaders use the same vertex shader
     for(auto [index, attribSize, offset] : m_shaderHandles[0].attribData)
     {
@@ -779,9 +907,6 @@ void ParticleSystem::allocateBuffer()
     }
 
     glCheck(glBindVertexArray(0));
-#endif //PLATFORM
-
     glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
-
-    m_bufferCount++;
+#endif //PLATFORM
 }
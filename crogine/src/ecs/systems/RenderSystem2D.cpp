@@ -39,6 +39,7 @@ source distribution.
 #include <crogine/core/Console.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/StreamBuffer.hpp"
 #include "../../graphics/shaders/Sprite.hpp"
 
 #include <string>
@@ -52,15 +53,44 @@ namespace
     //    100.f,0.f,  0.f,0.f, 1.f,0.f,0.f,1.f,
     //    100.f,100.f,  0.f,0.f, 1.f,0.f,0.f,1.f,
     //};
+
+    static_assert(sizeof(cro::Vertex2D) == cro::Vertex2D::Size, "Batched vertices are copied directly");
+
+    //initial size of the batch buffer, it grows as necessary
+    constexpr std::size_t BatchBufferSize = 16384 * cro::Vertex2D::Size;
+
+    //drawables are transformed in parallel in batches of at least this many
+    constexpr std::size_t MinBatchSize = 32;
+
+    //the batch shaders use the same vertex attributes as any other Drawable2D
+    struct BatchAttrib final
+    {
+        std::int32_t id = -1;
+        std::int32_t size = 0;
+        std::uint32_t offset = 0;
+    };
+
+    std::array<BatchAttrib, 3u> getBatchAttribs(const cro::Shader& shader)
+    {
+        const auto& attribs = shader.getAttribMap();
+        return
+        {
+            BatchAttrib{ attribs[cro::Mesh::Attribute::Position], 2, 0 },
+            BatchAttrib{ attribs[cro::Mesh::Attribute::UV0], 2, 2 * sizeof(float) },
+            BatchAttrib{ attribs[cro::Mesh::Attribute::Colour], 4, 4 * sizeof(float) }
+        };
+    }
 }
 
 using namespace cro;
 
 RenderSystem2D::RenderSystem2D(MessageBus& mb)
-    : System        (mb, typeid(RenderSystem2D)),
-    m_sortOrder     (DepthAxis::Z),
-    m_needsSort     (true),
-    m_drawLists     (1)
+    : System            (mb, typeid(RenderSystem2D)),
+    m_sortOrder         (DepthAxis::Z),
+    m_needsSort         (true),
+    m_drawLists         (1),
+    m_batchingEnabled   (false),
+    m_batchVAOBuffer    (0)
 {
     requireComponent<Drawable2D>();
     requireComponent<Transform>();
@@ -68,6 +98,25 @@ RenderSystem2D::RenderSystem2D(MessageBus& mb)
     //load default shaders
     m_colouredShader.loadFromString(Shaders::Sprite::Vertex, Shaders::Sprite::Coloured);
     m_texturedShader.loadFromString(Shaders::Sprite::Vertex, Shaders::Sprite::Textured, "#define TEXTURED\n");
+
+    m_batchShaders[0].shader = &m_colouredShader;
+    m_batchShaders[1].shader = &m_texturedShader;
+    for (auto& batchShader : m_batchShaders)
+    {
+        const auto& uniforms = batchShader.shader->getUniformMap();
+        if (uniforms.count("u_worldMatrix"))
+        {
+            batchShader.worldUniform = uniforms.at("u_worldMatrix");
+        }
+        if (uniforms.count("u_viewProjectionMatrix"))
+        {
+            batchShader.viewProjectionUniform = uniforms.at("u_viewProjectionMatrix");
+        }
+        if (uniforms.count("u_texture"))
+        {
+            batchShader.textureUniform = uniforms.at("u_texture");
+        }
+    }
 }
 
 RenderSystem2D::~RenderSystem2D()
@@ -78,6 +127,16 @@ RenderSystem2D::~RenderSystem2D()
     {
         resetDrawable(entity);
     }
+
+#ifdef PLATFORM_DESKTOP
+    for (const auto& batchShader : m_batchShaders)
+    {
+        if (batchShader.vao)
+        {
+            glCheck(glDeleteVertexArrays(1, &batchShader.vao));
+        }
+    }
+#endif
 }
 
 //public
@@ -165,17 +224,6 @@ void RenderSystem2D::process(float)
             drawable.applyShader();
         }
 
-        //check data flag and update buffer if needed
-        if (drawable.m_updateBufferData)
-        {
-            //bind VBO and upload data
-            glCheck(glBindBuffer(GL_ARRAY_BUFFER, drawable.m_vbo));
-            glCheck(glBufferData(GL_ARRAY_BUFFER, drawable.m_vertices.size() * Vertex2D::Size, drawable.m_vertices.data(), GL_DYNAMIC_DRAW));
-            glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
-
-            drawable.m_updateBufferData = false;
-        }
-
         const auto& tx = entity.getComponent<Transform>();
         auto pos = tx.getWorldPosition();
 
@@ -200,6 +248,31 @@ void RenderSystem2D::process(float)
         {
             drawable.m_croppingWorldArea = drawable.m_croppingArea.transform(tx.getWorldTransform());
         }
+
+        //check data flag and update buffer if needed. Batched drawables
+        //are streamed from their vertex data each frame so skip the upload
+        if (drawable.m_updateBufferData
+            && !(m_batchingEnabled && canBatch(drawable)))
+        {
+            //bind VBO and upload data. The buffer is only reallocated
+            //if it grows, with some room to spare, so that frequently
+            //updated drawables such as Text can update it in place
+            const auto size = drawable.m_vertices.size() * Vertex2D::Size;
+            glCheck(glBindBuffer(GL_ARRAY_BUFFER, drawable.m_vbo));
+            if (size > drawable.m_vboSize)
+            {
+                drawable.m_vboSize = size + (size / 2);
+                glCheck(glBufferData(GL_ARRAY_BUFFER, drawable.m_vboSize, nullptr, GL_DYNAMIC_DRAW));
+            }
+
+            if (size != 0)
+            {
+                glCheck(glBufferSubData(GL_ARRAY_BUFFER, 0, size, drawable.m_vertices.data()));
+            }
+            glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+
+            drawable.m_updateBufferData = false;
+        }
     }
 
     //for (auto& list : m_drawLists)
@@ -224,131 +297,81 @@ void RenderSystem2D::render(Entity cameraEntity, const RenderTarget& rt)
         std::uint32_t lastProgram = 0;
 
         const auto& entities = m_drawLists[camComponent.getDrawListIndex()];
-        for (auto entity : entities)
+        if (m_batchingEnabled)
         {
-#ifdef CRO_DEBUG_
-            //these are probably OK to draw as they aren't yet cleared up
-            //(just marked for removal) but it will ASSERT on debug builds
-            if (!entity.isValid()) continue;
-#endif
-
-            const auto& drawable = entity.getComponent<Drawable2D>();
-            const auto& tx = entity.getComponent<cro::Transform>();
-            glm::mat4 worldMat = tx.getWorldTransform();
+            updateBatches(entities);
+            const auto bufferOffset = uploadBatches();
+            const auto rtSize = rt.getSize();
 
-            if (//TODO surely these ought to be culling criteria?
-                drawable.m_shader && !drawable.m_updateBufferData)
+            for (const auto& batch : m_batches)
             {
-                //apply shader
-                auto program = drawable.m_shader->getGLHandle();
-                if (program != lastProgram)
-                {
-                    glCheck(glUseProgram(program));
-                    lastProgram = program;
-                }
-                //glCheck(glUniformMatrix4fv(drawable.m_worldUniform, 1, GL_FALSE, &(worldMat[0].x)));
-                glCheck(glUniformMatrix4fv(drawable.m_viewProjectionUniform, 1, GL_FALSE, glm::value_ptr(pass.viewProjectionMatrix)));
-                glCheck(glUniformMatrix4fv(drawable.m_worldUniform, 1, GL_FALSE, glm::value_ptr(worldMat)));
-
-                //apply texture if active
-                if (drawable.m_textureInfo.textureID.textureID)
+                if (batch.vertexCount == 0)
                 {
-                    glCheck(glActiveTexture(GL_TEXTURE0));
-                    glCheck(glBindTexture(GL_TEXTURE_2D, drawable.m_textureInfo.textureID.textureID));
-                    glCheck(glUniform1i(drawable.m_textureUniform, 0));
+                    drawSingle(batch.entity, pass.viewProjectionMatrix, viewport, rt, lastProgram);
+                    continue;
                 }
 
-                //apply any custom uniforms
-                std::int32_t j = 1;
-                for (const auto& [uniform, value] : drawable.m_textureIDBindings)
-                {
-                    glCheck(glActiveTexture(GL_TEXTURE0 + j));
-                    glCheck(glBindTexture(GL_TEXTURE_2D, value));
-                    glCheck(glUniform1i(uniform, j));
-                    j++;
-                }
-                for (auto [uniform, value] : drawable.m_floatBindings)
-                {
-                    glCheck(glUniform1f(uniform, value));
-                }
-                for (auto [uniform, value] : drawable.m_vec2Bindings)
-                {
-                    glCheck(glUniform2f(uniform, value.x, value.y));
-                }
-                for (auto [uniform, value] : drawable.m_vec3Bindings)
-                {
-                    glCheck(glUniform3f(uniform, value.x, value.y, value.z));
-                }
-                for (auto [uniform, value] : drawable.m_vec4Bindings)
-                {
-                    glCheck(glUniform4f(uniform, value.r, value.g, value.b, value.a));
-                }
-                for (auto [uniform, value] : drawable.m_boolBindings)
-                {
-                    glCheck(glUniform1i(uniform, value));
-                }
-                for (const auto& [uniform, value] : drawable.m_matBindings)
+                const auto& batchShader = m_batchShaders[batch.shaderIndex];
+                auto program = batchShader.shader->getGLHandle();
+                if (program != lastProgram)
                 {
-                    glCheck(glUniformMatrix4fv(uniform, 1, GL_FALSE, value));
+                    glCheck(glUseProgram(program));
+                    lastProgram = program;
                 }
 
-                applyBlendMode(drawable.m_blendMode);
-
-                if (drawable.m_cropped)
-                {
-                    //convert cropping area to target coords (remember this might not be a window!)
-                    glm::vec2 start(drawable.m_croppingWorldArea.left, drawable.m_croppingWorldArea.bottom);
-                    glm::vec2 end(start.x + drawable.m_croppingWorldArea.width, start.y + drawable.m_croppingWorldArea.height);
-
-                    auto scissorStart = mapCoordsToPixel(start, pass.viewProjectionMatrix, viewport);
-                    auto scissorEnd = mapCoordsToPixel(end, pass.viewProjectionMatrix, viewport);
-
-                    scissorStart.x = std::clamp(scissorStart.x, 0, viewport.width - 1);
-                    scissorStart.y = std::clamp(scissorStart.y, 0, viewport.height - 1);
-
-                    scissorEnd.x = std::clamp(scissorEnd.x, scissorStart.x, viewport.width);
-                    scissorEnd.y = std::clamp(scissorEnd.y, scissorStart.y, viewport.height);
+                //vertices are already in world space
+                static const glm::mat4 identity(1.f);
+                glCheck(glUniformMatrix4fv(batchShader.viewProjectionUniform, 1, GL_FALSE, glm::value_ptr(pass.viewProjectionMatrix)));
+                glCheck(glUniformMatrix4fv(batchShader.worldUniform, 1, GL_FALSE, glm::value_ptr(identity)));
 
-                    auto w = scissorEnd.x - scissorStart.x;
-                    auto h = scissorEnd.y - scissorStart.y;
-
-                    glCheck(glScissor(scissorStart.x, scissorStart.y, w, h));
-                }
-                else
+                if (batch.textureID)
                 {
-                    auto rtSize = rt.getSize();
-                    glCheck(glScissor(0, 0, rtSize.x, rtSize.y));
+                    glCheck(glActiveTexture(GL_TEXTURE0));
+                    glCheck(glBindTexture(GL_TEXTURE_2D, batch.textureID));
+                    glCheck(glUniform1i(batchShader.textureUniform, 0));
                 }
 
-                glCheck(glFrontFace(drawable.m_facing));
+                applyBlendMode(batch.blendMode);
+                glCheck(glScissor(0, 0, rtSize.x, rtSize.y));
+                glCheck(glFrontFace(batch.facing));
 
+                const auto first = static_cast<GLint>(bufferOffset + batch.firstVertex);
+                const auto count = static_cast<GLsizei>(batch.vertexCount);
 #ifdef PLATFORM_DESKTOP
-                glCheck(glBindVertexArray(drawable.m_vao));
-                glCheck(glDrawArrays(static_cast<GLenum>(drawable.m_primitiveType), 0, static_cast<GLsizei>(drawable.m_vertices.size())));
-
-#else //GLES 2 doesn't have VAO support without extensions
-                glCheck(glBindBuffer(GL_ARRAY_BUFFER, drawable.m_vbo));
+                glCheck(glBindVertexArray(batchShader.vao));
+                glCheck(glDrawArrays(GL_TRIANGLES, first, count));
+#else
+                glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_batchBuffer->getHandle()));
 
-                //bind attribs
-                //const auto& attribs = drawable.m_vertexAttribs;
-                for (const auto& [id, size, offset] : drawable.m_vertexAttributes)
+                const auto attribs = getBatchAttribs(*batchShader.shader);
+                for (const auto& [id, size, offset] : attribs)
                 {
-                    glCheck(glEnableVertexAttribArray(id));
-                    glCheck(glVertexAttribPointer(id, size,
-                        GL_FLOAT, GL_FALSE, static_cast<GLsizei>(Vertex2D::Size),
-                        reinterpret_cast<void*>(static_cast<intptr_t>(offset))));
+                    if (id != -1)
+                    {
+                        glCheck(glEnableVertexAttribArray(id));
+                        glCheck(glVertexAttribPointer(id, size,
+                            GL_FLOAT, GL_FALSE, static_cast<GLsizei>(Vertex2D::Size),
+                            reinterpret_cast<void*>(static_cast<intptr_t>(offset))));
+                    }
                 }
 
-                //draw array
-                glCheck(glDrawArrays(static_cast<GLenum>(drawable.m_primitiveType), 0, drawable.m_vertices.size()));
+                glCheck(glDrawArrays(GL_TRIANGLES, first, count));
 
-                //and unbind... this could be saved by only changing when switching shader
-                for (const auto& attrib : drawable.m_vertexAttributes)
+                for (const auto& attrib : attribs)
                 {
-                    glCheck(glDisableVertexAttribArray(attrib.id));
+                    if (attrib.id != -1)
+                    {
+                        glCheck(glDisableVertexAttribArray(attrib.id));
+                    }
                 }
-
-#endif //PLATFORM 
+#endif //PLATFORM
+            }
+        }
+        else
+        {
+            for (auto entity : entities)
+            {
+                drawSingle(entity, pass.viewProjectionMatrix, viewport, rt, lastProgram);
             }
         }
 
@@ -378,6 +401,26 @@ const std::string& RenderSystem2D::getDefaultVertexShader()
     return Shaders::Sprite::Vertex;
 }
 
+void RenderSystem2D::setBatchingEnabled(bool enabled)
+{
+    m_batchingEnabled = enabled;
+
+    if (enabled && !m_batchBuffer)
+    {
+        m_batchBuffer = std::make_unique<Detail::StreamBuffer>(BatchBufferSize);
+#ifdef PLATFORM_DESKTOP
+        updateBatchVAOs();
+#endif
+    }
+
+    //drawables which were skipped while batching need uploading again
+    const auto& entities = getEntities();
+    for (auto entity : entities)
+    {
+        entity.getComponent<Drawable2D>().m_updateBufferData = true;
+    }
+}
+
 //private
 void RenderSystem2D::applyBlendMode(Material::BlendMode blendMode)
 {
@@ -415,6 +458,324 @@ glm::ivec2 RenderSystem2D::mapCoordsToPixel(glm::vec2 coord, const glm::mat4& vi
     return retVal;
 }
 
+bool RenderSystem2D::canBatch(const Drawable2D& drawable) const
+{
+    return (drawable.m_shader == &m_colouredShader || drawable.m_shader == &m_texturedShader)
+        && !drawable.m_cropped
+        && (drawable.m_primitiveType == GL_TRIANGLES || drawable.m_primitiveType == GL_TRIANGLE_STRIP)
+        && drawable.m_textureIDBindings.empty()
+        && drawable.m_floatBindings.empty()
+        && drawable.m_vec2Bindings.empty()
+        && drawable.m_vec3Bindings.empty()
+        && drawable.m_vec4Bindings.empty()
+        && drawable.m_boolBindings.empty()
+        && drawable.m_matBindings.empty();
+}
+
+void RenderSystem2D::updateBatches(const std::vector<Entity>& entities)
+{
+    m_batches.clear();
+    m_batchedEntities.clear();
+    m_batchedOffsets.clear();
+
+    //merge consecutive drawables with the same state, preserving the draw order
+    std::size_t vertexCount = 0;
+    for (auto entity : entities)
+    {
+#ifdef CRO_DEBUG_
+        if (!entity.isValid()) continue;
+#endif
+
+        const auto& drawable = entity.getComponent<Drawable2D>();
+        if (!drawable.m_shader)
+        {
+            continue;
+        }
+
+        if (!canBatch(drawable))
+        {
+            m_batches.emplace_back().entity = entity;
+            continue;
+        }
+
+        //triangle strips are converted to triangles so that they can be merged
+        const auto size = drawable.m_vertices.size();
+        const auto count = drawable.m_primitiveType == GL_TRIANGLES ?
+            size - (size % 3) :
+            size > 2 ? (size - 2) * 3 : 0;
+
+        if (count == 0)
+        {
+            continue;
+        }
+
+        const std::size_t shaderIndex = drawable.m_textureInfo.textureID.textureID ? 1 : 0;
+        if (!m_batches.empty()
+            && m_batches.back().vertexCount != 0
+            && m_batches.back().shaderIndex == shaderIndex
+            && m_batches.back().textureID == drawable.m_textureInfo.textureID.textureID
+            && m_batches.back().blendMode == drawable.m_blendMode
+            && m_batches.back().facing == drawable.m_facing)
+        {
+            m_batches.back().vertexCount += count;
+        }
+        else
+        {
+            auto& batch = m_batches.emplace_back();
+            batch.entity = entity;
+            batch.shaderIndex = shaderIndex;
+            batch.textureID = drawable.m_textureInfo.textureID.textureID;
+            batch.blendMode = drawable.m_blendMode;
+            batch.facing = drawable.m_facing;
+            batch.firstVertex = vertexCount;
+            batch.vertexCount = count;
+        }
+
+        m_batchedEntities.push_back(entity);
+        m_batchedOffsets.push_back(vertexCount);
+        vertexCount += count;
+    }
+
+    m_batchVertices.resize(vertexCount);
+
+    //each drawable writes to its own range of vertices so can be transformed in parallel
+    parallelFor(m_batchedEntities.size(),
+        [&](std::size_t, std::size_t begin, std::size_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                auto entity = m_batchedEntities[i];
+                const auto& drawable = entity.getComponent<Drawable2D>();
+                const auto& worldMat = entity.getComponent<Transform>().getWorldTransform();
+
+                const auto transform = [&worldMat](Vertex2D vertex)
+                {
+                    vertex.position = glm::vec2(worldMat * glm::vec4(vertex.position, 0.f, 1.f));
+                    return vertex;
+                };
+
+                const auto& src = drawable.m_vertices;
+                auto* dst = m_batchVertices.data() + m_batchedOffsets[i];
+
+                if (drawable.m_primitiveType == GL_TRIANGLES)
+                {
+                    const auto count = src.size() - (src.size() % 3);
+                    for (auto j = 0u; j < count; ++j)
+                    {
+                        *dst++ = transform(src[j]);
+                    }
+                }
+                else
+                {
+                    for (auto j = 0u; j + 2 < src.size(); ++j)
+                    {
+                        //every other triangle in a strip has reversed winding
+                        if (j % 2 == 0)
+                        {
+                            dst[0] = transform(src[j]);
+                            dst[1] = transform(src[j + 1]);
+                        }
+                        else
+                        {
+                            dst[0] = transform(src[j + 1]);
+                            dst[1] = transform(src[j]);
+                        }
+                        dst[2] = transform(src[j + 2]);
+                        dst += 3;
+                    }
+                }
+            }
+        }, MinBatchSize);
+}
+
+std::size_t RenderSystem2D::uploadBatches()
+{
+    if (m_batchVertices.empty())
+    {
+        return 0;
+    }
+
+    const auto size = m_batchVertices.size() * Vertex2D::Size;
+    auto offset = m_batchBuffer->write(m_batchVertices.data(), size, Vertex2D::Size);
+
+    if (offset == Detail::StreamBuffer::NoSpace)
+    {
+        //move to the next region of the buffer, which grows it if needed
+        m_batchBuffer->beginFrame(size + Vertex2D::Size);
+        offset = m_batchBuffer->write(m_batchVertices.data(), size, Vertex2D::Size);
+        CRO_ASSERT(offset != Detail::StreamBuffer::NoSpace, "Batch buffer too small");
+    }
+
+#ifdef PLATFORM_DESKTOP
+    if (m_batchBuffer->getHandle() != m_batchVAOBuffer)
+    {
+        updateBatchVAOs();
+    }
+#endif
+
+    return offset / Vertex2D::Size;
+}
+
+void RenderSystem2D::updateBatchVAOs()
+{
+#ifdef PLATFORM_DESKTOP
+    m_batchVAOBuffer = m_batchBuffer->getHandle();
+
+    for (auto& batchShader : m_batchShaders)
+    {
+        if (batchShader.vao == 0)
+        {
+            glCheck(glGenVertexArrays(1, &batchShader.vao));
+        }
+
+        glCheck(glBindVertexArray(batchShader.vao));
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_batchVAOBuffer));
+
+        for (const auto& [id, size, offset] : getBatchAttribs(*batchShader.shader))
+        {
+            if (id != -1)
+            {
+                glCheck(glEnableVertexAttribArray(id));
+                glCheck(glVertexAttribPointer(id, size,
+                    GL_FLOAT, GL_FALSE, static_cast<GLsizei>(Vertex2D::Size),
+                    reinterpret_cast<void*>(static_cast<intptr_t>(offset))));
+            }
+        }
+    }
+
+    glCheck(glBindVertexArray(0));
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+#endif //PLATFORM
+}
+
+void RenderSystem2D::drawSingle(Entity entity, const glm::mat4& viewProjMat, IntRect viewport, const RenderTarget& rt, std::uint32_t& lastProgram)
+{
+#ifdef CRO_DEBUG_
+    //these are probably OK to draw as they aren't yet cleared up
+    //(just marked for removal) but it will ASSERT on debug builds
+    if (!entity.isValid()) return;
+#endif
+
+    const auto& drawable = entity.getComponent<Drawable2D>();
+    const auto& tx = entity.getComponent<cro::Transform>();
+    glm::mat4 worldMat = tx.getWorldTransform();
+
+    if (//TODO surely these ought to be culling criteria?
+        drawable.m_shader && !drawable.m_updateBufferData)
+    {
+        //apply shader
+        auto program = drawable.m_shader->getGLHandle();
+        if (program != lastProgram)
+        {
+            glCheck(glUseProgram(program));
+            lastProgram = program;
+        }
+        //glCheck(glUniformMatrix4fv(drawable.m_worldUniform, 1, GL_FALSE, &(worldMat[0].x)));
+        glCheck(glUniformMatrix4fv(drawable.m_viewProjectionUniform, 1, GL_FALSE, glm::value_ptr(viewProjMat)));
+        glCheck(glUniformMatrix4fv(drawable.m_worldUniform, 1, GL_FALSE, glm::value_ptr(worldMat)));
+
+        //apply texture if active
+        if (drawable.m_textureInfo.textureID.textureID)
+        {
+            glCheck(glActiveTexture(GL_TEXTURE0));
+            glCheck(glBindTexture(GL_TEXTURE_2D, drawable.m_textureInfo.textureID.textureID));
+            glCheck(glUniform1i(drawable.m_textureUniform, 0));
+        }
+
+        //apply any custom uniforms
+        std::int32_t j = 1;
+        for (const auto& [uniform, value] : drawable.m_textureIDBindings)
+        {
+            glCheck(glActiveTexture(GL_TEXTURE0 + j));
+            glCheck(glBindTexture(GL_TEXTURE_2D, value));
+            glCheck(glUniform1i(uniform, j));
+            j++;
+        }
+        for (auto [uniform, value] : drawable.m_floatBindings)
+        {
+            glCheck(glUniform1f(uniform, value));
+        }
+        for (auto [uniform, value] : drawable.m_vec2Bindings)
+        {
+            glCheck(glUniform2f(uniform, value.x, value.y));
+        }
+        for (auto [uniform, value] : drawable.m_vec3Bindings)
+        {
+            glCheck(glUniform3f(uniform, value.x, value.y, value.z));
+        }
+        for (auto [uniform, value] : drawable.m_vec4Bindings)
+        {
+            glCheck(glUniform4f(uniform, value.r, value.g, value.b, value.a));
+        }
+        for (auto [uniform, value] : drawable.m_boolBindings)
+        {
+            glCheck(glUniform1i(uniform, value));
+        }
+        for (const auto& [uniform, value] : drawable.m_matBindings)
+        {
+            glCheck(glUniformMatrix4fv(uniform, 1, GL_FALSE, value));
+        }
+
+        applyBlendMode(drawable.m_blendMode);
+
+        if (drawable.m_cropped)
+        {
+            //convert cropping area to target coords (remember this might not be a window!)
+            glm::vec2 start(drawable.m_croppingWorldArea.left, drawable.m_croppingWorldArea.bottom);
+            glm::vec2 end(start.x + drawable.m_croppingWorldArea.width, start.y + drawable.m_croppingWorldArea.height);
+
+            auto scissorStart = mapCoordsToPixel(start, viewProjMat, viewport);
+            auto scissorEnd = mapCoordsToPixel(end, viewProjMat, viewport);
+
+            scissorStart.x = std::clamp(scissorStart.x, 0, viewport.width - 1);
+            scissorStart.y = std::clamp(scissorStart.y, 0, viewport.height - 1);
+
+            scissorEnd.x = std::clamp(scissorEnd.x, scissorStart.x, viewport.width);
+            scissorEnd.y = std::clamp(scissorEnd.y, scissorStart.y, viewport.height);
+
+            auto w = scissorEnd.x - scissorStart.x;
+            auto h = scissorEnd.y - scissorStart.y;
+
+            glCheck(glScissor(scissorStart.x, scissorStart.y, w, h));
+        }
+        else
+        {
+            auto rtSize = rt.getSize();
+            glCheck(glScissor(0, 0, rtSize.x, rtSize.y));
+        }
+
+        glCheck(glFrontFace(drawable.m_facing));
+
+#ifdef PLATFORM_DESKTOP
+        glCheck(glBindVertexArray(drawable.m_vao));
+        glCheck(glDrawArrays(static_cast<GLenum>(drawable.m_primitiveType), 0, static_cast<GLsizei>(drawable.m_vertices.size())));
+
+#else //GLES 2 doesn't have VAO support without extensions
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, drawable.m_vbo));
+
+        //bind attribs
+        //const auto& attribs = drawable.m_vertexAttribs;
+        for (const auto& [id, size, offset] : drawable.m_vertexAttributes)
+        {
+            glCheck(glEnableVertexAttribArray(id));
+            glCheck(glVertexAttribPointer(id, size,
+                GL_FLOAT, GL_FALSE, static_cast<GLsizei>(Vertex2D::Size),
+                reinterpret_cast<void*>(static_cast<intptr_t>(offset))));
+        }
+
+        //draw array
+        glCheck(glDrawArrays(static_cast<GLenum>(drawable.m_primitiveType), 0, drawable.m_vertices.size()));
+
+        //and unbind... this could be saved by only changing when switching shader
+        for (const auto& attrib : drawable.m_vertexAttributes)
+        {
+            glCheck(glDisableVertexAttribArray(attrib.id));
+        }
+
+#endif //PLATFORM 
+    }
+}
+
 void RenderSystem2D::onEntityAdded(Entity entity)
 {
     //create the VBO (VAO is applied when shader is set)
@@ -445,6 +806,7 @@ void RenderSystem2D::resetDrawable(Entity entity)
     {
         glCheck(glDeleteBuffers(1, &drawable.m_vbo));
     }
+    drawable.m_vboSize = 0;
 
 #ifdef PLATFORM_DESKTOP
 
@@ -41,6 +41,7 @@ source distribution.
 #include <crogine/util/Frustum.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../VisibilityPass.hpp"
 
 #include <crogine/detail/glm/gtc/type_ptr.hpp>
 #include <crogine/detail/glm/gtc/matrix_transform.hpp>
@@ -59,7 +60,8 @@ namespace
 
 ShadowMapRenderer::ShadowMapRenderer(cro::MessageBus& mb)
     : System(mb, typeid(ShadowMapRenderer)),
-    m_interval      (1)
+    m_interval      (1),
+    m_passBuffer    (Detail::PassData::BlockName)
 {
     requireComponent<cro::Model>();
     requireComponent<cro::Transform>();
@@ -120,16 +122,23 @@ void ShadowMapRenderer::updateDrawList(Entity camEnt)
             m_drawLists.emplace_back();
         }
 
+        //clear rather than recreate the lists so that
+        //they keep their capacity between frames
         auto& drawList = m_drawLists[m_activeCameras.size()];
-        drawList.clear();
         drawList.resize(camera.getCascadeCount());
+        for (auto& cascade : drawList)
+        {
+            cascade.clear();
+        }
 
         m_activeCameras.push_back(camEnt);
 
 
         //store the results here to use in frustum culling
-        std::vector<glm::vec3> lightPositions;
-        std::vector<Box> frustums;
+        auto& lightPositions = m_lightPositions;
+        auto& frustums = m_frustums;
+        lightPositions.clear();
+        frustums.clear();
 #ifdef CRO_DEBUG_
         camera.lightCorners.clear();
 #endif
@@ -210,11 +219,15 @@ void ShadowMapRenderer::updateDrawList(Entity camEnt)
         std::int32_t visibleCount = 0;
 #endif
 
-        //use depth frusta to cull entities
-        auto& entities = getEntities();
-        for (auto& entity : entities)
+        //use depth frusta to cull entities. World bounds are shared with the other renderers
+        auto& visibility = *getScene()->m_visibilityPass;
+        const auto& entities = visibility.getEntities();
+        const auto& spheres = visibility.getSpheres();
+        for (auto e = 0u; e < entities.size(); ++e)
         {
-            if (!entity.getComponent<ShadowCaster>().active)
+            auto entity = entities[e];
+            if (!hasEntity(entity)
+                || !entity.getComponent<ShadowCaster>().active)
             {
                 continue;
             }
@@ -230,22 +243,7 @@ void ShadowMapRenderer::updateDrawList(Entity camEnt)
                 continue;
             }
 
-            const auto& tx = entity.getComponent<Transform>();
-            auto sphere = model.getBoundingSphere();
-
-            sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre, 1.f));
-            auto scale = tx.getWorldScale();
-
-            //if it's approaching zero scale then don't cast shadow
-            /*if (scale.x * scale.y * scale.z < 0.01f)
-            {
-                continue;
-            }*/
-
-            sphere.radius *= ((scale.x + scale.y + scale.z) / 3.f);
-
-            std::vector<std::pair<std::size_t, std::size_t>> drawListOffsets;
-
+            const auto& sphere = spheres[e];
             for (auto i = 0u; i < camera.getCascadeCount(); ++i)
             {
                 float distance = glm::dot(-lightDir, sphere.centre - lightPositions[i]);
@@ -282,7 +280,7 @@ void ShadowMapRenderer::updateDrawList(Entity camEnt)
 #ifdef CRO_DEBUG_
         //some objects might appear in multiple cascades
         DPRINT("Rendered 3D shadow ents", std::to_string(visibleCount));
-        camera.lightPositions.swap(lightPositions);
+        camera.lightPositions = lightPositions;
 #endif
     }
 }
@@ -311,6 +309,21 @@ void ShadowMapRenderer::render()
             //clearing in this loop only happens once.
             camera.shadowMapBuffer.clear(cro::Colour::White());
 #endif
+
+#ifdef PLATFORM_DESKTOP
+            const auto& sunlight = getScene()->getSunlight().getComponent<Sunlight>();
+            m_passData.viewMatrix = camera.m_shadowViewMatrices[d];
+            m_passData.projectionMatrix = camera.m_shadowProjectionMatrices[d];
+            m_passData.viewProjectionMatrix = camera.m_shadowProjectionMatrices[d] * camera.m_shadowViewMatrices[d];
+            m_passData.clipPlane = glm::vec4(0.f); //shadow casters are never clipped
+            m_passData.cameraWorldPosition = cameraPosition;
+            m_passData.lightDirection = sunlight.getDirection();
+            m_passData.lightColour = sunlight.getColour().getVec4();
+            m_passData.screenSize = glm::vec2(camera.shadowMapBuffer.getSize());
+            m_passBuffer.setData(m_passData);
+            m_passBuffer.bind(Detail::PassData::BindPoint);
+#endif
+
             const auto& list = m_drawLists[c][d];
             for (const auto& [e, _] : list)
             {
@@ -351,33 +364,36 @@ void ShadowMapRenderer::render()
 
                     //check material properties for alpha clipping
                     std::uint32_t currentTextureUnit = 0;
-                    for (const auto& prop : mat.properties)
+                    for (const auto& [uniform, prop] : mat.compiledProperties)
                     {
-                        switch (prop.second.second.type)
+                        switch (prop.type)
                         {
                         default: break;
                         case Material::Property::TextureArray:
                             glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
-                            glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, prop.second.second.textureID));
-                            glCheck(glUniform1i(prop.second.first, currentTextureUnit++));
+                            glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, prop.textureID));
+                            glCheck(glUniform1i(uniform, currentTextureUnit++));
                             break;
                         case Material::Property::Texture:
                             glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
-                            glCheck(glBindTexture(GL_TEXTURE_2D, prop.second.second.textureID));
-                            glCheck(glUniform1i(prop.second.first, currentTextureUnit++));
+                            glCheck(glBindTexture(GL_TEXTURE_2D, prop.textureID));
+                            glCheck(glUniform1i(uniform, currentTextureUnit++));
                             break;
                         case Material::Property::Number:
-                            glCheck(glUniform1f(prop.second.first, prop.second.second.numberValue));
+                            glCheck(glUniform1f(uniform, prop.numberValue));
                             break;
                         }
                     }
 
                     glCheck(glUniformMatrix4fv(mat.uniforms[Material::World], 1, GL_FALSE, glm::value_ptr(worldMat)));
-                    glCheck(glUniformMatrix4fv(mat.uniforms[Material::View], 1, GL_FALSE, glm::value_ptr(camera.m_shadowViewMatrices[d])));
                     glCheck(glUniformMatrix4fv(mat.uniforms[Material::WorldView], 1, GL_FALSE, glm::value_ptr(worldView)));
                     glCheck(glUniformMatrix4fv(mat.uniforms[Material::CameraView], 1, GL_FALSE, glm::value_ptr(camView)));
-                    glCheck(glUniformMatrix4fv(mat.uniforms[Material::Projection], 1, GL_FALSE, glm::value_ptr(camera.m_shadowProjectionMatrices[d])));
-                    glCheck(glUniform3f(mat.uniforms[Material::Camera], cameraPosition.x, cameraPosition.y, cameraPosition.z));
+                    if (!mat.passData)
+                    {
+                        glCheck(glUniformMatrix4fv(mat.uniforms[Material::View], 1, GL_FALSE, glm::value_ptr(camera.m_shadowViewMatrices[d])));
+                        glCheck(glUniformMatrix4fv(mat.uniforms[Material::Projection], 1, GL_FALSE, glm::value_ptr(camera.m_shadowProjectionMatrices[d])));
+                        glCheck(glUniform3f(mat.uniforms[Material::Camera], cameraPosition.x, cameraPosition.y, cameraPosition.z));
+                    }
                     //glCheck(glUniformMatrix4fv(mat.uniforms[Material::ViewProjection], 1, GL_FALSE, glm::value_ptr(camera.depthViewProjectionMatrix)));
 
                     glCheck((/*model.m_materials[Mesh::IndexData::Final][i].doubleSided ||*/ mat.doubleSided) ? glDisable(GL_CULL_FACE) : glEnable(GL_CULL_FACE));
@@ -63,6 +63,13 @@ namespace
     }
 
     float playbackRate = 1.f;
+
+    //holds temporary output during animation blending - one
+    //per thread as skeletons are animated in parallel
+    thread_local std::vector<glm::mat4> mixBuffer;
+
+    //skeletons are relatively expensive to update so use smaller batches
+    constexpr std::size_t MinBatchSize = 8;
 }
 
 SkeletalAnimator::SkeletalAnimator(MessageBus& mb)
@@ -70,6 +77,12 @@ SkeletalAnimator::SkeletalAnimator(MessageBus& mb)
 {
     requireComponent<Model>();
     requireComponent<Skeleton>();
+
+    //attachments are positioned by modifying their transform, and
+    //the model bounds are updated to match the current frame
+    writeComponent<Model>();
+    writeComponent<Skeleton>();
+    writeComponent<Transform>();
 }
 
 //public
@@ -80,15 +93,10 @@ void SkeletalAnimator::process(float dt)
     const auto camPos = getScene()->getActiveCamera().getComponent<cro::Transform>().getWorldPosition();
     const auto camDir = cro::Util::Matrix::getForwardVector(getScene()->getActiveCamera().getComponent<cro::Transform>().getWorldTransform());
 
-    //TODO we might increase perf a bit if we split the entities across
-    //a series of joblists each in its own thread, then wait for those lists to complete
-    //gotta try it to find out. I have a feeling it'll actually be worse on low numbers
-    //also remember raising messages is not thread safe so might have to do all those
-    //on the main thread anyway...
-
-    auto& entities = getEntities();
-    for (auto& entity : entities)
-    {      
+    //skeletons are split into batches and animated in parallel - messages
+    //raised by animation events are forwarded in order once all are done
+    parallelForEach([&](Entity entity)
+    {
         auto& skel = entity.getComponent<Skeleton>();
 
         //check the model is roughly in front of the camera and within interp distance
@@ -137,15 +145,25 @@ void SkeletalAnimator::process(float dt)
                 skel.m_currentBlendTime = 0.f;
             }
         }
+    }, MinBatchSize);
 
-        //update the position of attachments.
-        //TODO only do this if the frame was updated (? won't account for entity transform changing though)
-        for (auto i = 0u; i < skel.m_attachments.size(); ++i)
+    //update the position of attachments. This is done afterwards as an
+    //attached model may itself be animated, and modifying its transform
+    //would otherwise invalidate its world transform while it's being read.
+    //TODO only do this if the frame was updated (? won't account for entity transform changing though)
+    for (auto entity : getEntities())
+    {
+        auto& skel = entity.getComponent<Skeleton>();
+        if (!skel.m_attachments.empty())
         {
-            auto& ap = skel.m_attachments[i];
-            if (ap.getModel().isValid())
+            const auto worldTransform = entity.getComponent<cro::Transform>().getWorldTransform();
+            for (auto i = 0u; i < skel.m_attachments.size(); ++i)
             {
-                ap.getModel().getComponent<cro::Transform>().m_attachmentTransform = ctx.worldTransform * skel.getAttachmentTransform(i);
+                auto& ap = skel.m_attachments[i];
+                if (ap.getModel().isValid())
+                {
+                    ap.getModel().getComponent<cro::Transform>().setAttachmentTransform(worldTransform * skel.getAttachmentTransform(i));
+                }
             }
         }
     }
@@ -314,20 +332,20 @@ void SkeletalAnimator::interpolateAnimation(SkeletalAnim& source, std::size_t ta
     //stores interpolated output in source so we can use it to blend.
     //we mix all the joints first to prevent it happening multiple times
     //when we create the world transforms.
-    m_mixBuffer.resize(skeleton.m_frameSize);
+    mixBuffer.resize(skeleton.m_frameSize);
     for (auto i = 0u; i < skeleton.m_frameSize; ++i)
     {
-        m_mixBuffer[i] = mixJoint(skeleton.m_frames[startA + i], skeleton.m_frames[startB + i], time, source.interpolationOutput[i]);
+        mixBuffer[i] = mixJoint(skeleton.m_frames[startA + i], skeleton.m_frames[startB + i], time, source.interpolationOutput[i]);
     }
 
     for (auto i = 0u; i < skeleton.m_frameSize; ++i)
     {
-        glm::mat4 worldMatrix = m_mixBuffer[i];
+        glm::mat4 worldMatrix = mixBuffer[i];
 
         std::int32_t parent = skeleton.m_frames[startA + i].parent;
         while (parent != -1)
         {
-            worldMatrix = m_mixBuffer[parent] * worldMatrix;
+            worldMatrix = mixBuffer[parent] * worldMatrix;
             parent = skeleton.m_frames[startA + parent].parent;
         }
 
@@ -344,21 +362,21 @@ void SkeletalAnimator::interpolateAnimation(SkeletalAnim& source, std::size_t ta
 void SkeletalAnimator::blendAnimations(const SkeletalAnim& a, const SkeletalAnim& b, float time, Skeleton& skeleton) const
 {
     Joint temp; //we need something to pass as a func param
-    m_mixBuffer.resize(skeleton.m_frameSize);
+    mixBuffer.resize(skeleton.m_frameSize);
 
     for (auto i = 0u; i < skeleton.m_frameSize; ++i)
     {
-        m_mixBuffer[i] = mixJoint(a.interpolationOutput[i], b.interpolationOutput[i], time, temp);
+        mixBuffer[i] = mixJoint(a.interpolationOutput[i], b.interpolationOutput[i], time, temp);
     }
 
     for (auto i = 0u; i < skeleton.m_frameSize; ++i)
     {
-        auto worldMat = m_mixBuffer[i];
+        auto worldMat = mixBuffer[i];
 
         auto parent = a.interpolationOutput[i].parent;
         while (parent != -1)
         {
-            worldMat = m_mixBuffer[parent] * worldMat;
+            worldMat = mixBuffer[parent] * worldMat;
             parent = a.interpolationOutput[parent].parent;
         }
 
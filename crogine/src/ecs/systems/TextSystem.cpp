@@ -34,19 +34,93 @@ source distribution.
 #include <crogine/graphics/Font.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/TextConstruction.hpp"
+#include "../../graphics/shaders/Sprite.hpp"
+
+#include <algorithm>
+#include <functional>
 
 using namespace cro;
 
+namespace
+{
+    //number of updates after which an unused layout is removed from the cache
+    constexpr std::uint64_t LayoutLifetime = 60;
+
+    template <typename T>
+    void hashCombine(std::size_t& seed, const T& value)
+    {
+        seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    std::size_t hashLayout(const TextContext& context)
+    {
+        std::size_t retVal = context.string.size();
+        for (auto i = 0u; i < context.string.size(); ++i)
+        {
+            hashCombine(retVal, context.string[i]);
+        }
+
+        hashCombine(retVal, context.font);
+        hashCombine(retVal, context.charSize);
+        hashCombine(retVal, context.verticalSpacing);
+        hashCombine(retVal, context.fillColour.getPacked());
+        hashCombine(retVal, context.outlineColour.getPacked());
+        hashCombine(retVal, context.outlineThickness);
+        hashCombine(retVal, context.shadowColour.getPacked());
+        hashCombine(retVal, context.shadowOffset.x);
+        hashCombine(retVal, context.shadowOffset.y);
+        hashCombine(retVal, context.bold);
+        hashCombine(retVal, context.alignment);
+
+        return retVal;
+    }
+
+    bool sameLayout(const TextContext& a, const TextContext& b)
+    {
+        return a.font == b.font
+            && a.charSize == b.charSize
+            && a.verticalSpacing == b.verticalSpacing
+            && a.fillColour == b.fillColour
+            && a.outlineColour == b.outlineColour
+            && a.outlineThickness == b.outlineThickness
+            && a.shadowColour == b.shadowColour
+            && a.shadowOffset == b.shadowOffset
+            && a.bold == b.bold
+            && a.alignment == b.alignment
+            && a.string == b.string;
+    }
+}
+
 TextSystem::TextSystem(MessageBus& mb)
-    : System(mb, typeid(TextSystem))
+    : System    (mb, typeid(TextSystem)),
+    m_frameCount(0)
 {
     requireComponent<Drawable2D>();
     requireComponent<Text>();
     requireComponent<Transform>();
+
+    m_distanceFieldShader.loadFromString(Shaders::Sprite::Vertex, Shaders::Text::SDFFragment, "#define TEXTURED\n");
 }
 
 void TextSystem::process(float)
 {
+    m_frameCount++;
+    if ((m_frameCount % LayoutLifetime) == 0)
+    {
+        for (auto it = m_layoutCache.begin(); it != m_layoutCache.end();)
+        {
+            if (m_frameCount - it->second.lastUsed > LayoutLifetime)
+            {
+                it = m_layoutCache.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
     auto entities = getEntities();
     for (auto entity : entities)
     {
@@ -57,13 +131,20 @@ void TextSystem::process(float)
         bool isPageUpdate = text.m_context.font->pageUpdated(text.getCharacterSize());
         if (text.m_dirtyFlags || isPageUpdate)
         {
+            if (isPageUpdate)
+            {
+                //glyphs may have moved so the layout needs rebuilding
+                text.m_dirtyFlags |= Text::DirtyFlags::Texture;
+            }
+
             if ((text.m_dirtyFlags & Text::DirtyFlags::Colour) != 0)
             {
                 //don't rebuild the entire array
                 auto& verts = drawable.getVertexData();
 
                 cro::Colour secondColour = cro::Colour::Transparent;
-                if (text.m_context.outlineThickness != 0)
+                if (text.m_context.outlineThickness != 0
+                    && !text.m_context.font->isDistanceField())
                 {
                     secondColour = text.m_context.outlineColour;
                 }
@@ -94,7 +175,27 @@ void TextSystem::process(float)
             }
             //else
             {
-                text.updateVertices(drawable);
+                const bool rebuild = (text.m_dirtyFlags & ~Text::DirtyFlags::String) != 0;
+                if (fetchLayout(text, drawable))
+                {
+                    if (rebuild)
+                    {
+                        //the text's own layout no longer matches its style
+                        text.m_layout.reset();
+                    }
+                }
+                else
+                {
+                    const auto revision = text.m_context.font->m_revision;
+                    text.updateVertices(drawable);
+
+                    //only shared when built from scratch, else text which
+                    //changes every frame would fill the cache
+                    if (rebuild)
+                    {
+                        storeLayout(text, drawable, revision);
+                    }
+                }
                 drawable.setPrimitiveType(GL_TRIANGLES);
                 m_readPages.push_back({ text.getFont(), text.getCharacterSize() }); //font needs its pages marked as read
 
@@ -103,6 +204,8 @@ void TextSystem::process(float)
                 {
                     drawable.setTexture(&text.getFont()->getTexture(text.getCharacterSize()));
                 }
+
+                applyDistanceField(drawable, text);
             }
 
             text.m_dirtyFlags = 0;
@@ -118,4 +221,83 @@ void TextSystem::process(float)
         font->markPageRead(charSize);
     }
     m_readPages.clear();
+}
+
+//private
+void TextSystem::applyDistanceField(Drawable2D& drawable, const Text& text)
+{
+    const bool hasShader = drawable.getShader() == &m_distanceFieldShader;
+
+    if (!text.getFont()->isDistanceField())
+    {
+        if (hasShader)
+        {
+            //return to the default shader, without the
+            //distance field settings bound to it
+            drawable.unbindUniform("u_smoothing");
+            drawable.unbindUniform("u_outlineThickness");
+            drawable.unbindUniform("u_outlineColour");
+            drawable.setShader(nullptr);
+        }
+        return;
+    }
+
+    if (!hasShader)
+    {
+        if (drawable.m_customShader)
+        {
+            //respect any user shader
+            return;
+        }
+        drawable.setShader(&m_distanceFieldShader);
+    }
+
+    //convert from pixels at the text's size to distance field units
+    const float scale = static_cast<float>(Font::DistanceFieldSize) / (static_cast<float>(text.getCharacterSize()) * Font::DistanceFieldSpread * 2.f);
+    const float smoothing = std::min(0.5f, scale * 0.5f);
+    const float outlineThickness = std::clamp(text.getOutlineThickness() * scale, 0.f, 0.5f - smoothing);
+
+    drawable.bindUniform("u_smoothing", smoothing);
+    drawable.bindUniform("u_outlineThickness", outlineThickness);
+    drawable.bindUniform("u_outlineColour", text.getOutlineColour());
+}
+
+bool TextSystem::fetchLayout(const Text& text, Drawable2D& drawable)
+{
+    const auto& context = text.m_context;
+    if (!context.font
+        || context.string.empty())
+    {
+        return false;
+    }
+
+    auto result = m_layoutCache.find(hashLayout(context));
+    if (result != m_layoutCache.end()
+        && result->second.fontRevision == context.font->m_revision
+        && sameLayout(result->second.context, context))
+    {
+        drawable.getVertexData() = result->second.vertices;
+        drawable.updateLocalBounds(result->second.bounds);
+        result->second.lastUsed = m_frameCount;
+        return true;
+    }
+    return false;
+}
+
+void TextSystem::storeLayout(const Text& text, const Drawable2D& drawable, std::uint32_t fontRevision)
+{
+    const auto& context = text.m_context;
+    if (!context.font
+        || context.string.empty()
+        || context.font->m_revision != fontRevision) //glyphs moved while building
+    {
+        return;
+    }
+
+    auto& layout = m_layoutCache[hashLayout(context)];
+    layout.context = context;
+    layout.fontRevision = fontRevision;
+    layout.vertices = drawable.getVertexData();
+    layout.bounds = drawable.getLocalBounds();
+    layout.lastUsed = m_frameCount;
 }
\ No newline at end of file
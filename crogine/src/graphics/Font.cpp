@@ -39,9 +39,12 @@ by Laurent Gomila et al https://github.com/SFML/SFML/blob/master/src/SFML/Graphi
 #include <crogine/graphics/Colour.hpp>
 #include <crogine/detail/Types.hpp>
 #include <crogine/core/FileSystem.hpp>
+#include <crogine/core/App.hpp>
 
 #include <array>
+#include <atomic>
 #include <cstring>
+#include <mutex>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -143,10 +146,62 @@ namespace
         std::size_t refCount = 0;
     };
     std::unique_ptr<FontDataResource> fontDataResource;
+
+    std::atomic<std::uint32_t> nextRevision = 0;
+
+    //file layout used by saveGlyphs()/loadGlyphs(): a header followed by
+    //the atlas rows, the glyphs then the alpha channel of the atlas texture
+    constexpr std::uint32_t GlyphFileMagic = 0x46444643; //CFDF
+    constexpr std::uint32_t GlyphFileVersion = 1;
+
+    struct GlyphFileHeader final
+    {
+        std::uint32_t magic = GlyphFileMagic;
+        std::uint32_t version = GlyphFileVersion;
+        std::uint32_t glyphSize = 0;
+        float spread = 0.f;
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        std::uint32_t nextRow = 0;
+        std::uint32_t rowCount = 0;
+        std::uint32_t glyphCount = 0;
+    };
+
+    struct GlyphFileRow final
+    {
+        std::uint32_t width = 0;
+        std::uint32_t top = 0;
+        std::uint32_t height = 0;
+    };
+
+    struct GlyphFileGlyph final
+    {
+        std::uint64_t key = 0;
+        float advance = 0.f;
+        float padding = 0.f;
+        std::array<float, 4> bounds = {};
+        std::array<float, 4> textureBounds = {};
+    };
 }
 
+struct Font::DistanceFieldQueue final
+{
+    struct Result final
+    {
+        URect area;
+        std::vector<std::uint8_t> pixels;
+    };
+
+    std::mutex mutex;
+    std::vector<Result> results;
+    JobSystem::Counter counter;
+};
+
 Font::Font()
-    : m_useSmoothing(false)
+    : m_useSmoothing        (false),
+    m_distanceField         (false),
+    m_revision              (nextRevision++),
+    m_distanceFieldQueue    (std::make_shared<DistanceFieldQueue>())
 {
     if (!fontDataResource)
     {
@@ -247,6 +302,8 @@ bool Font::appendFromFile(const std::string& filePath, FontAppendmentContext ctx
         }
     }
 
+    m_kerning.clear();
+    updateRevision();
 
     return true;
 }
@@ -254,6 +311,33 @@ bool Font::appendFromFile(const std::string& filePath, FontAppendmentContext ctx
 Glyph Font::getGlyph(std::uint32_t codepoint, std::uint32_t charSize, bool bold, float outlineThickness) const
 {
     auto& fontData = getFontData(codepoint);
+
+    if (m_distanceField)
+    {
+        bold = bold && fontData.context.allowBold;
+
+        auto& glyphs = m_pages[getPageID(charSize)].glyphs;
+        auto key = combine(0.f, bold, FT_Get_Char_Index(std::any_cast<FT_Face>(fontData.face), codepoint));
+
+        auto result = glyphs.find(key);
+        if (result == glyphs.end())
+        {
+            result = glyphs.insert(std::make_pair(key, loadDistanceFieldGlyph(codepoint, bold))).first;
+        }
+
+        //scale the glyph to the requested size - the texture bounds remain the same
+        const float scale = static_cast<float>(charSize) / DistanceFieldSize;
+        auto glyph = result->second;
+        glyph.advance *= scale;
+        glyph.padding *= scale;
+        glyph.bounds.left *= scale;
+        glyph.bounds.bottom *= scale;
+        glyph.bounds.width *= scale;
+        glyph.bounds.height *= scale;
+
+        return glyph;
+    }
+
     auto& currentGlyphs = m_pages[charSize].glyphs;
     auto key = combine(outlineThickness, bold, FT_Get_Char_Index(std::any_cast<FT_Face>(fontData.face), codepoint));
 
@@ -278,7 +362,8 @@ const Texture& Font::getTexture(std::uint32_t charSize) const
     //TODO this may return an invalid texture if the
     //current charSize is not inserted in the page map
     //and is automatically created
-    return m_pages[charSize].texture;
+    updateDistanceField();
+    return m_pages[getPageID(charSize)].texture;
 }
 
 float Font::getLineHeight(std::uint32_t charSize) const
@@ -305,8 +390,17 @@ float Font::getKerning(std::uint32_t cpA, std::uint32_t cpB, std::uint32_t charS
         return 0.f;
     }
 
+    //codepoints are at most 21 bits
+    const auto key = (static_cast<std::uint64_t>(cpA) << 43) | (static_cast<std::uint64_t>(cpB) << 22) | (charSize & 0x3fffff);
+    if (auto result = m_kerning.find(key); result != m_kerning.end())
+    {
+        return result->second;
+    }
+
     FT_Face face = std::any_cast<FT_Face>(m_fontData[0].face);
 
+    //invalid fonts, or fonts with no kerning, return 0
+    float retVal = 0.f;
     if (face && FT_HAS_KERNING(face) && setCurrentCharacterSize(charSize))
     {
         //convert the characters to indices
@@ -318,32 +412,248 @@ float Font::getKerning(std::uint32_t cpA, std::uint32_t cpB, std::uint32_t charS
         FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
 
         //x advance is already in pixels for bitmap fonts
-        if (!FT_IS_SCALABLE(face))
+        retVal = FT_IS_SCALABLE(face) ? static_cast<float>(kerning.x) / MagicNumber : static_cast<float>(kerning.x);
+    }
+
+    m_kerning.insert(std::make_pair(key, retVal));
+    return retVal;
+}
+
+void Font::setSmooth(bool smooth)
+{
+    if (smooth != m_useSmoothing)
+    {
+        m_useSmoothing = smooth;
+
+        //distance fields are always smoothed
+        if (!m_distanceField)
         {
-            return static_cast<float>(kerning.x);
+            for (auto& page : m_pages)
+            {
+                page.second.texture.setSmooth(smooth);
+            }
         }
-
-        //return the x advance
-        return static_cast<float>(kerning.x) / MagicNumber;
     }
-    else
+}
+
+void Font::setDistanceField(bool enabled)
+{
+    if (enabled != m_distanceField)
     {
-        //invalid font, or no kerning
-        return 0.f;
+        m_distanceField = enabled;
+
+        m_pages.clear();
+        m_distanceFieldQueue = std::make_shared<DistanceFieldQueue>();
+        updateRevision();
+
+        for (auto* o : m_observers)
+        {
+            o->onFontUpdate();
+        }
     }
 }
 
-void Font::setSmooth(bool smooth)
+void Font::bakeGlyphs(std::array<std::uint32_t, 2> codepointRange, bool bold)
 {
-    if (smooth != m_useSmoothing)
+    if (!m_distanceField)
     {
-        m_useSmoothing = smooth;
+        LogW << "bakeGlyphs() is only available with distance field fonts" << std::endl;
+        return;
+    }
 
-        for (auto& page : m_pages)
+    if (m_fontData.empty())
+    {
+        LogE << "bakeGlyphs(): no font is loaded" << std::endl;
+        return;
+    }
+
+    //64 bit so that the loop ends if the range includes the max uint32 value
+    for (std::uint64_t i = std::max(1u, codepointRange[0]); i <= codepointRange[1]; ++i)
+    {
+        const auto cp = static_cast<std::uint32_t>(i);
+        auto face = std::any_cast<FT_Face>(getFontData(cp).face);
+        if (FT_Get_Char_Index(face, cp) != 0)
         {
-            page.second.texture.setSmooth(smooth);
+            getGlyph(cp, DistanceFieldSize, bold);
         }
     }
+
+    if (App::isValid())
+    {
+        App::getJobSystem().wait(m_distanceFieldQueue->counter);
+    }
+    updateDistanceField();
+}
+
+bool Font::saveGlyphs(const std::string& path) const
+{
+    if (!m_distanceField
+        || m_pages.count(0) == 0)
+    {
+        LogE << "Failed writing " << path << ": no distance field glyphs are loaded" << std::endl;
+        return false;
+    }
+
+    if (App::isValid())
+    {
+        App::getJobSystem().wait(m_distanceFieldQueue->counter);
+    }
+    updateDistanceField();
+
+    const auto& page = m_pages.at(0);
+
+    Image image;
+    if (!page.texture.saveToImage(image))
+    {
+        LogE << "Failed writing " << path << ": could not read font texture" << std::endl;
+        return false;
+    }
+
+    GlyphFileHeader header;
+    header.glyphSize = DistanceFieldSize;
+    header.spread = DistanceFieldSpread;
+    header.width = page.texture.getSize().x;
+    header.height = page.texture.getSize().y;
+    header.nextRow = page.nextRow;
+    header.rowCount = static_cast<std::uint32_t>(page.rows.size());
+    header.glyphCount = static_cast<std::uint32_t>(page.glyphs.size());
+
+    std::vector<GlyphFileRow> rows;
+    for (const auto& row : page.rows)
+    {
+        rows.push_back({ row.width, row.top, row.height });
+    }
+
+    std::vector<GlyphFileGlyph> glyphs;
+    for (const auto& [key, glyph] : page.glyphs)
+    {
+        auto& g = glyphs.emplace_back();
+        g.key = key;
+        g.advance = glyph.advance;
+        g.padding = glyph.padding;
+        g.bounds = { glyph.bounds.left, glyph.bounds.bottom, glyph.bounds.width, glyph.bounds.height };
+        g.textureBounds = { glyph.textureBounds.left, glyph.textureBounds.bottom, glyph.textureBounds.width, glyph.textureBounds.height };
+    }
+
+    std::vector<std::uint8_t> alpha(header.width * header.height);
+    const auto* pixels = image.getPixelData();
+    for (auto i = 0u; i < alpha.size(); ++i)
+    {
+        alpha[i] = pixels[i * 4 + 3];
+    }
+
+    RaiiRWops file;
+    file.file = SDL_RWFromFile(path.c_str(), "wb");
+    if (!file.file)
+    {
+        LogE << "Failed opening " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    SDL_RWwrite(file.file, &header, sizeof(header), 1);
+    SDL_RWwrite(file.file, rows.data(), sizeof(GlyphFileRow), rows.size());
+    SDL_RWwrite(file.file, glyphs.data(), sizeof(GlyphFileGlyph), glyphs.size());
+    SDL_RWwrite(file.file, alpha.data(), 1, alpha.size());
+
+    return true;
+}
+
+bool Font::loadGlyphs(const std::string& path)
+{
+    if (!m_distanceField)
+    {
+        LogE << "Failed loading " << path << ": font is not a distance field font" << std::endl;
+        return false;
+    }
+
+    RaiiRWops file;
+    file.file = SDL_RWFromFile(path.c_str(), "rb");
+    if (!file.file)
+    {
+        LogE << "Failed opening " << path << std::endl;
+        return false;
+    }
+
+    GlyphFileHeader header;
+    if (SDL_RWread(file.file, &header, sizeof(header), 1) != 1
+        || header.magic != GlyphFileMagic
+        || header.version != GlyphFileVersion)
+    {
+        LogE << path << ": not a valid glyph file" << std::endl;
+        return false;
+    }
+
+    if (header.glyphSize != DistanceFieldSize
+        || header.spread != DistanceFieldSpread)
+    {
+        LogE << path << ": glyphs were created with different distance field settings" << std::endl;
+        return false;
+    }
+
+    if (header.width == 0 || header.width > Texture::getMaxTextureSize()
+        || header.height == 0 || header.height > Texture::getMaxTextureSize())
+    {
+        LogE << path << ": invalid texture size " << header.width << ", " << header.height << std::endl;
+        return false;
+    }
+
+    std::vector<GlyphFileRow> rows(header.rowCount);
+    std::vector<GlyphFileGlyph> glyphs(header.glyphCount);
+    std::vector<std::uint8_t> alpha(header.width * header.height);
+
+    if (SDL_RWread(file.file, rows.data(), sizeof(GlyphFileRow), rows.size()) != rows.size()
+        || SDL_RWread(file.file, glyphs.data(), sizeof(GlyphFileGlyph), glyphs.size()) != glyphs.size()
+        || SDL_RWread(file.file, alpha.data(), 1, alpha.size()) != alpha.size())
+    {
+        LogE << path << ": unexpected end of file" << std::endl;
+        return false;
+    }
+
+    //make sure any glyphs still being rendered are not uploaded to the new page
+    m_distanceFieldQueue = std::make_shared<DistanceFieldQueue>();
+
+    auto& page = m_pages[0];
+    page.glyphs.clear();
+    page.rows.clear();
+
+    for (const auto& row : rows)
+    {
+        auto& r = page.rows.emplace_back(row.top, row.height);
+        r.width = row.width;
+    }
+    page.nextRow = header.nextRow;
+
+    for (const auto& g : glyphs)
+    {
+        Glyph glyph;
+        glyph.advance = g.advance;
+        glyph.padding = g.padding;
+        glyph.bounds = { g.bounds[0], g.bounds[1], g.bounds[2], g.bounds[3] };
+        glyph.textureBounds = { g.textureBounds[0], g.textureBounds[1], g.textureBounds[2], g.textureBounds[3] };
+        page.glyphs.insert(std::make_pair(g.key, glyph));
+    }
+
+    std::vector<std::uint8_t> pixels(alpha.size() * 4);
+    for (auto i = 0u; i < alpha.size(); ++i)
+    {
+        pixels[i * 4] = 255;
+        pixels[i * 4 + 1] = 255;
+        pixels[i * 4 + 2] = 255;
+        pixels[i * 4 + 3] = alpha[i];
+    }
+
+    page.texture.create(header.width, header.height);
+    page.texture.update(pixels.data());
+    page.texture.setSmooth(true);
+    page.updated = true;
+    updateRevision();
+
+    for (auto* o : m_observers)
+    {
+        o->onFontUpdate();
+    }
+
+    return true;
 }
 
 //private
@@ -570,6 +880,184 @@ Glyph Font::loadGlyph(std::uint32_t codepoint, std::uint32_t charSize, bool bold
     return retVal;
 }
 
+Glyph Font::loadDistanceFieldGlyph(std::uint32_t codepoint, bool bold) const
+{
+    Glyph retVal;
+
+    if (m_fontData.empty())
+    {
+        return retVal;
+    }
+
+    auto& fd = getFontData(codepoint);
+
+    auto face = std::any_cast<FT_Face>(fd.face);
+    if (!face)
+    {
+        return retVal;
+    }
+
+    if (!setCurrentCharacterSize(DistanceFieldSize))
+    {
+        return retVal;
+    }
+
+    //hinting is no use when glyphs are scaled to other sizes
+    if (FT_Load_Char(face, codepoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_HINTING) != 0)
+    {
+        return retVal;
+    }
+
+    //bitmap glyphs use a weight of 1px - this is scaled
+    //so bold glyphs look similar at half the field size
+    constexpr FT_Pos weight = (DistanceFieldSize / 24) << 6;
+    if (bold
+        && face->glyph->format == FT_GLYPH_FORMAT_OUTLINE)
+    {
+        FT_Outline_Embolden(&face->glyph->outline, weight);
+    }
+
+    if (FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL) != 0)
+    {
+        return retVal;
+    }
+
+    auto* bitmap = &face->glyph->bitmap;
+    if (bold
+        && face->glyph->format != FT_GLYPH_FORMAT_OUTLINE)
+    {
+        FT_Bitmap_Embolden(fontDataResource->library, bitmap, weight, weight);
+    }
+
+    retVal.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / MagicNumber;
+    if (bold)
+    {
+        retVal.advance += static_cast<float>(weight) / MagicNumber;
+    }
+
+    const std::uint32_t padding = static_cast<std::uint32_t>(DistanceFieldSpread);
+    const std::uint32_t width = bitmap->width + (padding * 2);
+    const std::uint32_t height = bitmap->rows + (padding * 2);
+
+    if (bitmap->width > 0 && bitmap->rows > 0)
+    {
+        auto& page = m_pages[getPageID(DistanceFieldSize)];
+        page.texture.setSmooth(true);
+
+        //the padding is part of the field so unlike
+        //bitmap glyphs the texture bounds include it
+        retVal.textureBounds = getGlyphRect(page, width, height);
+        if (static_cast<std::uint32_t>(retVal.textureBounds.width) != width)
+        {
+            //failed to find space
+            return retVal;
+        }
+        retVal.padding = DistanceFieldSpread;
+
+        //use the bitmap size rather than the glyph metrics so
+        //that the quad matches the distance field exactly
+        retVal.bounds.left = static_cast<float>(face->glyph->bitmap_left);
+        retVal.bounds.bottom = static_cast<float>(face->glyph->bitmap_top) - bitmap->rows;
+        retVal.bounds.width = static_cast<float>(bitmap->width);
+        retVal.bounds.height = static_cast<float>(bitmap->rows);
+
+        if (&fd != &m_fontData[0])
+        {
+            //scale other characters to match that of the base font
+            const float lineHeight = getLineHeight(DistanceFieldSize);
+            const float scale = std::min(1.f, lineHeight / retVal.bounds.height);
+            retVal.bounds.height *= scale;
+            retVal.bounds.width *= scale;
+            retVal.padding *= scale;
+        }
+
+        //copy the coverage to a padded buffer, and create
+        //the distance field from it on a worker thread
+        std::vector<std::uint8_t> coverage(width * height);
+        const auto* pixels = bitmap->buffer;
+        for (auto y = padding; y < height - padding; ++y)
+        {
+            for (auto x = padding; x < width - padding; ++x)
+            {
+                const auto index = x + y * width;
+                const auto srcX = x - padding;
+
+                switch (bitmap->pixel_mode)
+                {
+                default:
+                    coverage[index] = pixels[srcX];
+                    break;
+                case FT_PIXEL_MODE_MONO:
+                    coverage[index] = (pixels[srcX / 8] & (1 << (7 - (srcX % 8)))) ? 255 : 0;
+                    break;
+                case FT_PIXEL_MODE_BGRA:
+                    coverage[index] = pixels[(srcX * 4) + 3];
+                    break;
+                }
+            }
+            pixels += bitmap->pitch;
+        }
+
+        const URect area(static_cast<std::uint32_t>(retVal.textureBounds.left), static_cast<std::uint32_t>(retVal.textureBounds.bottom), width, height);
+        auto job = [area, coverage = std::move(coverage), queue = m_distanceFieldQueue]()
+        {
+            const auto field = Detail::DistanceField::toSignedDF(coverage.data(), area.width, area.height, DistanceFieldSpread);
+
+            DistanceFieldQueue::Result result;
+            result.area = area;
+            result.pixels.resize(field.size() * 4);
+            for (auto i = 0u; i < field.size(); ++i)
+            {
+                result.pixels[i * 4] = 255;
+                result.pixels[i * 4 + 1] = 255;
+                result.pixels[i * 4 + 2] = 255;
+                result.pixels[i * 4 + 3] = field[i];
+            }
+
+            std::scoped_lock lock(queue->mutex);
+            queue->results.push_back(std::move(result));
+        };
+
+        if (App::isValid())
+        {
+            App::getJobSystem().schedule(std::move(job), &m_distanceFieldQueue->counter);
+        }
+        else
+        {
+            job();
+        }
+    }
+
+    //colour is lost when the glyph is converted
+    retVal.useFillColour = true;
+    return retVal;
+}
+
+void Font::updateDistanceField() const
+{
+    if (!m_distanceField)
+    {
+        return;
+    }
+
+    std::vector<DistanceFieldQueue::Result> results;
+    {
+        std::scoped_lock lock(m_distanceFieldQueue->mutex);
+        results.swap(m_distanceFieldQueue->results);
+    }
+
+    if (!results.empty())
+    {
+        //glyph rects were reserved when the glyphs were
+        //created, so text using them needs no update
+        auto& page = m_pages[getPageID(DistanceFieldSize)];
+        for (const auto& result : results)
+        {
+            page.texture.update(result.pixels.data(), false, result.area);
+        }
+    }
+}
+
 FloatRect Font::getGlyphRect(Page& page, std::uint32_t width, std::uint32_t height) const
 {
     Row* row = nullptr;
@@ -622,6 +1110,7 @@ FloatRect Font::getGlyphRect(Page& page, std::uint32_t width, std::uint32_t heig
                 
                 page.texture.swap(texture);
                 page.updated = true;
+                updateRevision();
 
                 for (auto* o : m_observers)
                 {
@@ -713,16 +1202,25 @@ void Font::cleanup()
 
     m_pages.clear();
     m_pixelBuffer.clear();
+    m_kerning.clear();
+    m_distanceFieldQueue = std::make_shared<DistanceFieldQueue>();
+    updateRevision();
+}
+
+void Font::updateRevision() const
+{
+    m_revision = nextRevision++;
 }
 
 bool Font::pageUpdated(std::uint32_t charSize) const
 {
-    return m_pages[charSize].updated;
+    updateDistanceField();
+    return m_pages[getPageID(charSize)].updated;
 }
 
 void Font::markPageRead(std::uint32_t charSize) const
 {
-    m_pages[charSize].updated = false;
+    m_pages[getPageID(charSize)].updated = false;
 }
 
 void Font::registerObserver(FontObserver* o) const
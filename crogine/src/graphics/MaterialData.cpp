@@ -33,6 +33,9 @@ source distribution.
 #include <crogine/graphics/Shader.hpp>
 #include <crogine/core/Log.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 using namespace cro;
 using namespace cro::Material;
 
@@ -72,6 +75,41 @@ CubemapID& CubemapID::operator = (const CubemapTexture& t)
 }
 
 
+namespace
+{
+    //the number of bytes of a property's value used by its type
+    std::size_t getValueSize(const Property& p)
+    {
+        switch (p.type)
+        {
+        default: return 0;
+        case Property::Number: return sizeof(float);
+        case Property::Vec2: return sizeof(float) * 2;
+        case Property::Vec3: return sizeof(float) * 3;
+        case Property::Vec4: return sizeof(float) * 4;
+        case Property::Mat4: return sizeof(glm::mat4);
+        case Property::Texture:
+        case Property::TextureArray:
+        case Property::Cubemap:
+        case Property::CubemapArray:
+            return sizeof(std::uint32_t);
+        }
+    }
+
+    //FNV-1a
+    constexpr std::uint64_t HashOffset = 0xcbf29ce484222325;
+    constexpr std::uint64_t HashPrime = 0x100000001b3;
+    void hashBytes(std::uint64_t& hash, const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        for (auto i = 0u; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= HashPrime;
+        }
+    }
+}
+
 #ifdef CRO_DEBUG_
 #define  VERIFY(x) exists(x)
 #else
@@ -94,6 +132,7 @@ void Data::setProperty(const std::string& name, float value)
     {
         result->second.second.numberValue = value;
         result->second.second.type = Property::Number;
+        updateCompiled(result->second);
     }
 }
 
@@ -108,6 +147,7 @@ void Data::setProperty(const std::string& name, glm::vec2 value)
         result->second.second.vecValue[0] = value.x;
         result->second.second.vecValue[1] = value.y;
         result->second.second.type = Property::Vec2;
+        updateCompiled(result->second);
     }
 }
 
@@ -121,6 +161,7 @@ void Data::setProperty(const std::string& name, glm::vec3 value)
         result->second.second.vecValue[1] = value.y;
         result->second.second.vecValue[2] = value.z;
         result->second.second.type = Property::Vec3;
+        updateCompiled(result->second);
     }
 }
 
@@ -135,6 +176,7 @@ void Data::setProperty(const std::string& name, glm::vec4 value)
         result->second.second.vecValue[2] = value.z;
         result->second.second.vecValue[3] = value.w;
         result->second.second.type = Property::Vec4;
+        updateCompiled(result->second);
     }
 }
 
@@ -145,6 +187,7 @@ void Data::setProperty(const std::string& name, glm::mat4 value)
     {
         result->second.second.matrixValue = value;
         result->second.second.type = Property::Mat4;
+        updateCompiled(result->second);
     }
 }
 
@@ -159,6 +202,7 @@ void Data::setProperty(const std::string& name, Colour value)
         result->second.second.vecValue[2] = value.getBlue();
         result->second.second.vecValue[3] = value.getAlpha();
         result->second.second.type = Property::Vec4;
+        updateCompiled(result->second);
     }
 }
 
@@ -170,6 +214,7 @@ void Data::setProperty(const std::string& name, const Texture& value)
     {
         result->second.second.textureID = value.getGLHandle();
         result->second.second.type = Property::Texture;
+        updateCompiled(result->second);
     }
 }
 
@@ -181,6 +226,7 @@ void Data::setProperty(const std::string& name, TextureID value)
     {
         result->second.second.textureID = value.textureID;
         result->second.second.type = value.isArray() ? Property::TextureArray : Property::Texture;
+        updateCompiled(result->second);
     }
 }
 
@@ -192,6 +238,7 @@ void Data::setProperty(const std::string& name, CubemapID value)
     {
         result->second.second.textureID = value.textureID;
         result->second.second.type = value.isArray() ? Property::CubemapArray : Property::Cubemap;
+        updateCompiled(result->second);
     }
 }
 
@@ -204,6 +251,8 @@ void Data::setShader(const Shader& s)
     optionalUniformCount = 0;
 
     shader = s.getGLHandle();
+    passData = s.hasPassData();
+    builtInShader = s.getBuiltInID();
 
     //get the available attribs. This is sorted and culled
     //when added to a model according to the requirements of
@@ -228,6 +277,13 @@ void Data::setShader(const Shader& s)
 
     for (const auto& [uniform, handle] : uniformMap)
     {
+        //members of uniform blocks have no location, their
+        //values come from the buffer bound to the block instead
+        if (handle == -1)
+        {
+            continue;
+        }
+
         if (uniform == "u_worldMatrix")
         {
             uniforms[Material::World] = handle;
@@ -357,9 +413,57 @@ void Data::setShader(const Shader& s)
             result->second.second = prop.second;
         }
     }
+
+    compile();
+}
+
+void Data::compile()
+{
+    compiledProperties.clear();
+    for (const auto& [name, prop] : properties)
+    {
+        if (prop.second.type != Property::None)
+        {
+            auto& compiled = compiledProperties.emplace_back();
+            compiled.uniform = prop.first;
+            compiled.property = prop.second;
+        }
+    }
+    updateHash();
 }
 
 //private
+void Data::updateCompiled(const std::pair<std::int32_t, Property>& prop)
+{
+    auto result = std::find_if(compiledProperties.begin(), compiledProperties.end(),
+        [&prop](const CompiledProperty& c)
+        {
+            return c.uniform == prop.first;
+        });
+
+    if (result == compiledProperties.end())
+    {
+        //this property hasn't had a value set before
+        compile();
+    }
+    else
+    {
+        result->property = prop.second;
+        updateHash();
+    }
+}
+
+void Data::updateHash()
+{
+    propertyHash = HashOffset;
+    for (const auto& compiled : compiledProperties)
+    {
+        hashBytes(propertyHash, &compiled.uniform, sizeof(compiled.uniform));
+        hashBytes(propertyHash, &compiled.property.type, sizeof(compiled.property.type));
+        hashBytes(propertyHash, &compiled.property.matrixValue, getValueSize(compiled.property));
+    }
+}
+
 void Material::Data::exists(const std::string& name)
 {
     if (properties.count(name) == 0)
@@ -30,6 +30,7 @@ source distribution.
 #include <crogine/graphics/Shader.hpp>
 #include <crogine/core/FileSystem.hpp>
 
+#include <crogine/detail/PassData.hpp>
 #include <crogine/detail/Types.hpp>
 #include <crogine/util/String.hpp>
 
@@ -80,8 +81,10 @@ namespace
 }
 
 Shader::Shader()
-    : m_handle  (0),
-    m_attribMap ({})
+    : m_handle      (0),
+    m_attribMap     ({}),
+    m_hasPassData   (false),
+    m_builtInID     (-1)
 {
     if (vendorDef.empty())
     {
@@ -119,10 +122,14 @@ Shader::Shader(Shader&& other) noexcept
     m_handle = other.m_handle;
     m_attribMap = other.m_attribMap;
     m_uniformMap = other.m_uniformMap;
+    m_hasPassData = other.m_hasPassData;
+    m_builtInID = other.m_builtInID;
 
     other.m_handle = 0;
     other.m_attribMap = {};
     other.m_uniformMap.clear();
+    other.m_hasPassData = false;
+    other.m_builtInID = -1;
 }
 
 Shader& Shader::operator=(Shader&& other) noexcept
@@ -137,10 +144,14 @@ Shader& Shader::operator=(Shader&& other) noexcept
         m_handle = other.m_handle;
         m_attribMap = other.m_attribMap;
         m_uniformMap = other.m_uniformMap;
+        m_hasPassData = other.m_hasPassData;
+        m_builtInID = other.m_builtInID;
 
         other.m_handle = 0;
         other.m_attribMap = {};
         other.m_uniformMap.clear();
+        other.m_hasPassData = false;
+        other.m_builtInID = -1;
     }
 
     return *this;
@@ -249,6 +260,8 @@ bool Shader::loadFromSource(const char* vertex, const char* geometry, const char
         m_handle = 0;
         resetAttribMap();
         resetUniformMap();
+        m_hasPassData = false;
+        m_builtInID = -1;
     }
 
     //compile vert shader
@@ -411,6 +424,16 @@ bool Shader::loadFromSource(const char* vertex, const char* geometry, const char
 
             fillUniformMap();
 
+#ifdef PLATFORM_DESKTOP
+            //shaders sharing the per-pass data block always read it from the
+            //same bind point, so renderers only need to bind the buffer
+            auto blockIndex = glGetUniformBlockIndex(m_handle, Detail::PassData::BlockName);
+            if (blockIndex != GL_INVALID_INDEX)
+            {
+                glCheck(glUniformBlockBinding(m_handle, blockIndex, Detail::PassData::BindPoint));
+                m_hasPassData = true;
+            }
+#endif
             return true;
         }
     }
@@ -58,6 +58,8 @@ ShaderResource::ShaderResource()
 
     //register the default includes
     addInclude("WVP_UNIFORMS", WVPMatrices.c_str());
+    addInclude("PASS_UNIFORMS", PassUniforms.c_str());
+    addInclude("WORLD_UNIFORMS", WorldUniforms.c_str());
 
     addInclude("INSTANCE_ATTRIBS", InstanceAttribs.c_str());
     addInclude("INSTANCE_MATRICES", InstanceMatrices.c_str());
@@ -303,6 +305,8 @@ std::int32_t ShaderResource::loadBuiltIn(BuiltIn type, std::int32_t flags)
 
     if (success)
     {
+        //lets renderers find variants of this shader, eg with INSTANCING
+        m_shaders.at(id).m_builtInID = id;
         return id;
     }
     return -1;
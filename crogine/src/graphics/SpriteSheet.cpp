@@ -34,13 +34,144 @@ source distribution.
 using namespace cro;
 
 SpriteSheet::SpriteSheet()
-    : m_texture (nullptr)
+    : m_texture (nullptr),
+    m_smooth    (false),
+    m_repeated  (false)
 {
 
 }
 
 //public
 bool SpriteSheet::loadFromFile(const std::string& path, TextureResource& textures, const std::string& workingDirectory)
+{
+    return load(path, &textures, workingDirectory);
+}
+
+bool SpriteSheet::saveToFile(const std::string& path)
+{
+    auto sheetName = FileSystem::getFileName(path);
+    sheetName = sheetName.substr(0, sheetName.find_last_of('.'));
+
+    ConfigFile sheetFile("spritesheet", sheetName);
+    sheetFile.addProperty("src", "\"" + m_texturePath + "\"");
+
+    if (m_texture)
+    {
+        sheetFile.addProperty("smooth").setValue(m_texture->isSmooth());
+        sheetFile.addProperty("repeat").setValue(m_texture->isRepeated());
+    }
+    else
+    {
+        sheetFile.addProperty("smooth").setValue(m_smooth);
+        sheetFile.addProperty("repeat").setValue(m_repeated);
+    }
+
+    for (const auto& [name, sprite] : m_sprites)
+    {
+        auto sprObj = sheetFile.addObject("sprite", name);
+        sprObj->addProperty("bounds").setValue(sprite.getTextureRect());
+        sprObj->addProperty("colour").setValue(sprite.getColour());
+
+        auto& anims = sprite.getAnimations();
+        for (auto i(0u); i < sprite.getAnimations().size(); i++)
+        {
+            auto animObj = sprObj->addObject("animation", m_animations[name][i]);
+            animObj->addProperty("framerate").setValue(anims[i].framerate);
+            animObj->addProperty("loop").setValue(anims[i].looped);
+            animObj->addProperty("loop_start").setValue(static_cast<std::int32_t>(anims[i].loopStart));
+
+            const auto& frames = anims[i].frames;
+            std::vector<glm::vec2> events;
+            for (auto j = 0u; j < anims[i].frames.size(); j++)
+            {
+                animObj->addProperty("frame").setValue(frames[j].frame);
+
+                if (anims[i].frames[j].event > -1)
+                {
+                    events.emplace_back(anims[i].frames[j].event, j);
+                }
+            }
+
+            for (const auto& evt : events)
+            {
+                animObj->addProperty("event").setValue(evt);
+            }
+        }
+    }
+
+    return sheetFile.save(path);
+}
+
+Sprite SpriteSheet::getSprite(const std::string& name) const
+{
+    if (m_sprites.count(name) != 0)
+    {
+        return m_sprites[name];
+    }
+    LOG(name + " not found in sprite sheet", Logger::Type::Warning);
+    return {};
+}
+
+std::int32_t SpriteSheet::getAnimationIndex(const std::string& name, const std::string& spriteName) const
+{
+    if (m_animations.count(spriteName) != 0)
+    {
+        const auto& anims = m_animations[spriteName];
+        const auto& result = std::find(anims.cbegin(), anims.cend(), name);
+        if (result == anims.cend()) return 0;
+
+        return static_cast<std::int32_t>(std::distance(anims.cbegin(), result));
+    }
+    return 0;
+}
+
+bool SpriteSheet::hasAnimation(const std::string& name, const std::string& spriteName) const
+{
+    if (m_animations.count(spriteName) != 0)
+    {
+        const auto& anims = m_animations[spriteName];
+        const auto& result = std::find(anims.cbegin(), anims.cend(), name);
+        return result != anims.cend();
+    }
+    return false;
+}
+
+void SpriteSheet::setTexture(const std::string& path, TextureResource& tr, const std::string& workingDir)
+{
+    m_texturePath = path;
+    m_texture = &tr.get(workingDir + path);
+
+    for (auto& sprite : m_sprites)
+    {
+        sprite.second.setTexture(*m_texture);
+    }
+}
+
+bool SpriteSheet::addSprite(const std::string& name)
+{
+    if (name.empty())
+    {
+        LogE << "Could not add sprite: name cannot be empty" << std::endl;
+        return false;
+    }
+
+    if (!m_texture)
+    {
+        LogE << "Failed adding " << name << ": no texture is set." << std::endl;
+        return false;
+    }
+
+    if (m_sprites.count(name) == 0)
+    {
+        m_sprites.insert(std::make_pair(name, Sprite()));
+        m_sprites[name].setTexture(*m_texture);
+        return true;
+    }
+    return false;
+}
+
+//private
+bool SpriteSheet::load(const std::string& path, TextureResource* textures, const std::string& workingDirectory)
 {
     ConfigFile sheetFile;
     if (!sheetFile.loadFromFile(path))
@@ -52,6 +183,8 @@ bool SpriteSheet::loadFromFile(const std::string& path, TextureResource& texture
     m_animations.clear();
     m_texturePath.clear();
     m_texture = nullptr;
+    m_smooth = false;
+    m_repeated = false;
 
     std::size_t count = 0;
 
@@ -62,7 +195,10 @@ bool SpriteSheet::loadFromFile(const std::string& path, TextureResource& texture
     if (auto* p = sheetFile.findProperty("src"))
     {
         m_texturePath = p->getValue<std::string>();
-        texture = &textures.get(workingDirectory + m_texturePath);
+        if (textures)
+        {
+            texture = &textures->get(workingDirectory + m_texturePath);
+        }
     }
     else
     {
@@ -80,12 +216,20 @@ bool SpriteSheet::loadFromFile(const std::string& path, TextureResource& texture
 
     if (auto* p = sheetFile.findProperty("smooth"))
     {
-        texture->setSmooth(p->getValue<bool>());
+        m_smooth = p->getValue<bool>();
+        if (texture)
+        {
+            texture->setSmooth(m_smooth);
+        }
     }
 
     if (auto* p = sheetFile.findProperty("repeat"))
     {
-        texture->setRepeated(p->getValue<bool>());
+        m_repeated = p->getValue<bool>();
+        if (texture)
+        {
+            texture->setRepeated(m_repeated);
+        }
     }
 
     const auto& sheetObjs = sheetFile.getObjects();
@@ -101,7 +245,10 @@ bool SpriteSheet::loadFromFile(const std::string& path, TextureResource& texture
             }
 
             Sprite spriteComponent;
-            spriteComponent.setTexture(*texture);
+            if (texture)
+            {
+                spriteComponent.setTexture(*texture);
+            }
 
             if (auto* p = spr.findProperty("blendmode"))
             {
@@ -189,126 +336,3 @@ bool SpriteSheet::loadFromFile(const std::string& path, TextureResource& texture
     //LOG("Found " + std::to_string(count) + " sprites in " + path, Logger::Type::Info);
     return count > 0;
 }
-
-bool SpriteSheet::saveToFile(const std::string& path)
-{
-    auto sheetName = FileSystem::getFileName(path);
-    sheetName = sheetName.substr(0, sheetName.find_last_of('.'));
-
-    ConfigFile sheetFile("spritesheet", sheetName);
-    sheetFile.addProperty("src", "\"" + m_texturePath + "\"");
-
-    if (m_texture)
-    {
-        sheetFile.addProperty("smooth").setValue(m_texture->isSmooth());
-        sheetFile.addProperty("repeat").setValue(m_texture->isRepeated());
-    }
-    else
-    {
-        sheetFile.addProperty("smooth").setValue(false);
-        sheetFile.addProperty("repeat").setValue(false);
-    }
-
-    for (const auto& [name, sprite] : m_sprites)
-    {
-        auto sprObj = sheetFile.addObject("sprite", name);
-        sprObj->addProperty("bounds").setValue(sprite.getTextureRect());
-        sprObj->addProperty("colour").setValue(sprite.getColour());
-
-        auto& anims = sprite.getAnimations();
-        for (auto i(0u); i < sprite.getAnimations().size(); i++)
-        {
-            auto animObj = sprObj->addObject("animation", m_animations[name][i]);
-            animObj->addProperty("framerate").setValue(anims[i].framerate);
-            animObj->addProperty("loop").setValue(anims[i].looped);
-            animObj->addProperty("loop_start").setValue(static_cast<std::int32_t>(anims[i].loopStart));
-
-            const auto& frames = anims[i].frames;
-            std::vector<glm::vec2> events;
-            for (auto j = 0u; j < anims[i].frames.size(); j++)
-            {
-                animObj->addProperty("frame").setValue(frames[j].frame);
-
-                if (anims[i].frames[j].event > -1)
-                {
-                    events.emplace_back(anims[i].frames[j].event, j);
-                }
-            }
-
-            for (const auto& evt : events)
-            {
-                animObj->addProperty("event").setValue(evt);
-            }
-        }
-    }
-
-    return sheetFile.save(path);
-}
-
-Sprite SpriteSheet::getSprite(const std::string& name) const
-{
-    if (m_sprites.count(name) != 0)
-    {
-        return m_sprites[name];
-    }
-    LOG(name + " not found in sprite sheet", Logger::Type::Warning);
-    return {};
-}
-
-std::int32_t SpriteSheet::getAnimationIndex(const std::string& name, const std::string& spriteName) const
-{
-    if (m_animations.count(spriteName) != 0)
-    {
-        const auto& anims = m_animations[spriteName];
-        const auto& result = std::find(anims.cbegin(), anims.cend(), name);
-        if (result == anims.cend()) return 0;
-
-        return static_cast<std::int32_t>(std::distance(anims.cbegin(), result));
-    }
-    return 0;
-}
-
-bool SpriteSheet::hasAnimation(const std::string& name, const std::string& spriteName) const
-{
-    if (m_animations.count(spriteName) != 0)
-    {
-        const auto& anims = m_animations[spriteName];
-        const auto& result = std::find(anims.cbegin(), anims.cend(), name);
-        return result != anims.cend();
-    }
-    return false;
-}
-
-void SpriteSheet::setTexture(const std::string& path, TextureResource& tr, const std::string& workingDir)
-{
-    m_texturePath = path;
-    m_texture = &tr.get(workingDir + path);
-
-    for (auto& sprite : m_sprites)
-    {
-        sprite.second.setTexture(*m_texture);
-    }
-}
-
-bool SpriteSheet::addSprite(const std::string& name)
-{
-    if (name.empty())
-    {
-        LogE << "Could not add sprite: name cannot be empty" << std::endl;
-        return false;
-    }
-
-    if (!m_texture)
-    {
-        LogE << "Failed adding " << name << ": no texture is set." << std::endl;
-        return false;
-    }
-
-    if (m_sprites.count(name) == 0)
-    {
-        m_sprites.insert(std::make_pair(name, Sprite()));
-        m_sprites[name].setTexture(*m_texture);
-        return true;
-    }
-    return false;
-}
\ No newline at end of file
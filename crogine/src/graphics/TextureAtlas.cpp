@@ -0,0 +1,367 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2024
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include <crogine/graphics/TextureAtlas.hpp>
+#include <crogine/graphics/Image.hpp>
+#include <crogine/graphics/SpriteSheet.hpp>
+#include <crogine/core/FileSystem.hpp>
+#include <crogine/core/Log.hpp>
+
+#include <limits>
+
+using namespace cro;
+
+TextureAtlas::TextureAtlas()
+    : m_padding(1)
+{
+
+}
+
+//public
+void TextureAtlas::create(std::uint32_t width, std::uint32_t height, std::uint32_t padding)
+{
+    CRO_ASSERT(width > 0 && height > 0, "");
+
+    m_rects.clear();
+    m_padding = padding;
+
+    m_texture.create(width, height, ImageFormat::RGBA);
+
+    //start with a clear texture as any padding is left untouched
+    std::vector<std::uint8_t> pixels(width * height * 4, 0);
+    m_texture.update(pixels.data());
+
+    //the skyline is extended by the padding so that images can
+    //be placed right up to the edges of the texture
+    m_skyline.clear();
+    m_skyline.push_back({ 0, 0, width + padding });
+}
+
+bool TextureAtlas::addImage(const std::string& name, const Image& image)
+{
+    if (m_skyline.empty())
+    {
+        LogE << "Failed adding " << name << " to texture atlas: atlas not created" << std::endl;
+        return false;
+    }
+
+    if (m_rects.count(name) != 0)
+    {
+        LogE << "Failed adding " << name << " to texture atlas: name already exists" << std::endl;
+        return false;
+    }
+
+    const auto size = image.getSize();
+    const auto* src = image.getPixelData();
+    if (src == nullptr || size.x == 0 || size.y == 0)
+    {
+        LogE << "Failed adding " << name << " to texture atlas: image is empty" << std::endl;
+        return false;
+    }
+
+    glm::uvec2 position(0);
+    std::size_t index = 0;
+    if (!findPosition(size.x + m_padding, size.y + m_padding, position, index))
+    {
+        LogE << "Failed adding " << name << " to texture atlas: no space left" << std::endl;
+        return false;
+    }
+
+    //the atlas is always RGBA
+    std::vector<std::uint8_t> pixels(size.x * size.y * 4);
+    const auto pixelCount = static_cast<std::size_t>(size.x) * size.y;
+    switch (image.getFormat())
+    {
+    default:
+        LogE << "Failed adding " << name << " to texture atlas: unsupported image format" << std::endl;
+        return false;
+    case ImageFormat::RGBA:
+        std::copy(src, src + pixels.size(), pixels.begin());
+        break;
+    case ImageFormat::RGB:
+        for (auto i = 0u; i < pixelCount; ++i)
+        {
+            pixels[i * 4] = src[i * 3];
+            pixels[i * 4 + 1] = src[i * 3 + 1];
+            pixels[i * 4 + 2] = src[i * 3 + 2];
+            pixels[i * 4 + 3] = 255;
+        }
+        break;
+    case ImageFormat::A:
+        for (auto i = 0u; i < pixelCount; ++i)
+        {
+            pixels[i * 4] = 255;
+            pixels[i * 4 + 1] = 255;
+            pixels[i * 4 + 2] = 255;
+            pixels[i * 4 + 3] = src[i];
+        }
+        break;
+    }
+
+    URect rect(position.x, position.y, size.x, size.y);
+    m_texture.update(pixels.data(), false, rect);
+    m_rects.insert(std::make_pair(name, rect));
+
+    addSkylineNode(index, position, size.x + m_padding, size.y + m_padding);
+
+    return true;
+}
+
+bool TextureAtlas::addImage(const std::string& path)
+{
+    Image image;
+    if (!image.loadFromFile(path))
+    {
+        return false;
+    }
+    return addImage(path, image);
+}
+
+bool TextureAtlas::addSpriteSheet(SpriteSheet& sheet, const std::string& workingDirectory)
+{
+    if (sheet.m_texture == &m_texture)
+    {
+        //already remapped
+        return true;
+    }
+
+    const auto& path = sheet.m_texturePath;
+    if (path.empty())
+    {
+        LogE << "Failed adding sprite sheet to texture atlas: sprite sheet has no texture" << std::endl;
+        return false;
+    }
+
+    if (sheet.m_texture ? sheet.m_texture->isRepeated() : sheet.m_repeated)
+    {
+        LogW << path << ": repeated textures are not supported by texture atlases" << std::endl;
+    }
+
+    if (!hasImage(path))
+    {
+        Image image;
+        if (!image.loadFromFile(workingDirectory + path)
+            || !addImage(path, image))
+        {
+            return false;
+        }
+    }
+
+    const auto rect = m_rects.at(path);
+    const glm::vec2 offset(static_cast<float>(rect.left), static_cast<float>(rect.bottom));
+
+    const auto remap = [&offset](FloatRect r)
+    {
+        r.left += offset.x;
+        r.bottom += offset.y;
+        return r;
+    };
+
+    for (auto& [name, sprite] : sheet.m_sprites)
+    {
+        sprite.setTexture(m_texture, false);
+        sprite.setTextureRect(remap(sprite.getTextureRect()));
+
+        for (auto& animation : sprite.getAnimations())
+        {
+            for (auto& frame : animation.frames)
+            {
+                frame.frame = remap(frame.frame);
+            }
+        }
+    }
+    sheet.m_texture = &m_texture;
+
+    return true;
+}
+
+bool TextureAtlas::packSpriteSheets(const std::vector<std::string>& sheetPaths, const std::string& imagePath, const std::string& workingDirectory)
+{
+    //the source textures are only needed as Images, so the sheets
+    //are loaded without creating a texture for each of them
+    std::vector<SpriteSheet> sheets(sheetPaths.size());
+
+    for (auto i = 0u; i < sheetPaths.size(); ++i)
+    {
+        if (!sheets[i].load(sheetPaths[i], nullptr, workingDirectory))
+        {
+            LogE << "Failed packing " << sheetPaths[i] << ": could not load sprite sheet" << std::endl;
+            return false;
+        }
+
+        if (!addSpriteSheet(sheets[i], workingDirectory))
+        {
+            LogE << "Failed packing " << sheetPaths[i] << std::endl;
+            return false;
+        }
+    }
+
+    if (!saveToFile(workingDirectory + imagePath))
+    {
+        return false;
+    }
+
+    bool result = true;
+    for (auto i = 0u; i < sheets.size(); ++i)
+    {
+        //clearing the texture means the smooth and repeat
+        //properties of the original sheet are written
+        sheets[i].m_texturePath = imagePath;
+        sheets[i].m_texture = nullptr;
+
+        const auto& path = sheetPaths[i];
+        const auto outPath = path.substr(0, path.size() - FileSystem::getFileExtension(path).size()) + "_packed.spt";
+        if (!sheets[i].saveToFile(outPath))
+        {
+            LogE << "Failed writing " << outPath << std::endl;
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+bool TextureAtlas::hasImage(const std::string& name) const
+{
+    return m_rects.count(name) != 0;
+}
+
+FloatRect TextureAtlas::getRect(const std::string& name) const
+{
+    if (auto result = m_rects.find(name); result != m_rects.end())
+    {
+        const auto& rect = result->second;
+        return FloatRect(static_cast<float>(rect.left), static_cast<float>(rect.bottom),
+                        static_cast<float>(rect.width), static_cast<float>(rect.height));
+    }
+    return {};
+}
+
+Sprite TextureAtlas::getSprite(const std::string& name) const
+{
+    if (!hasImage(name))
+    {
+        return {};
+    }
+
+    Sprite sprite(m_texture);
+    sprite.setTextureRect(getRect(name));
+    return sprite;
+}
+
+bool TextureAtlas::saveToFile(const std::string& path) const
+{
+    return m_texture.saveToFile(path);
+}
+
+//private
+bool TextureAtlas::findPosition(std::uint32_t width, std::uint32_t height, glm::uvec2& position, std::size_t& index) const
+{
+    const auto maxWidth = m_skyline.back().x + m_skyline.back().width;
+    const auto maxHeight = m_texture.getSize().y + m_padding;
+
+    //bottom-left: prefer the lowest top edge, then the narrowest
+    //node, so the result depends only on the order images are added
+    auto bestTop = std::numeric_limits<std::uint32_t>::max();
+    auto bestWidth = std::numeric_limits<std::uint32_t>::max();
+    bool found = false;
+
+    for (auto i = 0u; i < m_skyline.size(); ++i)
+    {
+        const auto x = m_skyline[i].x;
+        if (x + width > maxWidth)
+        {
+            break;
+        }
+
+        //the image rests on the highest node it spans
+        std::uint32_t y = 0;
+        std::uint32_t remaining = width;
+        for (auto j = i; remaining > 0; ++j)
+        {
+            y = std::max(y, m_skyline[j].y);
+            remaining -= std::min(remaining, m_skyline[j].width);
+        }
+
+        if (y + height <= maxHeight
+            && (y + height < bestTop
+                || (y + height == bestTop && m_skyline[i].width < bestWidth)))
+        {
+            bestTop = y + height;
+            bestWidth = m_skyline[i].width;
+            position = { x, y };
+            index = i;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+void TextureAtlas::addSkylineNode(std::size_t index, glm::uvec2 position, std::uint32_t width, std::uint32_t height)
+{
+    m_skyline.insert(m_skyline.begin() + index, { position.x, position.y + height, width });
+
+    //shrink or remove the nodes now covered by the new one
+    for (auto i = index + 1; i < m_skyline.size();)
+    {
+        const auto& previous = m_skyline[i - 1];
+        const auto previousEnd = previous.x + previous.width;
+        if (m_skyline[i].x >= previousEnd)
+        {
+            break;
+        }
+
+        const auto overlap = previousEnd - m_skyline[i].x;
+        if (m_skyline[i].width <= overlap)
+        {
+            m_skyline.erase(m_skyline.begin() + i);
+        }
+        else
+        {
+            m_skyline[i].x += overlap;
+            m_skyline[i].width -= overlap;
+            break;
+        }
+    }
+
+    //merge neighbouring nodes of the same height
+    for (auto i = 0u; i + 1 < m_skyline.size();)
+    {
+        if (m_skyline[i].y == m_skyline[i + 1].y)
+        {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
@@ -42,20 +42,12 @@ namespace cro::Shaders::Billboard
         ATTRIBUTE MED vec2 a_texCoord1; //contains the size of the billboard to which this vertex belongs
 
         uniform mat4 u_worldMatrix;
-        uniform mat4 u_viewMatrix;
-        uniform mat4 u_viewProjectionMatrix;
 
     #if defined(SHADOW_MAPPING)
         uniform mat4 u_cameraViewMatrix;
-        uniform mat4 u_projectionMatrix;
     #endif
 
-        uniform vec4 u_clipPlane;
-        uniform vec3 u_cameraWorldPosition;
-
-        #if defined (LOCK_SCALE)
-        uniform vec2 u_screenSize;
-        #endif
+#include PASS_UNIFORMS
 
         #if defined(RX_SHADOWS)
         #if !defined(MAX_CASCADES)
@@ -191,11 +183,9 @@ namespace cro::Shaders::Billboard
 
         #if defined(VERTEX_LIT)
         uniform samplerCube u_skybox;
-
-        uniform HIGH vec3 u_lightDirection;
-        uniform LOW vec4 u_lightColour;
-        uniform HIGH vec3 u_cameraWorldPosition;
         #endif
+
+#include PASS_UNIFORMS
         #if defined (RX_SHADOWS)
         #if defined (MOBILE)
         uniform sampler2D u_shadowMap;
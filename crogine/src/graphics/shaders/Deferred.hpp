@@ -54,12 +54,11 @@ namespace cro::Shaders::Deferred
         uniform mat4 u_boneMatrices[MAX_BONES];
     #endif
 
+#include PASS_UNIFORMS
+
         uniform mat4 u_worldMatrix;
         uniform mat4 u_worldViewMatrix;
         uniform mat3 u_normalMatrix;
-        uniform mat4 u_projectionMatrix;
-
-        uniform vec4 u_clipPlane;
         
     #if defined(BUMP)
         VARYING_OUT vec3 v_tbn[3];
@@ -447,7 +446,7 @@ namespace cro::Shaders::Deferred
         R"(
             out vec4[6] o_outColour;
 
-uniform mat4 u_viewMatrix;
+#include PASS_UNIFORMS
 
         #if defined(DIFFUSE_MAP)
             uniform sampler2D u_diffuseMap;
@@ -468,10 +467,6 @@ uniform mat4 u_viewMatrix;
         #endif
 
             uniform samplerCube u_skybox;
-
-            uniform HIGH vec3 u_lightDirection;
-            uniform LOW vec4 u_lightColour;
-            uniform HIGH vec3 u_cameraWorldPosition;
                 
         #if defined(COLOURED)
             uniform LOW vec4 u_colour;
@@ -18,7 +18,6 @@ namespace cro::Shaders::PBR
     layout (location = 0) out vec4 FRAG_OUT;
     layout (location = 1) out vec4 NORM_OUT;
     layout (location = 2) out vec4 POS_OUT;
-uniform mat4 u_viewMatrix;
 
         #if defined(DIFFUSE_MAP)
         uniform sampler2D u_diffuseMap;
@@ -43,9 +42,7 @@ uniform mat4 u_viewMatrix;
 #include SHADOWMAP_UNIFORMS_FRAG
         #endif
 
-        uniform vec3 u_lightDirection;
-        uniform vec4 u_lightColour;
-        uniform vec3 u_cameraWorldPosition;
+#include PASS_UNIFORMS
 
         uniform samplerCube u_irradianceMap;
         uniform samplerCube u_prefilterMap;
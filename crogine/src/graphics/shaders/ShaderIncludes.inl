@@ -51,6 +51,55 @@ R"(
     uniform mat4 u_projectionMatrix;
 )";
 
+//#include PASS_UNIFORMS
+//per-pass camera and lighting data, set once per pass by the renderer.
+//Layout must match cro::Detail::PassData. Mobile has no uniform blocks
+//so the values are set as regular uniforms instead. Shaders using this
+//should not also include WVP_UNIFORMS, use WORLD_UNIFORMS instead.
+//GL_FRAGMENT_PRECISION_HIGH is visible to both stages on GLES so the
+//precision chosen here is the same in vertex and fragment shaders.
+inline const std::string PassUniforms =
+R"(
+#if defined(MOBILE)
+#if defined(GL_FRAGMENT_PRECISION_HIGH)
+#define PASS_PRECISION highp
+#else
+#define PASS_PRECISION mediump
+#endif
+    uniform PASS_PRECISION mat4 u_viewMatrix;
+    uniform PASS_PRECISION mat4 u_viewProjectionMatrix;
+    uniform PASS_PRECISION mat4 u_projectionMatrix;
+    uniform PASS_PRECISION vec4 u_clipPlane;
+    uniform PASS_PRECISION vec3 u_cameraWorldPosition;
+    uniform PASS_PRECISION vec3 u_lightDirection;
+    uniform PASS_PRECISION vec4 u_lightColour;
+    uniform PASS_PRECISION vec2 u_screenSize;
+#else
+    layout (std140) uniform PassData
+    {
+        mat4 u_viewMatrix;
+        mat4 u_viewProjectionMatrix;
+        mat4 u_projectionMatrix;
+        vec4 u_clipPlane;
+        vec3 u_cameraWorldPosition;
+        vec3 u_lightDirection;
+        vec4 u_lightColour;
+        vec2 u_screenSize;
+    };
+#endif
+)";
+
+//#include WORLD_UNIFORMS
+//per-draw transform uniforms, used alongside PASS_UNIFORMS
+inline const std::string WorldUniforms =
+R"(
+#if !defined(INSTANCING)
+    uniform mat4 u_worldViewMatrix;
+    uniform mat3 u_normalMatrix;
+#endif
+    uniform mat4 u_worldMatrix;
+)";
+
 
 
 //#include INSTANCE_ATTRIBS
@@ -48,9 +48,8 @@ namespace cro::Shaders::ShadowMap
 #include SKIN_UNIFORMS
     #endif
 
-#include WVP_UNIFORMS
-
-        uniform vec4 u_clipPlane;
+#include PASS_UNIFORMS
+#include WORLD_UNIFORMS
 
     #if defined (MOBILE)
         VARYING_OUT vec4 v_position;
@@ -96,22 +96,29 @@ namespace cro::Shaders::Text
             //FRAG_OUT = v_colour;
         })";
 
+    //used with the Sprite vertex shader. Smoothing and
+    //outline thickness are in distance field units, where
+    //the edge of the glyph is 0.5, and are set by the TextSystem
     inline const std::string SDFFragment = R"(
         uniform sampler2D u_texture;
-                
+        uniform LOW vec4 u_outlineColour;
+        uniform MED float u_outlineThickness;
+        uniform MED float u_smoothing;
+
         VARYING_IN LOW vec4 v_colour;
-        VARYING_IN MED vec2 v_texCoord0;
+        VARYING_IN MED vec2 v_texCoord;
         OUTPUT
 
-        MED float spread = 4.0;
-        MED float scale = 5.0;
-        MED float smoothing = 1.0 / 16.0;
-
         void main()
         {
-            //smoothing = 0.25 / (spread * scale);
-            MED float value = TEXTURE(u_texture, v_texCoord0).r;
-            MED float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, value);
-            FRAG_OUT = vec4(v_colour.rgb, v_colour.a * alpha);
+            MED float value = TEXTURE(u_texture, v_texCoord).a;
+            MED float fill = smoothstep(0.5 - u_smoothing, 0.5 + u_smoothing, value);
+
+            MED float edge = 0.5 - u_outlineThickness;
+            MED float alpha = smoothstep(edge - u_smoothing, edge + u_smoothing, value);
+
+            LOW vec4 outlineColour = u_outlineThickness > 0.0 ? u_outlineColour : v_colour;
+            LOW vec4 colour = mix(outlineColour, v_colour, fill);
+            FRAG_OUT = vec4(colour.rgb, colour.a * alpha);
         })";
 }
\ No newline at end of file
@@ -62,9 +62,8 @@ namespace cro::Shaders::Unlit
         uniform LOW int u_projectionMapCount; //how many to actually draw
     #endif
 
-#include WVP_UNIFORMS
-
-        uniform vec4 u_clipPlane;
+#include PASS_UNIFORMS
+#include WORLD_UNIFORMS
 
     #if defined(RX_SHADOWS)
 #include SHADOWMAP_UNIFORMS_VERT
@@ -195,9 +194,10 @@ namespace cro::Shaders::Unlit
     #if defined(RIMMING)
         uniform LOW vec4 u_rimColour;
         uniform LOW float u_rimFalloff;
-        uniform HIGH vec3 u_cameraWorldPosition;
     #endif
 
+#include PASS_UNIFORMS
+
     #if defined (VERTEX_COLOUR)
         VARYING_IN LOW vec4 v_colour;
     #endif
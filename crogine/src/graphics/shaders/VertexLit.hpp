@@ -64,9 +64,8 @@ namespace cro::Shaders::VertexLit
         uniform LOW int u_projectionMapCount; //how many to actually draw
     #endif
 
-#include WVP_UNIFORMS
-
-        uniform vec4 u_clipPlane;
+#include PASS_UNIFORMS
+#include WORLD_UNIFORMS
 
     #if defined(RX_SHADOWS)
 #include SHADOWMAP_UNIFORMS_VERT
@@ -203,9 +202,7 @@ namespace cro::Shaders::VertexLit
 
         uniform samplerCube u_skybox;
 
-        uniform HIGH vec3 u_lightDirection;
-        uniform LOW vec4 u_lightColour;
-        uniform HIGH vec3 u_cameraWorldPosition;
+#include PASS_UNIFORMS
                 
     #if defined(COLOURED)
         uniform LOW vec4 u_colour;
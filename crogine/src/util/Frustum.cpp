@@ -36,7 +36,16 @@ https://bruop.github.io/improved_frustum_culling/
 #include <crogine/detail/glm/vec3.hpp>
 
 #include <array>
+#include <algorithm>
+#include <cmath>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CRO_FRUSTUM_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CRO_FRUSTUM_NEON
+#include <arm_neon.h>
+#endif
 
 using namespace cro;
 
@@ -48,6 +57,31 @@ namespace
         glm::vec3 extents = glm::vec3(0.f);
         std::array<glm::vec3, 3u> axes = { glm::vec3(0.f),glm::vec3(0.f), glm::vec3(0.f) };
     };
+
+    //the SIMD paths load four spheres at a time as radius, x, y, z
+    static_assert(sizeof(Sphere) == sizeof(float) * 4, "Sphere must be tightly packed");
+
+    //Spatial::intersects() is the reference test. The SIMD paths use the
+    //same expression, visible if (|dist| <= radius || dist > 0), evaluated
+    //in the same order, so that results also agree for NaN and infinite
+    //values, spheres with a negative radius and boxes with min > max.
+    template <typename T>
+    bool shapeVisible(const cro::Frustum& frustum, const T& shape)
+    {
+        for (const auto& plane : frustum)
+        {
+            if (Spatial::intersects(plane, shape) == Planar::Back)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void setBit(std::uint32_t* output, std::size_t index)
+    {
+        output[index / 32] |= (1u << (index % 32));
+    }
 }
 
 bool cro::Util::Frustum::visible(FrustumData frustum, const glm::mat4& viewSpaceTransform, Box aabb)
@@ -334,4 +368,173 @@ bool cro::Util::Frustum::visible(FrustumData frustum, const glm::mat4& viewSpace
     }
 
     return true;
-}
\ No newline at end of file
+}
+
+void cro::Util::Frustum::visible(const cro::Frustum& frustum, const Sphere* spheres, std::size_t count, std::uint32_t* output)
+{
+    std::fill(output, output + ((count + 31) / 32), 0u);
+
+    //as the output is 32 bits wide and spheres are tested in groups
+    //of 4 each group's result can be shifted directly into place
+    std::size_t i = 0;
+
+#ifdef CRO_FRUSTUM_SSE
+    const auto signMask = _mm_set1_ps(-0.f);
+    for (; i + 4 <= count; i += 4)
+    {
+        auto radius = _mm_loadu_ps(&spheres[i].radius);
+        auto x = _mm_loadu_ps(&spheres[i + 1].radius);
+        auto y = _mm_loadu_ps(&spheres[i + 2].radius);
+        auto z = _mm_loadu_ps(&spheres[i + 3].radius);
+        _MM_TRANSPOSE4_PS(radius, x, y, z);
+
+        auto inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps()); //all true
+
+        for (const auto& plane : frustum)
+        {
+            auto dist = _mm_mul_ps(x, _mm_set1_ps(plane.x));
+            dist = _mm_add_ps(dist, _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+            dist = _mm_add_ps(dist, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+            dist = _mm_add_ps(dist, _mm_set1_ps(plane.w));
+
+            inside = _mm_and_ps(inside, _mm_or_ps(_mm_cmple_ps(_mm_andnot_ps(signMask, dist), radius), _mm_cmpgt_ps(dist, _mm_setzero_ps())));
+        }
+
+        output[i / 32] |= static_cast<std::uint32_t>(_mm_movemask_ps(inside)) << (i % 32);
+    }
+#elif defined(CRO_FRUSTUM_NEON)
+    for (; i + 4 <= count; i += 4)
+    {
+        //deinterleaves into radius, x, y, z
+        const auto sphere = vld4q_f32(&spheres[i].radius);
+        auto inside = vdupq_n_u32(0xffffffff);
+
+        for (const auto& plane : frustum)
+        {
+            //multiply and add are kept separate so they aren't fused
+            auto dist = vmulq_n_f32(sphere.val[1], plane.x);
+            dist = vaddq_f32(dist, vmulq_n_f32(sphere.val[2], plane.y));
+            dist = vaddq_f32(dist, vmulq_n_f32(sphere.val[3], plane.z));
+            dist = vaddq_f32(dist, vdupq_n_f32(plane.w));
+
+            inside = vandq_u32(inside, vorrq_u32(vcleq_f32(vabsq_f32(dist), sphere.val[0]), vcgtq_f32(dist, vdupq_n_f32(0.f))));
+        }
+
+        const std::uint32_t mask = (vgetq_lane_u32(inside, 0) & 1)
+            | (vgetq_lane_u32(inside, 1) & 2)
+            | (vgetq_lane_u32(inside, 2) & 4)
+            | (vgetq_lane_u32(inside, 3) & 8);
+        output[i / 32] |= mask << (i % 32);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        if (shapeVisible(frustum, spheres[i]))
+        {
+            setBit(output, i);
+        }
+    }
+}
+
+void cro::Util::Frustum::visible(const cro::Frustum& frustum, const Box* boxes, std::size_t count, std::uint32_t* output)
+{
+    std::fill(output, output + ((count + 31) / 32), 0u);
+
+    std::size_t i = 0;
+
+#ifdef CRO_FRUSTUM_SSE
+    //boxes aren't a multiple of 16 bytes so are gathered one
+    //component at a time, then converted to centre/extents
+    const auto half = _mm_set1_ps(0.5f);
+    const auto signMask = _mm_set1_ps(-0.f);
+    for (; i + 4 <= count; i += 4)
+    {
+        const auto& b0 = boxes[i];
+        const auto& b1 = boxes[i + 1];
+        const auto& b2 = boxes[i + 2];
+        const auto& b3 = boxes[i + 3];
+
+        const auto minX = _mm_setr_ps(b0[0].x, b1[0].x, b2[0].x, b3[0].x);
+        const auto minY = _mm_setr_ps(b0[0].y, b1[0].y, b2[0].y, b3[0].y);
+        const auto minZ = _mm_setr_ps(b0[0].z, b1[0].z, b2[0].z, b3[0].z);
+        const auto maxX = _mm_setr_ps(b0[1].x, b1[1].x, b2[1].x, b3[1].x);
+        const auto maxY = _mm_setr_ps(b0[1].y, b1[1].y, b2[1].y, b3[1].y);
+        const auto maxZ = _mm_setr_ps(b0[1].z, b1[1].z, b2[1].z, b3[1].z);
+
+        const auto extX = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+        const auto extY = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+        const auto extZ = _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half);
+        const auto x = _mm_add_ps(minX, extX);
+        const auto y = _mm_add_ps(minY, extY);
+        const auto z = _mm_add_ps(minZ, extZ);
+
+        auto inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps()); //all true
+
+        for (const auto& plane : frustum)
+        {
+            auto dist = _mm_mul_ps(x, _mm_set1_ps(plane.x));
+            dist = _mm_add_ps(dist, _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+            dist = _mm_add_ps(dist, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+            dist = _mm_add_ps(dist, _mm_set1_ps(plane.w));
+
+            //extents weighted by the plane normal, as Spatial::intersects()
+            auto radius = _mm_andnot_ps(signMask, _mm_mul_ps(extX, _mm_set1_ps(plane.x)));
+            radius = _mm_add_ps(radius, _mm_andnot_ps(signMask, _mm_mul_ps(extY, _mm_set1_ps(plane.y))));
+            radius = _mm_add_ps(radius, _mm_andnot_ps(signMask, _mm_mul_ps(extZ, _mm_set1_ps(plane.z))));
+
+            inside = _mm_and_ps(inside, _mm_or_ps(_mm_cmple_ps(_mm_andnot_ps(signMask, dist), radius), _mm_cmpgt_ps(dist, _mm_setzero_ps())));
+        }
+
+        output[i / 32] |= static_cast<std::uint32_t>(_mm_movemask_ps(inside)) << (i % 32);
+    }
+#elif defined(CRO_FRUSTUM_NEON)
+    for (; i + 4 <= count; i += 4)
+    {
+        std::array<float, 4u> minX = {}, minY = {}, minZ = {}, maxX = {}, maxY = {}, maxZ = {};
+        for (auto j = 0u; j < 4u; ++j)
+        {
+            const auto& box = boxes[i + j];
+            minX[j] = box[0].x; minY[j] = box[0].y; minZ[j] = box[0].z;
+            maxX[j] = box[1].x; maxY[j] = box[1].y; maxZ[j] = box[1].z;
+        }
+
+        const auto extX = vmulq_n_f32(vsubq_f32(vld1q_f32(maxX.data()), vld1q_f32(minX.data())), 0.5f);
+        const auto extY = vmulq_n_f32(vsubq_f32(vld1q_f32(maxY.data()), vld1q_f32(minY.data())), 0.5f);
+        const auto extZ = vmulq_n_f32(vsubq_f32(vld1q_f32(maxZ.data()), vld1q_f32(minZ.data())), 0.5f);
+        const auto x = vaddq_f32(vld1q_f32(minX.data()), extX);
+        const auto y = vaddq_f32(vld1q_f32(minY.data()), extY);
+        const auto z = vaddq_f32(vld1q_f32(minZ.data()), extZ);
+
+        auto inside = vdupq_n_u32(0xffffffff);
+
+        for (const auto& plane : frustum)
+        {
+            auto dist = vmulq_n_f32(x, plane.x);
+            dist = vaddq_f32(dist, vmulq_n_f32(y, plane.y));
+            dist = vaddq_f32(dist, vmulq_n_f32(z, plane.z));
+            dist = vaddq_f32(dist, vdupq_n_f32(plane.w));
+
+            auto radius = vabsq_f32(vmulq_n_f32(extX, plane.x));
+            radius = vaddq_f32(radius, vabsq_f32(vmulq_n_f32(extY, plane.y)));
+            radius = vaddq_f32(radius, vabsq_f32(vmulq_n_f32(extZ, plane.z)));
+
+            inside = vandq_u32(inside, vorrq_u32(vcleq_f32(vabsq_f32(dist), radius), vcgtq_f32(dist, vdupq_n_f32(0.f))));
+        }
+
+        const std::uint32_t mask = (vgetq_lane_u32(inside, 0) & 1)
+            | (vgetq_lane_u32(inside, 1) & 2)
+            | (vgetq_lane_u32(inside, 2) & 4)
+            | (vgetq_lane_u32(inside, 3) & 8);
+        output[i / 32] |= mask << (i % 32);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        if (shapeVisible(frustum, boxes[i]))
+        {
+            setBit(output, i);
+        }
+    }
+}
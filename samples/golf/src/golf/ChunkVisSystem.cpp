@@ -34,6 +34,7 @@ source distribution.
 #include <crogine/ecs/Scene.hpp>
 #include <crogine/ecs/components/Camera.hpp>
 #include <crogine/util/Matrix.hpp>
+#include <crogine/util/Frustum.hpp>
 
 namespace
 {
@@ -85,6 +86,10 @@ void ChunkVisSystem::process(float)
     narrowphaseCount = 0;
     m_narrowphaseTimer.begin();
 #endif
+    //all planes face inwards
+    std::array<std::uint32_t, (ChunkCount + 31) / 32> visibility = {};
+    cro::Util::Frustum::visible(frustum, m_boundingBoxes.data(), m_boundingBoxes.size(), visibility.data());
+
     for (auto i = 0; i < ChunkCount; ++i)
     {
         auto dir = camPos - m_boundingBoxes[i].getCentre();
@@ -103,15 +108,7 @@ void ChunkVisSystem::process(float)
             continue;
         }
 
-        //all planes face inwards
-        bool intersects = true;
-        auto j = 0;
-        do
-        {
-            intersects = cro::Spatial::intersects(frustum[j++], m_boundingBoxes[i]) != cro::Planar::Back;
-        } while (intersects && j < 6);
-
-        if (intersects)
+        if (visibility[i / 32] & (1u << (i % 32)))
         {
             m_currentIndex |= (1 << i);
             m_indexList.push_back(i);
@@ -139,6 +139,11 @@ private:
 
 	glm::vec3 m_interpVelocity = glm::vec3(0.f);
 
+	//the transform is set after all entities are interpolated
+	glm::vec3 m_targetPosition = glm::vec3(0.f);
+	glm::quat m_targetRotation = glm::quat(1.f, 0.f, 0.f, 0.f);
+	bool m_hasTarget = false;
+
 	static constexpr std::int32_t MaxTimeGap = 250;
 
 	template <InterpolationType>
@@ -169,9 +174,14 @@ public:
 
 	void process(float dt) override
 	{
-		for (auto entity : getEntities())
+		//each entity is interpolated independently so they can be processed in
+		//parallel. Setting a transform also marks its children dirty, which may
+		//be shared with other interpolated entities, so the results are applied
+		//afterwards on this thread.
+		parallelForEach([&](cro::Entity entity)
 		{
 			auto& interp = entity.template getComponent<InterpolationComponent<Interpolation>>();
+			interp.m_hasTarget = false;
 
 			if (interp.m_buffer.size() > 1)
 			{
@@ -230,7 +240,7 @@ public:
 								(-2.f * t3 + 3.f * t2)      * endPos +
 								(t3 - t2)                   * duration * endVel;
 
-							entity.template getComponent<cro::Transform>().setPosition(position);
+							interp.m_targetPosition = position;
 
 							interp.m_interpVelocity = 1.f / duration * (
 								(6.f * t2 - 6.f * t)       * startPos +
@@ -245,15 +255,15 @@ public:
 							auto position = interp.m_buffer[0].position + (diff * t);
 
 							auto lastPos = entity.template getComponent<cro::Transform>().getPosition();
-							entity.template getComponent<cro::Transform>().setPosition(position);
+							interp.m_targetPosition = position;
 #ifdef CRO_DEBUG_
 							interp.addPosition(position);
 #endif
 							interp.m_interpVelocity = (position - lastPos) * (1.f / dt);// 60.f; //fixed step... should be 1/dt?
 						}
 
-						auto rotation = glm::slerp(interp.m_buffer[0].rotation, interp.m_buffer[1].rotation, t);
-						entity.template getComponent<cro::Transform>().setRotation(rotation);
+						interp.m_targetRotation = glm::slerp(interp.m_buffer[0].rotation, interp.m_buffer[1].rotation, t);
+						interp.m_hasTarget = true;
 					}
 				}
 //#ifdef CRO_DEBUG_
@@ -264,6 +274,17 @@ public:
 			{
 				interp.m_wantsBuffer = true;
 			}
+		});
+
+		for (auto entity : getEntities())
+		{
+			const auto& interp = entity.template getComponent<InterpolationComponent<Interpolation>>();
+			if (interp.m_hasTarget)
+			{
+				auto& tx = entity.template getComponent<cro::Transform>();
+				tx.setPosition(interp.m_targetPosition);
+				tx.setRotation(interp.m_targetRotation);
+			}
 		}
 	}
 
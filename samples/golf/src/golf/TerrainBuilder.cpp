@@ -211,7 +211,11 @@ TerrainBuilder::TerrainBuilder(SharedStateData& sd, const std::vector<HoleData>&
 
 TerrainBuilder::~TerrainBuilder()
 {
-    m_threadRunning = false;
+    {
+        std::scoped_lock lock(m_mutex);
+        m_threadRunning = false;
+    }
+    m_condition.notify_all();
 
     if (m_thread)
     {
@@ -675,7 +679,10 @@ void TerrainBuilder::update(std::size_t holeIndex)
     //wait for thread to finish (usually only the first time)
     //this *shouldn't* ever block unless something goes wrong
     //in which case we need to implement a get-out clause
-    while (m_wantsUpdate) {}
+    {
+        std::unique_lock lock(m_mutex);
+        m_condition.wait(lock, [&]() { return !m_wantsUpdate; });
+    }
 
     if (holeIndex == m_currentHole)
     {
@@ -782,7 +789,11 @@ void TerrainBuilder::update(std::size_t holeIndex)
         if (m_currentHole < m_holeData.size())
         {
             renderNormalMap();
-            m_wantsUpdate = true;
+            {
+                std::scoped_lock lock(m_mutex);
+                m_wantsUpdate = true;
+            }
+            m_condition.notify_all();
         }
     }
 }
@@ -925,6 +936,12 @@ void TerrainBuilder::threadFunc()
 
     while (m_threadRunning)
     {
+        //sleep until there's a layout to build rather than polling
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [&]() { return m_wantsUpdate || !m_threadRunning; });
+        }
+
         if (m_wantsUpdate)
         {
             //should be empty anyway because we clear after assigning them
@@ -1306,11 +1323,11 @@ void TerrainBuilder::threadFunc()
                 m_slopeProperties.meshData->vertexCount = static_cast<std::uint32_t>(m_slopeBuffer.size());
             }
 
-            m_wantsUpdate = false;
-        }
-        else
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            {
+                std::scoped_lock lock(m_mutex);
+                m_wantsUpdate = false;
+            }
+            m_condition.notify_all();
         }
     }
 }
@@ -45,6 +45,8 @@ source distribution.
 #include <vector>
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <memory>
 #include <array>
 
@@ -172,6 +174,8 @@ private:
 
     std::atomic_bool m_threadRunning;
     std::atomic_bool m_wantsUpdate;
+    std::mutex m_mutex;
+    std::condition_variable m_condition; //signalled when m_wantsUpdate or m_threadRunning changes
     std::unique_ptr<std::thread> m_thread;
 
     void threadFunc();
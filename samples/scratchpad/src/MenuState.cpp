@@ -388,6 +388,19 @@ void MenuState::createScene()
                 }
             });
 
+    //engine benchmarks
+    textPos.y -= MenuSpacing;
+    entity = createButton("Benchmarks", textPos);
+    entity.getComponent<cro::UIInput>().callbacks[cro::UIInput::ButtonUp] =
+        uiSystem->addCallback([&](cro::Entity e, const cro::ButtonEvent& evt)
+            {
+                if (activated(evt))
+                {
+                    requestStackClear();
+                    requestStackPush(States::ScratchPad::Bench);
+                }
+            });
+
     //load plugin
     textPos.y -= MenuSpacing;
     entity = createButton("Load Plugin", textPos);
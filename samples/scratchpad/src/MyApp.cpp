@@ -30,6 +30,7 @@ source distribution.
 #include "MyApp.hpp"
 #include "MenuState.hpp"
 #include "batcat/BatcatState.hpp"
+#include "bench/BenchState.hpp"
 #include "billiards/BilliardsState.hpp"
 #include "bounce/BounceState.hpp"
 #include "bush/BushState.hpp"
@@ -153,6 +154,7 @@ bool MyApp::initialise()
 
     m_stateStack.registerState<sp::MenuState>(States::ScratchPad::MainMenu, *this);
     m_stateStack.registerState<BatcatState>(States::ScratchPad::BatCat);
+    m_stateStack.registerState<BenchState>(States::ScratchPad::Bench);
     m_stateStack.registerState<BilliardsState>(States::ScratchPad::Billiards);
     m_stateStack.registerState<BushState>(States::ScratchPad::Bush);
     m_stateStack.registerState<BspState>(States::ScratchPad::BSP);
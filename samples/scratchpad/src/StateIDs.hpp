@@ -38,6 +38,7 @@ namespace States
             MainMenu,
             AnimBlend,
             BatCat,
+            Bench,
             Billiards,
             Bounce,
             Bush,
@@ -0,0 +1,1281 @@
+//Auto-generated source file for Scratchpad Stub 17/10/2026, 09:12:40
+
+#include "BenchState.hpp"
+
+#include <crogine/core/App.hpp>
+#include <crogine/core/HiResTimer.hpp>
+#include <crogine/gui/Gui.hpp>
+
+#include <crogine/ecs/components/Camera.hpp>
+#include <crogine/ecs/components/Drawable2D.hpp>
+#include <crogine/ecs/components/Model.hpp>
+#include <crogine/ecs/components/ParticleEmitter.hpp>
+#include <crogine/ecs/components/Text.hpp>
+#include <crogine/ecs/components/Transform.hpp>
+
+#include <crogine/ecs/systems/CameraSystem.hpp>
+#include <crogine/ecs/systems/ModelRenderer.hpp>
+#include <crogine/ecs/systems/ParticleSystem.hpp>
+#include <crogine/ecs/systems/RenderSystem2D.hpp>
+#include <crogine/ecs/systems/TextSystem.hpp>
+
+#include <crogine/graphics/CubeBuilder.hpp>
+#include <crogine/graphics/Font.hpp>
+#include <crogine/graphics/Image.hpp>
+#include <crogine/graphics/MaterialResource.hpp>
+#include <crogine/graphics/MeshResource.hpp>
+#include <crogine/graphics/RenderTexture.hpp>
+#include <crogine/graphics/ShaderResource.hpp>
+#include <crogine/graphics/Texture.hpp>
+#include <crogine/graphics/TextureAtlas.hpp>
+
+#include <crogine/util/Constants.hpp>
+#include <crogine/util/Frustum.hpp>
+#include <crogine/util/Random.hpp>
+
+#include <crogine/detail/glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <thread>
+#include <typeindex>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t EntityCount = 20000;
+    constexpr std::size_t Iterations = 50;
+
+    //used to stop the optimiser removing the work being measured
+    volatile float sink = 0.f;
+
+    std::string nsPer(float seconds, std::size_t count)
+    {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(2) << (seconds * 1000000000.f) / static_cast<float>(count) << "ns";
+        return ss.str();
+    }
+
+    //compares the old type_index/dynamic_cast lookup with the
+    //cached component ID used by the EntityManager
+    std::string componentLookup(cro::MessageBus& mb)
+    {
+        //a handful of types registered first is typical of most scenes
+        struct A final {}; struct B final {}; struct C final {}; struct D final {};
+        struct E final {}; struct F final {}; struct G final {}; struct H final {};
+        using Component = glm::vec3;
+
+        std::vector<std::type_index> legacyIDs =
+        {
+            typeid(A), typeid(B), typeid(C), typeid(D),
+            typeid(E), typeid(F), typeid(G), typeid(H),
+            typeid(Component)
+        };
+        std::vector<std::unique_ptr<cro::Detail::Pool>> pools(legacyIDs.size());
+        auto componentPool = std::make_unique<cro::Detail::ComponentPool<Component>>(EntityCount);
+        for (auto i = 0u; i < EntityCount; ++i)
+        {
+            componentPool->insert(i, Component(1.f));
+        }
+        pools.back() = std::move(componentPool);
+
+        cro::ComponentManager cm;
+        cm.getID<A>(); cm.getID<B>(); cm.getID<C>(); cm.getID<D>();
+        cm.getID<E>(); cm.getID<F>(); cm.getID<G>(); cm.getID<H>();
+        cm.getID<Component>();
+
+        cro::HiResTimer timer;
+        float sum = 0.f;
+        for (auto i = 0u; i < Iterations; ++i)
+        {
+            for (auto j = 0u; j < EntityCount; ++j)
+            {
+                auto id = std::distance(legacyIDs.begin(), std::find(legacyIDs.begin(), legacyIDs.end(), std::type_index(typeid(Component))));
+                auto* pool = dynamic_cast<cro::Detail::ComponentPool<Component>*>(pools[id].get());
+                sum += (*pool)[j].x;
+            }
+        }
+        const auto legacyTime = timer.restart();
+
+        for (auto i = 0u; i < Iterations; ++i)
+        {
+            for (auto j = 0u; j < EntityCount; ++j)
+            {
+                auto id = cm.getID<Component>();
+                auto* pool = static_cast<cro::Detail::ComponentPool<Component>*>(pools[id].get());
+                sum += (*pool)[j].x;
+            }
+        }
+        const auto cachedTime = timer.restart();
+
+
+        //and the full round trip through an Entity handle
+        cro::Scene scene(mb);
+        std::vector<cro::Entity> entities;
+        for (auto i = 0u; i < EntityCount; ++i)
+        {
+            auto entity = scene.createEntity();
+            entity.addComponent<cro::Transform>();
+            entities.push_back(entity);
+        }
+
+        timer.restart();
+        for (auto i = 0u; i < Iterations; ++i)
+        {
+            for (auto e : entities)
+            {
+                sum += e.getComponent<cro::Transform>().getPosition().x;
+            }
+        }
+        const auto entityTime = timer.restart();
+        sink = sum;
+
+        const auto count = EntityCount * Iterations;
+        return "Legacy: " + nsPer(legacyTime, count)
+            + "\nCached: " + nsPer(cachedTime, count)
+            + "\nEntity::getComponent(): " + nsPer(entityTime, count);
+    }
+
+    //compares fetching every component via its entity with
+    //iterating the packed component pool directly
+    std::string componentIteration(cro::MessageBus& mb)
+    {
+        struct Velocity final
+        {
+            glm::vec3 value = glm::vec3(1.f);
+        };
+
+        //sparsely populate the scene, as we might with particle emitters
+        cro::Scene scene(mb);
+        std::vector<cro::Entity> entities;
+        for (auto i = 0u; i < EntityCount; ++i)
+        {
+            auto entity = scene.createEntity();
+            if (i % 8 == 0)
+            {
+                entity.addComponent<Velocity>();
+                entities.push_back(entity);
+            }
+        }
+
+        cro::HiResTimer timer;
+        float sum = 0.f;
+        for (auto i = 0u; i < Iterations; ++i)
+        {
+            for (auto e : entities)
+            {
+                sum += e.getComponent<Velocity>().value.x;
+            }
+        }
+        const auto entityTime = timer.restart();
+
+        auto& pool = scene.getComponentPool<Velocity>();
+        for (auto i = 0u; i < Iterations; ++i)
+        {
+            for (const auto& v : pool)
+            {
+                sum += v.value.x;
+            }
+        }
+        const auto poolTime = timer.restart();
+        sink = sum;
+
+        const auto count = entities.size() * Iterations;
+        return "Via Entity: " + nsPer(entityTime, count)
+            + "\nPacked Pool: " + nsPer(poolTime, count);
+    }
+
+    //compares updating world transforms on demand with
+    //the batched update performed by Scene::simulate()
+    std::string transformUpdate(cro::MessageBus& mb)
+    {
+        //chains of transforms, similar to skeletal attachments
+        constexpr std::size_t ChainLength = 8;
+
+        cro::Scene scene(mb);
+        std::vector<cro::Entity> roots;
+        std::vector<cro::Entity> entities;
+        for (auto i = 0u; i < EntityCount / ChainLength; ++i)
+        {
+            auto parent = scene.createEntity();
+            parent.addComponent<cro::Transform>().setPosition(glm::vec3(static_cast<float>(i), 0.f, 0.f));
+            roots.push_back(parent);
+            entities.push_back(parent);
+
+            for (auto j = 1u; j < ChainLength; ++j)
+            {
+                auto entity = scene.createEntity();
+                entity.addComponent<cro::Transform>().setPosition(glm::vec3(0.f, 1.f, 0.f));
+                entity.getComponent<cro::Transform>().setOrigin(glm::vec3(0.1f));
+                parent.getComponent<cro::Transform>().addChild(entity.getComponent<cro::Transform>());
+                entities.push_back(entity);
+                parent = entity;
+            }
+        }
+        scene.simulate(0.f);
+
+        cro::HiResTimer timer;
+        float sum = 0.f;
+        for (auto i = 0u; i < Iterations; ++i)
+        {
+            for (auto e : roots)
+            {
+                e.getComponent<cro::Transform>().rotate(cro::Transform::Y_AXIS, 0.1f);
+            }
+
+            for (auto e : entities)
+            {
+                sum += e.getComponent<cro::Transform>().getWorldTransform()[3].x;
+            }
+        }
+        const auto lazyTime = timer.restart();
+
+        for (auto i = 0u; i < Iterations; ++i)
+        {
+            for (auto e : roots)
+            {
+                e.getComponent<cro::Transform>().rotate(cro::Transform::Y_AXIS, 0.1f);
+            }
+
+            scene.simulate(0.f);
+            for (auto e : entities)
+            {
+                sum += e.getComponent<cro::Transform>().getWorldTransform()[3].x;
+            }
+        }
+        const auto batchTime = timer.restart();
+        sink = sum;
+
+        const auto count = entities.size() * Iterations;
+        return "On Demand: " + nsPer(lazyTime, count)
+            + "\nBatched: " + nsPer(batchTime, count);
+    }
+
+    //measures adding and removing entities from several systems
+    //at once, as happens when a level is created or torn down
+    std::string systemMembership(cro::MessageBus& mb)
+    {
+        class TransformSystem final : public cro::System
+        {
+        public:
+            explicit TransformSystem(cro::MessageBus& mb)
+                : cro::System(mb, typeid(TransformSystem))
+            {
+                requireComponent<cro::Transform>();
+            }
+        };
+
+        cro::Scene scene(mb);
+        scene.addSystem<TransformSystem>(mb);
+        scene.addSystem<cro::CameraSystem>(mb);
+
+        cro::HiResTimer timer;
+        float addTime = 0.f;
+        float removeTime = 0.f;
+        for (auto i = 0u; i < 5; ++i)
+        {
+            std::vector<cro::Entity> entities;
+            for (auto j = 0u; j < EntityCount; ++j)
+            {
+                auto entity = scene.createEntity();
+                entity.addComponent<cro::Transform>();
+                entities.push_back(entity);
+            }
+
+            timer.restart();
+            scene.simulate(0.f);
+            addTime += timer.restart();
+
+            //destroy in creation order, which was the worst
+            //case for removal when it preserved the list order
+            for (auto e : entities)
+            {
+                scene.destroyEntity(e);
+            }
+
+            timer.restart();
+            scene.simulate(0.f);
+            removeTime += timer.restart();
+        }
+
+        const auto count = EntityCount * 5;
+        return "Add: " + nsPer(addTime, count)
+            + "\nRemove: " + nsPer(removeTime, count);
+    }
+
+    //compares toggling a transient component with recreating
+    //the entity without it, which was previously required
+    std::string componentRemoval(cro::MessageBus& mb)
+    {
+        struct Highlight final
+        {
+            float amount = 1.f;
+        };
+
+        class HighlightSystem final : public cro::System
+        {
+        public:
+            explicit HighlightSystem(cro::MessageBus& mb)
+                : cro::System(mb, typeid(HighlightSystem))
+            {
+                requireComponent<cro::Transform>();
+                requireComponent<Highlight>();
+            }
+        };
+
+        cro::Scene scene(mb);
+        scene.addSystem<HighlightSystem>(mb);
+        scene.addSystem<cro::CameraSystem>(mb);
+
+        constexpr std::size_t Count = EntityCount / 4;
+        std::vector<cro::Entity> entities;
+        for (auto i = 0u; i < Count; ++i)
+        {
+            auto entity = scene.createEntity();
+            entity.addComponent<cro::Transform>();
+            entities.push_back(entity);
+        }
+        scene.simulate(0.f);
+
+        cro::HiResTimer timer;
+        for (auto i = 0u; i < Iterations; ++i)
+        {
+            for (auto e : entities)
+            {
+                e.addComponent<Highlight>();
+            }
+            scene.simulate(0.f);
+
+            for (auto e : entities)
+            {
+                e.removeComponent<Highlight>();
+            }
+            scene.simulate(0.f);
+        }
+        const auto removeTime = timer.restart();
+
+        for (auto i = 0u; i < Iterations; ++i)
+        {
+            for (auto& e : entities)
+            {
+                scene.destroyEntity(e);
+                e = scene.createEntity();
+                e.addComponent<cro::Transform>();
+                e.addComponent<Highlight>();
+            }
+            scene.simulate(0.f);
+
+            for (auto& e : entities)
+            {
+                scene.destroyEntity(e);
+                e = scene.createEntity();
+                e.addComponent<cro::Transform>();
+            }
+            scene.simulate(0.f);
+        }
+        const auto recreateTime = timer.restart();
+
+        const auto count = Count * Iterations;
+        return "Add/Remove Component: " + nsPer(removeTime, count)
+            + "\nRecreate Entity: " + nsPer(recreateTime, count);
+    }
+
+    template <std::size_t N>
+    struct Workload final
+    {
+        glm::vec3 value = glm::vec3(1.f);
+    };
+
+    //simulates a gameplay system which does a moderate
+    //amount of work on its own component type
+    template <std::size_t N, bool Concurrent>
+    class WorkloadSystem final : public cro::System
+    {
+    public:
+        explicit WorkloadSystem(cro::MessageBus& mb)
+            : cro::System(mb, typeid(WorkloadSystem<N, Concurrent>))
+        {
+            requireComponent<Workload<N>>();
+            if constexpr (Concurrent)
+            {
+                writeComponent<Workload<N>>();
+            }
+        }
+
+        void process(float dt) override
+        {
+            for (auto entity : getEntities())
+            {
+                auto& v = entity.getComponent<Workload<N>>().value;
+                for (auto i = 0; i < 16; ++i)
+                {
+                    v = glm::normalize(glm::cross(v, glm::vec3(0.1f, 1.f, dt)) + v);
+                }
+            }
+        }
+    };
+
+    template <bool Concurrent>
+    float processWorkloads(cro::MessageBus& mb)
+    {
+        cro::Scene scene(mb);
+        scene.addSystem<WorkloadSystem<0, Concurrent>>(mb);
+        scene.addSystem<WorkloadSystem<1, Concurrent>>(mb);
+        scene.addSystem<WorkloadSystem<2, Concurrent>>(mb);
+        scene.addSystem<WorkloadSystem<3, Concurrent>>(mb);
+
+        for (auto i = 0u; i < EntityCount; ++i)
+        {
+            auto entity = scene.createEntity();
+            switch (i % 4)
+            {
+            default:
+            case 0: entity.addComponent<Workload<0>>(); break;
+            case 1: entity.addComponent<Workload<1>>(); break;
+            case 2: entity.addComponent<Workload<2>>(); break;
+            case 3: entity.addComponent<Workload<3>>(); break;
+            }
+        }
+        scene.simulate(0.f);
+
+        cro::HiResTimer timer;
+        for (auto i = 0u; i < Iterations; ++i)
+        {
+            scene.simulate(0.016f);
+        }
+        return timer.restart();
+    }
+
+    //compares processing independent systems one after
+    //another with processing them concurrently
+    std::string systemScheduling(cro::MessageBus& mb)
+    {
+        const auto serialTime = processWorkloads<false>(mb);
+        const auto concurrentTime = processWorkloads<true>(mb);
+
+        return "Serial: " + nsPer(serialTime, EntityCount * Iterations)
+            + "\nConcurrent: " + nsPer(concurrentTime, EntityCount * Iterations)
+            + "\nHardware Threads: " + std::to_string(std::thread::hardware_concurrency());
+    }
+
+    constexpr cro::Message::ID OrderMessage = cro::Message::Count;
+    constexpr std::uint32_t OrderMessageFrequency = 1000;
+
+    //does the same work as WorkloadSystem, either in a single
+    //loop or split into batches with parallelForEach()
+    template <bool Parallel>
+    class ParallelWorkloadSystem final : public cro::System
+    {
+    public:
+        explicit ParallelWorkloadSystem(cro::MessageBus& mb)
+            : cro::System(mb, typeid(ParallelWorkloadSystem<Parallel>))
+        {
+            requireComponent<Workload<0>>();
+        }
+
+        void process(float dt) override
+        {
+            const auto update = [&](cro::Entity entity)
+            {
+                auto& v = entity.getComponent<Workload<0>>().value;
+                for (auto i = 0; i < 16; ++i)
+                {
+                    v = glm::normalize(glm::cross(v, glm::vec3(0.1f, 1.f, dt)) + v);
+                }
+
+                //used to check messages arrive in the same order
+                if (entity.getIndex() % OrderMessageFrequency == 0)
+                {
+                    *postMessage<std::uint32_t>(OrderMessage) = entity.getIndex();
+                }
+            };
+
+            if constexpr (Parallel)
+            {
+                parallelForEach(update);
+            }
+            else
+            {
+                for (auto entity : getEntities())
+                {
+                    update(entity);
+                }
+            }
+        }
+    };
+
+    template <bool Parallel>
+    float processParallelWorkload(std::vector<std::uint32_t>& messageOrder)
+    {
+        //uses its own message bus so the messages can be read back
+        cro::MessageBus mb;
+        const auto readMessages = [&]()
+        {
+            mb.empty(); //swaps the pending messages in
+            while (!mb.empty())
+            {
+                const auto& msg = mb.poll();
+                if (msg.id == OrderMessage)
+                {
+                    messageOrder.push_back(msg.getData<std::uint32_t>());
+                }
+            }
+        };
+
+        cro::Scene scene(mb);
+        scene.addSystem<ParallelWorkloadSystem<Parallel>>(mb);
+
+        for (auto i = 0u; i < EntityCount; ++i)
+        {
+            scene.createEntity().addComponent<Workload<0>>();
+        }
+        scene.simulate(0.f);
+        readMessages();
+        messageOrder.clear();
+
+        float elapsed = 0.f;
+        cro::HiResTimer timer;
+        for (auto i = 0u; i < Iterations; ++i)
+        {
+            timer.restart();
+            scene.simulate(0.016f);
+            elapsed += timer.restart();
+
+            readMessages();
+        }
+        return elapsed;
+    }
+
+    //compares processing a system's entities in a single
+    //loop with processing them in parallel batches
+    std::string parallelEntities(cro::MessageBus&)
+    {
+        std::vector<std::uint32_t> serialOrder;
+        std::vector<std::uint32_t> parallelOrder;
+        const auto serialTime = processParallelWorkload<false>(serialOrder);
+        const auto parallelTime = processParallelWorkload<true>(parallelOrder);
+
+        return "Serial: " + nsPer(serialTime, EntityCount * Iterations)
+            + "\nParallel: " + nsPer(parallelTime, EntityCount * Iterations)
+            + "\nMessage Order: " + (serialOrder == parallelOrder ? "Match" : "MISMATCH")
+            + "\nWorker Threads: " + std::to_string(cro::App::getJobSystem().getWorkerCount());
+    }
+
+    //compares testing every model against the camera frustum
+    //with querying the ModelRenderer's AABB tree
+    std::string modelCulling(cro::MessageBus& mb)
+    {
+        constexpr std::size_t ModelCount = 30000;
+        constexpr std::size_t GridSize = 174; //~sqrt(ModelCount)
+        constexpr float Spacing = 4.f;
+
+        //declared before the scene so they outlive the models
+        cro::MeshResource meshes;
+        cro::ShaderResource shaders;
+        cro::MaterialResource materials;
+
+        const auto meshID = meshes.loadMesh(cro::CubeBuilder());
+        const auto shaderID = shaders.loadBuiltIn(cro::ShaderResource::Unlit, 0);
+        const auto materialID = materials.add(shaders.get(shaderID));
+
+        cro::Scene scene(mb);
+        scene.addSystem<cro::CameraSystem>(mb);
+        auto* renderer = scene.addSystem<cro::ModelRenderer>(mb);
+
+        for (auto i = 0u; i < ModelCount; ++i)
+        {
+            const auto x = static_cast<float>(i % GridSize) - (GridSize / 2.f);
+            const auto z = static_cast<float>(i / GridSize) - (GridSize / 2.f);
+
+            auto entity = scene.createEntity();
+            entity.addComponent<cro::Transform>().setPosition(glm::vec3(x, 0.f, z) * Spacing);
+            entity.addComponent<cro::Model>(meshes.getMesh(meshID), materials.get(materialID));
+        }
+
+        auto camera = scene.createEntity();
+        camera.addComponent<cro::Transform>().setPosition({ 0.f, 2.f, 0.f });
+        camera.addComponent<cro::Camera>().setPerspective(60.f * cro::Util::Const::degToRad, 16.f / 9.f, 0.1f, 200.f);
+
+        const auto cull = [&](cro::ModelRenderer::CullingMode mode, std::size_t& visible)
+        {
+            renderer->setCullingMode(mode);
+            scene.simulate(0.f);
+
+            //culling results are cached for the rest of the frame, so each
+            //iteration simulates the scene, which updates the draw lists of
+            //every active camera
+            float elapsed = 0.f;
+            cro::HiResTimer timer;
+            for (auto i = 0u; i < Iterations; ++i)
+            {
+                timer.restart();
+                scene.simulate(0.f);
+                elapsed += timer.restart();
+            }
+            visible = renderer->getVisibleCount(camera.getComponent<cro::Camera>().getDrawListIndex(), cro::Camera::Pass::Final);
+            return elapsed;
+        };
+
+        std::size_t linearVisible = 0;
+        std::size_t treeVisible = 0;
+        const auto linearTime = cull(cro::ModelRenderer::CullingMode::Linear, linearVisible);
+        const auto treeTime = cull(cro::ModelRenderer::CullingMode::Tree, treeVisible);
+
+        return "Linear: " + nsPer(linearTime, ModelCount * Iterations) + " (" + std::to_string(linearVisible) + " visible)"
+            + "\nTree: " + nsPer(treeTime, ModelCount * Iterations) + " (" + std::to_string(treeVisible) + " visible)";
+    }
+
+    //compares updating the draw lists of several cameras one
+    //after the other with updating them in parallel
+    std::string multiCameraDrawLists(cro::MessageBus& mb)
+    {
+        constexpr std::size_t GridSize = 140;
+        constexpr std::size_t CameraCount = 6;
+        constexpr float Spacing = 4.f;
+
+        //declared before the scene so they outlive the models
+        cro::MeshResource meshes;
+        cro::ShaderResource shaders;
+        cro::MaterialResource materials;
+
+        const auto meshID = meshes.loadMesh(cro::CubeBuilder());
+        const auto shaderID = shaders.loadBuiltIn(cro::ShaderResource::Unlit, 0);
+        const auto materialID = materials.add(shaders.get(shaderID));
+
+        cro::Scene scene(mb);
+        scene.addSystem<cro::CameraSystem>(mb);
+        auto* renderer = scene.addSystem<cro::ModelRenderer>(mb);
+        renderer->setCullingMode(cro::ModelRenderer::CullingMode::Linear);
+
+        for (auto i = 0u; i < GridSize * GridSize; ++i)
+        {
+            const auto x = static_cast<float>(i % GridSize) - (GridSize / 2.f);
+            const auto z = static_cast<float>(i / GridSize) - (GridSize / 2.f);
+
+            auto entity = scene.createEntity();
+            entity.addComponent<cro::Transform>().setPosition(glm::vec3(x, 0.f, z) * Spacing);
+            entity.addComponent<cro::Model>(meshes.getMesh(meshID), materials.get(materialID));
+        }
+
+        //cameras face outwards from the centre of the grid
+        std::vector<cro::Entity> cameras;
+        for (auto i = 0u; i < CameraCount; ++i)
+        {
+            auto camera = scene.createEntity();
+            camera.addComponent<cro::Transform>().setPosition({ 0.f, 2.f, 0.f });
+            camera.getComponent<cro::Transform>().setRotation(cro::Transform::Y_AXIS, (cro::Util::Const::TAU / CameraCount) * i);
+            camera.addComponent<cro::Camera>().setPerspective(60.f * cro::Util::Const::degToRad, 16.f / 9.f, 0.1f, 200.f);
+            cameras.push_back(camera);
+        }
+
+        //culling is shared with the other renderers and done once per
+        //frame, so this compares the cost of building and sorting the lists
+        scene.simulate(0.f);
+
+        float serialTime = 0.f;
+        float parallelTime = 0.f;
+        cro::HiResTimer timer;
+        for (auto i = 0u; i < Iterations; ++i)
+        {
+            timer.restart();
+            renderer->cro::Renderable::updateDrawLists(cameras);
+            serialTime += timer.restart();
+
+            timer.restart();
+            renderer->updateDrawLists(cameras);
+            parallelTime += timer.restart();
+        }
+
+        std::size_t visible = 0;
+        for (auto camera : cameras)
+        {
+            visible += renderer->getVisibleCount(camera.getComponent<cro::Camera>().getDrawListIndex(), cro::Camera::Pass::Final);
+        }
+
+        const auto count = CameraCount * Iterations;
+        return "Serial: " + nsPer(serialTime, count) + " per camera"
+            + "\nParallel: " + nsPer(parallelTime, count) + " per camera"
+            + "\nVisible: " + std::to_string(visible) + " over " + std::to_string(CameraCount) + " cameras"
+            + "\nWorker Threads: " + std::to_string(cro::App::getJobSystem().getWorkerCount());
+    }
+
+    //compares drawing each Drawable2D with its own draw call with
+    //drawing them in batches. This is the CPU time taken to submit them
+    std::string spriteBatching(cro::MessageBus& mb)
+    {
+        constexpr std::size_t SpriteCount = 3000;
+        constexpr std::uint32_t TargetSize = 1024;
+        constexpr float SpriteSize = 16.f;
+
+        cro::Image image;
+        image.create(2, 2, cro::Colour::White);
+        cro::Texture texture;
+        texture.loadFromImage(image);
+
+        cro::RenderTexture target;
+        target.create(TargetSize, TargetSize, false);
+
+        cro::Scene scene(mb);
+        scene.addSystem<cro::CameraSystem>(mb);
+        auto* renderer = scene.addSystem<cro::RenderSystem2D>(mb);
+
+        const std::vector<cro::Vertex2D> quad =
+        {
+            cro::Vertex2D(glm::vec2(0.f, SpriteSize), glm::vec2(0.f, 1.f)),
+            cro::Vertex2D(glm::vec2(0.f), glm::vec2(0.f)),
+            cro::Vertex2D(glm::vec2(SpriteSize), glm::vec2(1.f)),
+            cro::Vertex2D(glm::vec2(SpriteSize, 0.f), glm::vec2(1.f, 0.f))
+        };
+
+        for (auto i = 0u; i < SpriteCount; ++i)
+        {
+            const auto limit = static_cast<float>(TargetSize) - SpriteSize;
+            auto entity = scene.createEntity();
+            entity.addComponent<cro::Transform>().setPosition(glm::vec3(cro::Util::Random::value(0.f, limit), cro::Util::Random::value(0.f, limit), static_cast<float>(i % 10)));
+            entity.addComponent<cro::Drawable2D>().setVertexData(quad);
+            entity.getComponent<cro::Drawable2D>().setTexture(&texture);
+        }
+
+        auto camera = scene.getActiveCamera();
+        camera.getComponent<cro::Camera>().setOrthographic(0.f, static_cast<float>(TargetSize), 0.f, static_cast<float>(TargetSize), -0.1f, 20.f);
+
+        const auto measure = [&]()
+        {
+            float elapsed = 0.f;
+            cro::HiResTimer timer;
+            for (auto i = 0u; i < Iterations; ++i)
+            {
+                scene.simulate(0.f);
+
+                target.clear();
+                timer.restart();
+                scene.render();
+                elapsed += timer.restart();
+                target.display();
+            }
+            return elapsed;
+        };
+
+        renderer->setBatchingEnabled(false);
+        const auto singleTime = measure();
+
+        renderer->setBatchingEnabled(true);
+        const auto batchedTime = measure();
+
+        return "Single: " + nsPer(singleTime, SpriteCount * Iterations) + " per sprite"
+            + "\nBatched: " + nsPer(batchedTime, SpriteCount * Iterations) + " per sprite";
+    }
+
+    //updates a screen full of counters every frame. When only the end of
+    //the string changes the Text layout is updated from the first changed
+    //character, where changing the start of the string rebuilds it entirely
+    std::string textCounters(cro::MessageBus& mb)
+    {
+        constexpr std::size_t CounterCount = 500;
+        constexpr std::uint32_t TargetSize = 1024;
+
+        cro::Font font;
+        if (!font.loadFromFile("assets/fonts/VeraMono.ttf"))
+        {
+            return "Failed to load font";
+        }
+
+        cro::RenderTexture target;
+        target.create(TargetSize, TargetSize, false);
+
+        cro::Scene scene(mb);
+        scene.addSystem<cro::TextSystem>(mb);
+        scene.addSystem<cro::CameraSystem>(mb);
+        auto* renderer = scene.addSystem<cro::RenderSystem2D>(mb);
+
+        std::vector<cro::Entity> counters;
+        for (auto i = 0u; i < CounterCount; ++i)
+        {
+            auto entity = scene.createEntity();
+            entity.addComponent<cro::Transform>().setPosition(glm::vec2(static_cast<float>((i % 10) * 100), static_cast<float>((i / 10) * 20)));
+            entity.addComponent<cro::Drawable2D>();
+            entity.addComponent<cro::Text>(font).setCharacterSize(16);
+            counters.push_back(entity);
+        }
+
+        auto camera = scene.getActiveCamera();
+        camera.getComponent<cro::Camera>().setOrthographic(0.f, static_cast<float>(TargetSize), 0.f, static_cast<float>(TargetSize), -0.1f, 10.f);
+
+        std::size_t frame = 0;
+        const auto measure = [&](const std::function<std::string(std::size_t)>& getString)
+        {
+            //warm up so glyphs are already loaded
+            for (auto i = 0u; i < 10; ++i)
+            {
+                for (auto j = 0u; j < counters.size(); ++j)
+                {
+                    counters[j].getComponent<cro::Text>().setString(getString(frame++ + j));
+                }
+                scene.simulate(0.f);
+            }
+
+            cro::HiResTimer timer;
+            for (auto i = 0u; i < Iterations; ++i)
+            {
+                for (auto j = 0u; j < counters.size(); ++j)
+                {
+                    counters[j].getComponent<cro::Text>().setString(getString(frame++ + j));
+                }
+                scene.simulate(0.f);
+
+                target.clear();
+                scene.render();
+                target.display();
+            }
+            return timer.restart();
+        };
+
+        const auto suffix = [](std::size_t value)
+        {
+            return "Score: " + std::to_string(100000 + (value % 100000));
+        };
+
+        const auto prefix = [](std::size_t value)
+        {
+            //reversed so the first character changes every time
+            auto str = std::to_string(100000 + (value % 100000));
+            std::reverse(str.begin(), str.end());
+            return str + " :Score";
+        };
+
+        renderer->setBatchingEnabled(false);
+        const auto prefixTime = measure(prefix);
+        const auto suffixTime = measure(suffix);
+
+        renderer->setBatchingEnabled(true);
+        const auto batchedTime = measure(suffix);
+
+        return "Full rebuild: " + nsPer(prefixTime, CounterCount * Iterations) + " per counter"
+            + "\nSuffix update: " + nsPer(suffixTime, CounterCount * Iterations) + " per counter"
+            + "\nSuffix update, batched: " + nsPer(batchedTime, CounterCount * Iterations) + " per counter";
+    }
+
+    //compares testing one sphere/box at a time against each frustum
+    //plane with the batched tests in Util::Frustum
+    std::string frustumCulling(cro::MessageBus&)
+    {
+        constexpr std::size_t ObjectCount = 100000;
+        constexpr float WorldSize = 500.f;
+
+        std::vector<cro::Sphere> spheres(ObjectCount);
+        std::vector<cro::Box> boxes(ObjectCount);
+        for (auto i = 0u; i < ObjectCount; ++i)
+        {
+            const glm::vec3 position(cro::Util::Random::value(-WorldSize, WorldSize),
+                cro::Util::Random::value(-WorldSize / 10.f, WorldSize / 10.f),
+                cro::Util::Random::value(-WorldSize, WorldSize));
+            const auto size = cro::Util::Random::value(0.5f, 5.f);
+
+            spheres[i] = cro::Sphere(size, position);
+            boxes[i] = cro::Box(position - size, position + size);
+        }
+
+        const auto projection = glm::perspective(60.f * cro::Util::Const::degToRad, 16.f / 9.f, 0.1f, WorldSize);
+        const auto view = glm::lookAt(glm::vec3(0.f, 10.f, 0.f), glm::vec3(1.f, 0.f, -1.f), glm::vec3(0.f, 1.f, 0.f));
+        cro::Frustum frustum;
+        cro::Spatial::updateFrustum(frustum, projection * view);
+
+        const auto testPlanes = [&frustum](const auto& shape)
+        {
+            for (const auto& plane : frustum)
+            {
+                if (cro::Spatial::intersects(plane, shape) == cro::Planar::Back)
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        const auto countBits = [](const std::vector<std::uint32_t>& bits)
+        {
+            std::size_t count = 0;
+            for (auto b : bits)
+            {
+                for (; b != 0; b &= (b - 1))
+                {
+                    count++;
+                }
+            }
+            return count;
+        };
+
+        std::vector<std::uint32_t> output((ObjectCount + 31) / 32);
+        std::size_t scalarSpheres = 0;
+        std::size_t scalarBoxes = 0;
+        std::size_t batchSpheres = 0;
+        std::size_t batchBoxes = 0;
+
+        float scalarSphereTime = 0.f;
+        float scalarBoxTime = 0.f;
+        float batchSphereTime = 0.f;
+        float batchBoxTime = 0.f;
+
+        cro::HiResTimer timer;
+        for (auto i = 0u; i < Iterations; ++i)
+        {
+            scalarSpheres = 0;
+            timer.restart();
+            for (const auto& sphere : spheres)
+            {
+                scalarSpheres += testPlanes(sphere) ? 1 : 0;
+            }
+            scalarSphereTime += timer.restart();
+
+            scalarBoxes = 0;
+            timer.restart();
+            for (const auto& box : boxes)
+            {
+                scalarBoxes += testPlanes(box) ? 1 : 0;
+            }
+            scalarBoxTime += timer.restart();
+
+            timer.restart();
+            cro::Util::Frustum::visible(frustum, spheres.data(), spheres.size(), output.data());
+            batchSphereTime += timer.restart();
+            batchSpheres = countBits(output);
+
+            timer.restart();
+            cro::Util::Frustum::visible(frustum, boxes.data(), boxes.size(), output.data());
+            batchBoxTime += timer.restart();
+            batchBoxes = countBits(output);
+        }
+
+        const auto count = ObjectCount * Iterations;
+        return "Spheres: " + nsPer(scalarSphereTime, count) + " scalar, " + nsPer(batchSphereTime, count) + " batched"
+            + (scalarSpheres == batchSpheres ? " (Match)" : " (MISMATCH)")
+            + "\nBoxes: " + nsPer(scalarBoxTime, count) + " scalar, " + nsPer(batchBoxTime, count) + " batched"
+            + (scalarBoxes == batchBoxes ? " (Match)" : " (MISMATCH)")
+            + "\nVisible: " + std::to_string(batchSpheres) + " spheres, " + std::to_string(batchBoxes) + " boxes";
+    }
+
+    //packs a fixed set of image sizes into a TextureAtlas several times,
+    //checking that no images overlap or leave the atlas, and that
+    //every run produces the same layout. This is a manual check - it
+    //only runs from the bench window, so a MISMATCH here is the only
+    //sign that a change to the packer altered its output.
+    std::string textureAtlasPacking(cro::MessageBus&)
+    {
+        constexpr std::uint32_t AtlasSize = 512;
+        constexpr std::uint32_t Padding = 2;
+        constexpr std::size_t ImageCount = 200;
+        constexpr std::size_t RunCount = 3;
+
+        std::vector<glm::uvec2> sizes;
+        for (auto i = 0u; i < ImageCount; ++i)
+        {
+            sizes.emplace_back(8 + ((i * 37) % 56), 8 + ((i * 53) % 40));
+        }
+
+        //stored as left, bottom, width, height. A null entry means the image didn't fit
+        using Layout = std::vector<std::optional<glm::vec4>>;
+        const auto pack = [&]()
+        {
+            cro::TextureAtlas atlas;
+            atlas.create(AtlasSize, AtlasSize, Padding);
+
+            Layout layout;
+            cro::Image image;
+            for (auto i = 0u; i < sizes.size(); ++i)
+            {
+                image.create(sizes[i].x, sizes[i].y, cro::Colour::White);
+
+                const auto name = std::to_string(i);
+                if (atlas.addImage(name, image))
+                {
+                    const auto rect = atlas.getRect(name);
+                    layout.emplace_back(glm::vec4(rect.left, rect.bottom, rect.width, rect.height));
+                }
+                else
+                {
+                    layout.emplace_back();
+                }
+            }
+            return layout;
+        };
+
+        //images must be at least the padding apart
+        const auto overlaps = [](glm::vec4 a, glm::vec4 b)
+        {
+            return a.x < b.x + b.z + Padding && b.x < a.x + a.z + Padding
+                && a.y < b.y + b.w + Padding && b.y < a.y + a.w + Padding;
+        };
+
+        cro::HiResTimer timer;
+        const auto layout = pack();
+        const auto packTime = timer.restart();
+
+        std::size_t packed = 0;
+        std::size_t usedArea = 0;
+        bool inBounds = true;
+        bool overlapFree = true;
+        for (auto i = 0u; i < layout.size(); ++i)
+        {
+            if (!layout[i])
+            {
+                continue;
+            }
+
+            const auto& rect = *layout[i];
+            packed++;
+            usedArea += sizes[i].x * sizes[i].y;
+
+            inBounds = inBounds
+                && rect.x >= 0.f && rect.y >= 0.f
+                && rect.x + rect.z <= AtlasSize && rect.y + rect.w <= AtlasSize
+                && rect.z == sizes[i].x && rect.w == sizes[i].y;
+
+            for (auto j = i + 1; j < layout.size() && overlapFree; ++j)
+            {
+                overlapFree = !layout[j] || !overlaps(rect, *layout[j]);
+            }
+        }
+
+        bool deterministic = true;
+        for (auto i = 1u; i < RunCount; ++i)
+        {
+            deterministic = deterministic && (pack() == layout);
+        }
+
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1) << (static_cast<float>(usedArea) / (AtlasSize * AtlasSize)) * 100.f << "%";
+
+        return "Packed " + std::to_string(packed) + "/" + std::to_string(ImageCount) + " images in " + nsPer(packTime, ImageCount) + " per image, " + ss.str() + " coverage"
+            + "\nBounds: " + (inBounds ? "(Match)" : "(MISMATCH)")
+            + "\nOverlap: " + (overlapFree ? "(Match)" : "(MISMATCH)")
+            + "\nRepeated runs: " + (deterministic ? "(Match)" : "(MISMATCH)");
+    }
+
+    //compares the shared Util::Random generator with the counter based
+    //generator used when spawning particles, and the old array-of-structs
+    //particle update with a full ParticleSystem update of the same number
+    //of particles, spread over several emitters
+    std::string particleUpdate(cro::MessageBus& mb)
+    {
+        constexpr std::size_t EmitterCount = 6;
+        constexpr float EmitRate = 600.f;
+        constexpr std::uint32_t EmitCount = 10;
+        constexpr float Lifetime = 1.5f; //~9000 particles per emitter
+        constexpr float dt = 1.f / 60.f;
+        constexpr std::size_t RandomCount = 1000000;
+
+        float sum = 0.f;
+        cro::HiResTimer timer;
+        for (auto i = 0u; i < RandomCount; ++i)
+        {
+            sum += cro::Util::Random::value(-1.f, 1.f);
+        }
+        const auto sharedTime = timer.restart();
+
+        cro::Util::Random::CounterGenerator rng(1234);
+        for (auto i = 0u; i < RandomCount; ++i)
+        {
+            sum += rng.value(-1.f, 1.f);
+        }
+        const auto counterTime = timer.restart();
+
+
+        cro::Scene scene(mb);
+        scene.addSystem<cro::ParticleSystem>(mb);
+
+        std::vector<cro::Entity> emitters;
+        for (auto i = 0u; i < EmitterCount; ++i)
+        {
+            auto entity = scene.createEntity();
+            entity.addComponent<cro::Transform>().setPosition(glm::vec3(static_cast<float>(i) * 10.f, 0.f, 0.f));
+
+            auto& emitter = entity.addComponent<cro::ParticleEmitter>();
+            emitter.settings.emitRate = EmitRate;
+            emitter.settings.emitCount = EmitCount;
+            emitter.settings.lifetime = Lifetime;
+            emitter.settings.lifetimeVariance = 0.2f;
+            emitter.settings.spread = 30.f;
+            emitter.settings.spawnRadius = 2.f;
+            emitter.settings.gravity = glm::vec3(0.f, -9.f, 0.f);
+            emitter.settings.initialVelocity = glm::vec3(0.f, 5.f, 0.f);
+            emitter.settings.rotationSpeed = 45.f;
+            emitter.settings.scaleModifier = 0.5f;
+            emitter.start();
+            emitters.push_back(entity);
+        }
+
+        //let the emitters reach a steady state where particles
+        //are spawned and removed each frame
+        for (auto i = 0u; i < 120u; ++i)
+        {
+            scene.simulate(dt);
+        }
+
+        timer.restart();
+        for (auto i = 0u; i < Iterations; ++i)
+        {
+            scene.simulate(dt);
+        }
+        const auto systemTime = timer.restart();
+
+        std::size_t particleCount = 0;
+        for (auto e : emitters)
+        {
+            particleCount += e.getComponent<cro::ParticleEmitter>().getParticleCount();
+        }
+
+        //the same number of particles updated the way the system used to,
+        //without spawning, one emitter at a time on this thread
+        const auto& settings = emitters[0].getComponent<cro::ParticleEmitter>().settings;
+        std::vector<cro::Particle> particles(particleCount);
+        for (auto& p : particles)
+        {
+            p.lifetime = p.maxLifeTime = 1000.f;
+            p.gravity = settings.gravity;
+            p.velocity = settings.initialVelocity;
+        }
+
+        timer.restart();
+        for (auto i = 0u; i < Iterations; ++i)
+        {
+            glm::vec3 minBounds(std::numeric_limits<float>::max());
+            glm::vec3 maxBounds(0.f);
+            for (auto& p : particles)
+            {
+                p.velocity *= p.acceleration;
+                p.velocity += p.gravity * dt;
+                for (auto f : settings.forces)
+                {
+                    p.velocity += f * dt;
+                }
+                p.position += p.velocity * dt;
+
+                p.lifetime -= dt;
+                p.colour.setAlpha(std::min(1.f, std::max(p.lifetime / p.maxLifeTime, 0.f)));
+
+                p.rotation += settings.rotationSpeed * dt;
+                p.scale += ((p.scale * settings.scaleModifier) * dt);
+
+                minBounds = glm::min(minBounds, p.position);
+                maxBounds = glm::max(maxBounds, p.position);
+            }
+            sum += minBounds.x + maxBounds.x;
+        }
+        const auto structTime = timer.restart();
+        sink = sum;
+
+        return "Util::Random::value(): " + nsPer(sharedTime, RandomCount)
+            + "\nCounterGenerator::value(): " + nsPer(counterTime, RandomCount)
+            + "\nArray of structs update: " + nsPer(structTime, particleCount * Iterations) + " per particle"
+            + "\nParticleSystem (spawn, update, upload): " + nsPer(systemTime, particleCount * Iterations) + " per particle"
+            + "\nParticles: " + std::to_string(particleCount);
+    }
+}
+
+BenchState::BenchState(cro::StateStack& stack, cro::State::Context context)
+    : cro::State    (stack, context),
+    m_uiScene       (context.appInstance.getMessageBus())
+{
+    context.mainWindow.loadResources([this]() {
+        addSystems();
+        addBenchmarks();
+    });
+
+    registerWindow([&]()
+        {
+            ImGui::SetNextWindowSize({ 400.f, 300.f }, ImGuiCond_FirstUseEver);
+            if (ImGui::Begin("Benchmarks"))
+            {
+                for (auto& bench : m_benchmarks)
+                {
+                    if (ImGui::Button(bench.name.c_str()))
+                    {
+                        bench.result = bench.run();
+                    }
+                    if (!bench.result.empty())
+                    {
+                        ImGui::Text("%s", bench.result.c_str());
+                    }
+                    ImGui::Separator();
+                }
+            }
+            ImGui::End();
+        });
+}
+
+//public
+bool BenchState::handleEvent(const cro::Event& evt)
+{
+    if (cro::ui::wantsMouse() || cro::ui::wantsKeyboard())
+    {
+        return true;
+    }
+
+    if (evt.type == SDL_KEYDOWN)
+    {
+        switch (evt.key.keysym.sym)
+        {
+        default: break;
+        case SDLK_BACKSPACE:
+        case SDLK_ESCAPE:
+            quitState();
+            break;
+        }
+    }
+
+    m_uiScene.forwardEvent(evt);
+    return false;
+}
+
+void BenchState::handleMessage(const cro::Message& msg)
+{
+    m_uiScene.forwardMessage(msg);
+}
+
+bool BenchState::simulate(float dt)
+{
+    m_uiScene.simulate(dt);
+    return false;
+}
+
+void BenchState::render()
+{
+    m_uiScene.render();
+}
+
+//private
+void BenchState::addSystems()
+{
+    auto& mb = getContext().appInstance.getMessageBus();
+    m_uiScene.addSystem<cro::CameraSystem>(mb);
+    m_uiScene.addSystem<cro::RenderSystem2D>(mb);
+}
+
+void BenchState::addBenchmarks()
+{
+    auto& mb = getContext().appInstance.getMessageBus();
+    m_benchmarks.push_back({ "Component Lookup", [&mb]() { return componentLookup(mb); } });
+    m_benchmarks.push_back({ "Component Iteration", [&mb]() { return componentIteration(mb); } });
+    m_benchmarks.push_back({ "Transform Update", [&mb]() { return transformUpdate(mb); } });
+    m_benchmarks.push_back({ "System Membership", [&mb]() { return systemMembership(mb); } });
+    m_benchmarks.push_back({ "Component Removal", [&mb]() { return componentRemoval(mb); } });
+    m_benchmarks.push_back({ "System Scheduling", [&mb]() { return systemScheduling(mb); } });
+    m_benchmarks.push_back({ "Parallel Entities", [&mb]() { return parallelEntities(mb); } });
+    m_benchmarks.push_back({ "Model Culling", [&mb]() { return modelCulling(mb); } });
+    m_benchmarks.push_back({ "Frustum Culling", [&mb]() { return frustumCulling(mb); } });
+    m_benchmarks.push_back({ "Multi Camera Draw Lists", [&mb]() { return multiCameraDrawLists(mb); } });
+    m_benchmarks.push_back({ "Sprite Batching", [&mb]() { return spriteBatching(mb); } });
+    m_benchmarks.push_back({ "Text Counters", [&mb]() { return textCounters(mb); } });
+    m_benchmarks.push_back({ "Texture Atlas Packing", [&mb]() { return textureAtlasPacking(mb); } });
+    m_benchmarks.push_back({ "Particle Update", [&mb]() { return particleUpdate(mb); } });
+}
+
+void BenchState::quitState()
+{
+    requestStackClear();
+    requestStackPush(States::ScratchPad::MainMenu);
+}
@@ -0,0 +1,46 @@
+//Auto-generated header file for Scratchpad Stub 17/10/2026, 09:12:40
+
+#pragma once
+
+#include "../StateIDs.hpp"
+
+#include <crogine/core/State.hpp>
+#include <crogine/ecs/Scene.hpp>
+#include <crogine/gui/GuiClient.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+Runs micro-benchmarks of engine internals on demand
+and displays the results in an ImGui window
+*/
+class BenchState final : public cro::State, public cro::GuiClient
+{
+public:
+    BenchState(cro::StateStack&, cro::State::Context);
+
+    cro::StateID getStateID() const override { return States::ScratchPad::Bench; }
+
+    bool handleEvent(const cro::Event&) override;
+    void handleMessage(const cro::Message&) override;
+    bool simulate(float) override;
+    void render() override;
+
+private:
+
+    cro::Scene m_uiScene;
+
+    struct Benchmark final
+    {
+        std::string name;
+        std::function<std::string()> run;
+        std::string result;
+    };
+    std::vector<Benchmark> m_benchmarks;
+
+    void addSystems();
+    void addBenchmarks();
+    void quitState();
+};